@@ -23,15 +23,26 @@ OF THIRD PARTY RIGHTS.
 #include <dynarithmic/twain/capability_interface/capability_interface.hpp>
 #include <dynarithmic/twain/acquire_characteristics/acquire_characteristics.hpp>
 #include <dynarithmic/twain/source/twain_source.hpp>
+#include <dynarithmic/twain/utilities/memory_tracker.hpp>
 namespace dynarithmic
 {
     namespace twain
     {
         
         buffered_transfer_info::~buffered_transfer_info()
+        {
+            free_strip();
+        }
+
+        void buffered_transfer_info::free_strip()
         {
             if (m_hStrip)
+            {
                 API_INSTANCE DTWAIN_FreeMemory(m_hStrip);
+                memory_tracker::instance().release(memory_tracker::pool::strip_buffer, m_nCurrentStripSize);
+            }
+            m_hStrip = nullptr;
+            m_nCurrentStripSize = 0;
         }
 
         acquired_strip_data& buffered_transfer_info::get_strip_data()
@@ -59,16 +70,17 @@ namespace dynarithmic
             if (m_nStripSize > 0)
             {
                 // Allocate memory for strip here
-                if (m_hStrip)
-                    API_INSTANCE DTWAIN_FreeMemory(m_hStrip);
+                free_strip();
 
                 m_hStrip = API_INSTANCE DTWAIN_AllocateMemory(m_nStripSize);
                 if (!m_hStrip)
                     return false;
+                m_nCurrentStripSize = m_nStripSize;
+                memory_tracker::instance().allocate(memory_tracker::pool::strip_buffer, m_nCurrentStripSize);
 
                 if (!API_INSTANCE DTWAIN_SetAcquireStripBuffer(m_twain_source, m_hStrip))
                 {
-                    API_INSTANCE DTWAIN_FreeMemory(m_hStrip);
+                    free_strip();
                     return false;
                 }
             }
@@ -0,0 +1,131 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <dynarithmic/twain/dtwain_twain.hpp>
+#include <dynarithmic/twain/capability_interface/capability_failure_store.hpp>
+#include <dynarithmic/twain/capability_interface/capability_set_planner.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        // The file has one failure per line:  device <tab> capability <tab> error <tab> value
+        static constexpr const char* failure_store_header = "# TWAIN capability sets rejected by the device";
+
+        bool capability_failure_store::is_learnable_error(int32_t capvalue, int32_t error)
+        {
+            switch (error)
+            {
+                case TWAIN_ERR_BADCAPABILITY:
+                case TWAIN_ERR_CAPNOTSUPPORTED:
+                case TWAIN_ERR_CAPBADOPERATION:
+                    return true;
+
+                // A value of a capability that depends on other capabilities may only be rejected because of the values
+                // those capabilities had at the time (for example, a resolution rejected because ICAP_UNITS was inches)
+                case TWAIN_ERR_BADVALUE:
+                    return !capability_dependency_table::has_prerequisite(capvalue);
+            }
+            return false;
+        }
+
+        bool capability_failure_store::write_file() const
+        {
+            if (m_strFile.empty())
+                return true;
+            const std::string tempName = m_strFile + ".tmp";
+            {
+                std::ofstream ofs(tempName, std::ios::binary | std::ios::trunc);
+                if (!ofs)
+                    return false;
+                ofs << failure_store_header << "\n";
+                for (auto& f : m_failures)
+                {
+                    ofs << make_field(std::get<0>(f.first)) << "\t" << std::get<1>(f.first) << "\t" << f.second << "\t"
+                        << make_field(std::get<2>(f.first)) << "\n";
+                }
+                if (!ofs)
+                    return false;
+            }
+            #ifdef _WIN32
+            return MoveFileExA(tempName.c_str(), m_strFile.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+            #else
+            return std::rename(tempName.c_str(), m_strFile.c_str()) == 0;
+            #endif
+        }
+
+        bool capability_failure_store::load()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_failures.clear();
+            if (m_strFile.empty())
+                return true;
+            std::ifstream ifs(m_strFile, std::ios::binary);
+            if (!ifs)
+                return true;
+            std::string line;
+            while (std::getline(ifs, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (line.empty() || line.front() == '#')
+                    continue;
+                std::istringstream strm(line);
+                std::string device, capText, errorText, value;
+                if (!std::getline(strm, device, '\t') || !std::getline(strm, capText, '\t') || !std::getline(strm, errorText, '\t'))
+                    continue;
+                std::getline(strm, value);
+                try
+                {
+                    m_failures[key_type(device, std::stoi(capText), value)] = std::stoi(errorText);
+                }
+                catch (const std::exception&)
+                {
+                    // skip a damaged line
+                }
+            }
+            return true;
+        }
+
+        bool capability_failure_store::clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_failures.clear();
+            m_skipped = 0;
+            return write_file();
+        }
+
+        void capability_failure_store::add(const std::string& device, int32_t capvalue, const std::string& value, int32_t error)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_failures[key_type(make_field(device), capvalue, make_field(value))] = error;
+
+            // Written now, since a job that ends in a driver hang should not lose what was learned
+            write_file();
+        }
+    }
+}
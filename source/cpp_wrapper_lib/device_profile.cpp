@@ -0,0 +1,126 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <dynarithmic/twain/capability_interface/capability_failure_store.hpp>
+#include <dynarithmic/twain/capability_interface/device_profile.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        // The file has a "device" and an "options" line, followed by the sets in the order they are sent:
+        // set <tab> capability <tab> operation <tab> verified <tab> value <tab> value ...
+        static constexpr const char* device_profile_header = "# TWAIN device profile";
+
+        bool device_profile::load(const std::string& file)
+        {
+            m_device.clear();
+            m_options.clear();
+            m_sets.clear();
+            m_bModified = false;
+            std::ifstream ifs(file, std::ios::binary);
+            if (!ifs)
+                return false;
+            std::string line;
+            while (std::getline(ifs, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (line.empty() || line.front() == '#')
+                    continue;
+                std::istringstream strm(line);
+                std::string name;
+                std::getline(strm, name, '\t');
+                if (name == "device")
+                    std::getline(strm, m_device);
+                else
+                if (name == "options")
+                    std::getline(strm, m_options);
+                else
+                if (name == "set")
+                {
+                    std::string capText, operationText, verifiedText, value;
+                    if (!std::getline(strm, capText, '\t') || !std::getline(strm, operationText, '\t') ||
+                        !std::getline(strm, verifiedText, '\t'))
+                        continue;
+                    set_entry entry;
+                    try
+                    {
+                        entry.cap_value = std::stoi(capText);
+                        entry.operation = std::stol(operationText);
+                    }
+                    catch (const std::exception&)
+                    {
+                        // a damaged set cannot be replayed, so the profile is not used
+                        m_sets.clear();
+                        return false;
+                    }
+                    entry.verified = verifiedText == "1";
+
+                    // A reset has no values.  Otherwise each tab starts a value, which can be an empty string.
+                    const bool bHasValues = !strm.eof();
+                    while (bHasValues && std::getline(strm, value, '\t'))
+                        entry.values.push_back(value);
+                    if (bHasValues && (line.back() == '\t'))
+                        entry.values.push_back({});
+                    m_sets.push_back(std::move(entry));
+                }
+            }
+            return true;
+        }
+
+        bool device_profile::save(const std::string& file)
+        {
+            const std::string tempName = file + ".tmp";
+            {
+                std::ofstream ofs(tempName, std::ios::binary | std::ios::trunc);
+                if (!ofs)
+                    return false;
+                ofs << device_profile_header << "\n";
+                ofs << "device\t" << capability_failure_store::make_field(m_device) << "\n";
+                ofs << "options\t" << capability_failure_store::make_field(m_options) << "\n";
+                for (auto& entry : m_sets)
+                {
+                    ofs << "set\t" << entry.cap_value << "\t" << entry.operation << "\t" << (entry.verified ? 1 : 0);
+                    for (auto& value : entry.values)
+                        ofs << "\t" << capability_failure_store::make_field(value);
+                    ofs << "\n";
+                }
+                if (!ofs)
+                    return false;
+            }
+            #ifdef _WIN32
+            const bool bSaved = MoveFileExA(tempName.c_str(), file.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+            #else
+            const bool bSaved = std::rename(tempName.c_str(), file.c_str()) == 0;
+            #endif
+            if (bSaved)
+                m_bModified = false;
+            return bSaved;
+        }
+    }
+}
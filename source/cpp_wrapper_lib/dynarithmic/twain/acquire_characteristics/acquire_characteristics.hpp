@@ -21,8 +21,12 @@ OF THIRD PARTY RIGHTS.
 #ifndef DTWAIN_ACQUIRE_CHARACTERISTICS_HPP
 #define DTWAIN_ACQUIRE_CHARACTERISTICS_HPP
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <functional>
 
+#include <dynarithmic/twain/types/cow_ptr.hpp>
 #include <dynarithmic/twain/options/pages_options.hpp>
 #include <dynarithmic/twain/options/jobcontrol_options.hpp>
 #include <dynarithmic/twain/options/paperhandling_options.hpp>
@@ -56,38 +60,47 @@ OF THIRD PARTY RIGHTS.
 
 namespace dynarithmic {
 namespace twain {
+     /// The acquire characteristics hold each group of options in a cow_ptr, so copying an acquire_characteristics
+     /// (for example, to keep a profile that is used for several sources or acquisitions) does not copy the options.
+     /// A group is copied the first time it is changed through a non-const get_xxx_options() function, so read the
+     /// options through a const acquire_characteristics where possible.
+     ///
+     /// @note A reference returned by a non-const get_xxx_options() function is only meant for chaining the set_xxx()
+     /// calls, and must not be kept.  If the acquire_characteristics is copied, changes made through the reference would
+     /// be seen by both copies, and if it is compared or hashed, the changes would not be reflected in get_hash().  Call
+     /// get_xxx_options() again for each change instead.
      class acquire_characteristics
      {
          private:
-             audiblealarms_options m_audiblealarms_options;
-             autoadjust_options m_autoadjust_options;
-             autocapture_options m_autocapture_options;
-             autoscanning_options m_autoscanning_options;
-             barcodedetection_options m_barcodedetection_options;
-             blankpage_options m_blankpage_options;
-             buffered_transfer_options m_bufferedtransfer_options;
-             capnegotiation_options m_capnegotiation_options;
-             color_options m_color_options;
-             compression_options m_compression_options;
-             deviceevent_options m_deviceevents_options;
-             deviceparams_options m_deviceparams_options;
-             doublefeed_options m_doublefeed_options;
-             file_transfer_options m_filetransfer_options;
-             general_options m_general_options;
-             imageinformation_options m_imageinformation_options;
-             imageparameter_options m_imageparameter_options;
-             imagetype_options m_imagetype_options;
-             imprinter_options m_imprinter_options;
-             jobcontrol_options m_jobcontrol_options;
-             language_options m_language_options;
-             micr_options m_micr_options;
-             pages_options m_pages_options;
-             paperhandling_options m_paperhandling_options;
-             patchcode_options m_patchcode_options;
-             pdf_options m_pdf_options;
-             powermonitor_options m_powermonitor_options;
-             resolution_options m_resolution_options;
-             userinterface_options m_userinterface_options;
+             cow_ptr<audiblealarms_options> m_audiblealarms_options;
+             cow_ptr<autoadjust_options> m_autoadjust_options;
+             cow_ptr<autocapture_options> m_autocapture_options;
+             cow_ptr<autoscanning_options> m_autoscanning_options;
+             cow_ptr<barcodedetection_options> m_barcodedetection_options;
+             cow_ptr<blankpage_options> m_blankpage_options;
+             cow_ptr<buffered_transfer_options> m_bufferedtransfer_options;
+             cow_ptr<capnegotiation_options> m_capnegotiation_options;
+             cow_ptr<color_options> m_color_options;
+             cow_ptr<compression_options> m_compression_options;
+             cow_ptr<deviceevent_options> m_deviceevents_options;
+             cow_ptr<deviceparams_options> m_deviceparams_options;
+             cow_ptr<doublefeed_options> m_doublefeed_options;
+             cow_ptr<file_transfer_options> m_filetransfer_options;
+             cow_ptr<general_options> m_general_options;
+             cow_ptr<imageinformation_options> m_imageinformation_options;
+             cow_ptr<imageparameter_options> m_imageparameter_options;
+             cow_ptr<imagetype_options> m_imagetype_options;
+             cow_ptr<imprinter_options> m_imprinter_options;
+             cow_ptr<jobcontrol_options> m_jobcontrol_options;
+             cow_ptr<language_options> m_language_options;
+             cow_ptr<micr_options> m_micr_options;
+             cow_ptr<pages_options> m_pages_options;
+             cow_ptr<paperhandling_options> m_paperhandling_options;
+             cow_ptr<patchcode_options> m_patchcode_options;
+             cow_ptr<pdf_options> m_pdf_options;
+             cow_ptr<powermonitor_options> m_powermonitor_options;
+             cow_ptr<resolution_options> m_resolution_options;
+             cow_ptr<userinterface_options> m_userinterface_options;
 
              friend class twain_source;
 
@@ -129,7 +142,82 @@ namespace twain {
         public:
             acquire_characteristics();
 
-            const std::array<bool, num_appliers>& get_appliers() { return m_aAppliers; }
+            const std::array<bool, num_appliers>& get_appliers() const noexcept { return m_aAppliers; }
+
+            /// Returns true if both have the same appliers and the same options in every group.
+            ///
+            /// Groups that are shared are not compared.  Each group keeps a hash of its options, so the options of the
+            /// remaining groups are only compared when the hashes are equal.
+            bool operator==(const acquire_characteristics& rhs) const
+            {
+                if (m_aAppliers != rhs.m_aAppliers)
+                    return false;
+                const auto changed = get_changed_groups(rhs);
+                return std::find(changed.begin(), changed.end(), true) == changed.end();
+            }
+
+            bool operator!=(const acquire_characteristics& rhs) const { return !(*this == rhs); }
+
+            /// Returns, for each applier (apply_audiblealarms, apply_autoadjust, etc.), whether the group of options it
+            /// applies is different in **rhs**.
+            std::array<bool, num_appliers> get_changed_groups(const acquire_characteristics& rhs) const
+            {
+                std::array<bool, num_appliers> changed{};
+                changed[apply_audiblealarms] = m_audiblealarms_options != rhs.m_audiblealarms_options;
+                changed[apply_autoadjust] = m_autoadjust_options != rhs.m_autoadjust_options;
+                changed[apply_autocapture] = m_autocapture_options != rhs.m_autocapture_options;
+                changed[apply_autoscanning] = m_autoscanning_options != rhs.m_autoscanning_options;
+                changed[apply_barcodedetection] = m_barcodedetection_options != rhs.m_barcodedetection_options;
+                changed[apply_capnegotiation] = m_capnegotiation_options != rhs.m_capnegotiation_options;
+                changed[apply_coloroptions] = m_color_options != rhs.m_color_options;
+                changed[apply_compressionoptions] = m_compression_options != rhs.m_compression_options;
+                changed[apply_deviceevents] = m_deviceevents_options != rhs.m_deviceevents_options;
+                changed[apply_deviceparams] = m_deviceparams_options != rhs.m_deviceparams_options;
+                changed[apply_doublefeedoptions] = m_doublefeed_options != rhs.m_doublefeed_options;
+                changed[apply_filetransferoptions] = m_filetransfer_options != rhs.m_filetransfer_options;
+                changed[apply_generaloptions] = m_general_options != rhs.m_general_options;
+                changed[apply_imageinformation] = m_imageinformation_options != rhs.m_imageinformation_options;
+                changed[apply_imageparameter] = m_imageparameter_options != rhs.m_imageparameter_options;
+                changed[apply_imprinter] = m_imprinter_options != rhs.m_imprinter_options;
+                changed[apply_pages] = m_pages_options != rhs.m_pages_options;
+                changed[apply_pdfoptions] = m_pdf_options != rhs.m_pdf_options;
+                changed[apply_jobcontroloptions] = m_jobcontrol_options != rhs.m_jobcontrol_options;
+                changed[apply_microptions] = m_micr_options != rhs.m_micr_options;
+                changed[apply_paperhandlingoptions] = m_paperhandling_options != rhs.m_paperhandling_options;
+                changed[apply_patchcodeoptions] = m_patchcode_options != rhs.m_patchcode_options;
+                changed[apply_imagetypeoptions] = m_imagetype_options != rhs.m_imagetype_options;
+                changed[apply_bufferedtransferoptions] = m_bufferedtransfer_options != rhs.m_bufferedtransfer_options;
+                changed[apply_languageoptions] = m_language_options != rhs.m_language_options;
+                changed[apply_userinterfaceoptions] = m_userinterface_options != rhs.m_userinterface_options;
+                changed[apply_blankpageoptions] = m_blankpage_options != rhs.m_blankpage_options;
+                changed[apply_resolutionoptions] = m_resolution_options != rhs.m_resolution_options;
+                changed[apply_powermonitor] = m_powermonitor_options != rhs.m_powermonitor_options;
+                return changed;
+            }
+
+            /// Returns a hash of the appliers and the options, which is the same for acquire characteristics that
+            /// compare equal
+            std::size_t get_hash() const
+            {
+                const std::size_t hashes[] = {
+                    m_audiblealarms_options.get_hash(), m_autoadjust_options.get_hash(), m_autocapture_options.get_hash(),
+                    m_autoscanning_options.get_hash(), m_barcodedetection_options.get_hash(), m_blankpage_options.get_hash(),
+                    m_bufferedtransfer_options.get_hash(), m_capnegotiation_options.get_hash(), m_color_options.get_hash(),
+                    m_compression_options.get_hash(), m_deviceevents_options.get_hash(), m_deviceparams_options.get_hash(),
+                    m_doublefeed_options.get_hash(), m_filetransfer_options.get_hash(), m_general_options.get_hash(),
+                    m_imageinformation_options.get_hash(), m_imageparameter_options.get_hash(), m_imagetype_options.get_hash(),
+                    m_imprinter_options.get_hash(), m_jobcontrol_options.get_hash(), m_language_options.get_hash(),
+                    m_micr_options.get_hash(), m_pages_options.get_hash(), m_paperhandling_options.get_hash(),
+                    m_patchcode_options.get_hash(), m_pdf_options.get_hash(), m_powermonitor_options.get_hash(),
+                    m_resolution_options.get_hash(), m_userinterface_options.get_hash() };
+                std::size_t appliers = 0;
+                for (auto bApply : m_aAppliers)
+                    appliers = (appliers << 1) | (bApply ? 1 : 0);
+                std::size_t result = std::hash<std::size_t>()(appliers);
+                for (auto h : hashes)
+                    cow_hash_combine(result, h);
+                return result;
+            }
 
             template <typename Container = std::vector<uint8_t>>
             acquire_characteristics& set_appliers(Container& c, bool turnon = true)
@@ -150,7 +238,8 @@ namespace twain {
              /// @returns a reference to the audiblealarms_options instance
              /// @note Refer to the TWAIN Specification 2.4 Chapter 10
              /// @note https://github.com/dynarithmic/twain_library/tree/master/TwainSpecification
-             audiblealarms_options&      get_audiblealarms_options() noexcept { return m_audiblealarms_options; }
+             audiblealarms_options&      get_audiblealarms_options() { return m_audiblealarms_options.get_mutable(); }
+             const audiblealarms_options& get_audiblealarms_options() const noexcept { return m_audiblealarms_options.get(); }
 
              /// The autoadjust_options describes the options used by the TWAIN device that can be used to
              /// automatically adjust the color, skew, rotation, size, etc.
@@ -171,7 +260,8 @@ namespace twain {
              /// @returns a reference to the autoadjust_options instance
              /// @note Refer to the TWAIN Specification 2.4 Chapter 10
              /// @note https://github.com/dynarithmic/twain_library/tree/master/TwainSpecification
-             autoadjust_options&         get_autoadjust_options()  noexcept { return m_autoadjust_options; }
+             autoadjust_options&         get_autoadjust_options() { return m_autoadjust_options.get_mutable(); }
+             const autoadjust_options&   get_autoadjust_options() const noexcept { return m_autoadjust_options.get(); }
 
              /// The autocapture_options specifies time intervals before and after an image is captured.
              /// The autocapture_options are described by the following TWAIN capabilities:\n
@@ -181,7 +271,8 @@ namespace twain {
              /// @returns a reference to the autocapture_options instance
              /// @note Refer to the TWAIN Specification 2.4 Chapter 10
              /// @note https://github.com/dynarithmic/twain_library/tree/master/TwainSpecification
-             autocapture_options&        get_autocapture_options() noexcept { return m_autocapture_options; }
+             autocapture_options&        get_autocapture_options() { return m_autocapture_options.get_mutable(); }
+             const autocapture_options&  get_autocapture_options() const noexcept { return m_autocapture_options.get(); }
 
              /// The autoscanning_options specifies automatic delivery of images, buffering images etc.
              /// The autoscanning_options are described by the following TWAIN capabilities:\n
@@ -197,7 +288,8 @@ namespace twain {
              /// call if capabilities need to be set for the selected camera.  For example, to set capabilities for a 
              /// particular camera, the camera side must be set first before the capability can take affect for that particular camera.
              /// @see dynarithmic::twain::capability_interface::set_cameraside()         
-             autoscanning_options&       get_autoscanning_options() noexcept { return m_autoscanning_options; }
+             autoscanning_options&       get_autoscanning_options() { return m_autoscanning_options.get_mutable(); }
+             const autoscanning_options& get_autoscanning_options() const noexcept { return m_autoscanning_options.get(); }
 
              /// The barcodedetection_options specifies automatic delivery of images, buffering images etc.
              /// The barcodedetection_options are described by the following TWAIN capabilities:\n
@@ -211,33 +303,67 @@ namespace twain {
              /// @returns a reference to the barcodedetection_options instance
              /// @note Refer to the TWAIN Specification 2.4 Chapter 10
              /// @note https://github.com/dynarithmic/twain_library/tree/master/TwainSpecification
-             barcodedetection_options&   get_barcodedetection_options() noexcept { return m_barcodedetection_options; }
-
-             buffered_transfer_options&  get_buffered_transfer_options()  noexcept { return m_bufferedtransfer_options; }
-             capnegotiation_options&     get_capnegotiation_options() noexcept { return m_capnegotiation_options; }
-             color_options&              get_color_options() noexcept { return m_color_options; }
-             compression_options&        get_compression_options() noexcept { return m_compression_options; }
-             deviceevent_options&        get_deviceevent_options() noexcept { return m_deviceevents_options; }
-             deviceparams_options&       get_deviceparams_options() noexcept { return m_deviceparams_options; }
-             doublefeed_options&         get_doublefeed_options() noexcept { return m_doublefeed_options; }
-             file_transfer_options&      get_file_transfer_options() noexcept { return m_filetransfer_options; }
-             general_options&            get_general_options() noexcept { return m_general_options; }
-             imageinformation_options&   get_imageinformation_options() noexcept { return m_imageinformation_options; }
-             imageparameter_options&     get_imageparameter_options() noexcept { return m_imageparameter_options; }
-             imagetype_options&          get_imagetype_options() noexcept { return m_imagetype_options; }
-             imprinter_options&          get_imprinter_options() noexcept { return m_imprinter_options; }
-             jobcontrol_options&         get_jobcontrol_options() noexcept { return m_jobcontrol_options; }
-             language_options&           get_language_options() noexcept { return m_language_options;  }
-             micr_options&               get_micr_options() noexcept { return m_micr_options; }
-             pages_options&              get_pages_options() noexcept { return m_pages_options; }
-             paperhandling_options&      get_paperhandling_options() noexcept { return m_paperhandling_options; }
-             patchcode_options&          get_patchcode_options() noexcept { return m_patchcode_options; }
-             powermonitor_options&       get_powermonitor_options() noexcept { return m_powermonitor_options; }
-             resolution_options&         get_resolution_options() noexcept { return m_resolution_options; }
-             userinterface_options&      get_userinterface_options() noexcept { return m_userinterface_options; }
-             blankpage_options&          get_blank_page_options() noexcept { return m_blankpage_options; }
-             pdf_options&                get_pdf_options() noexcept { return m_pdf_options; }
+             barcodedetection_options&   get_barcodedetection_options() { return m_barcodedetection_options.get_mutable(); }
+             const barcodedetection_options& get_barcodedetection_options() const noexcept { return m_barcodedetection_options.get(); }
+
+             buffered_transfer_options&  get_buffered_transfer_options() { return m_bufferedtransfer_options.get_mutable(); }
+             const buffered_transfer_options& get_buffered_transfer_options() const noexcept { return m_bufferedtransfer_options.get(); }
+             capnegotiation_options&     get_capnegotiation_options() { return m_capnegotiation_options.get_mutable(); }
+             const capnegotiation_options& get_capnegotiation_options() const noexcept { return m_capnegotiation_options.get(); }
+             color_options&              get_color_options() { return m_color_options.get_mutable(); }
+             const color_options&        get_color_options() const noexcept { return m_color_options.get(); }
+             compression_options&        get_compression_options() { return m_compression_options.get_mutable(); }
+             const compression_options&  get_compression_options() const noexcept { return m_compression_options.get(); }
+             deviceevent_options&        get_deviceevent_options() { return m_deviceevents_options.get_mutable(); }
+             const deviceevent_options&  get_deviceevent_options() const noexcept { return m_deviceevents_options.get(); }
+             deviceparams_options&       get_deviceparams_options() { return m_deviceparams_options.get_mutable(); }
+             const deviceparams_options& get_deviceparams_options() const noexcept { return m_deviceparams_options.get(); }
+             doublefeed_options&         get_doublefeed_options() { return m_doublefeed_options.get_mutable(); }
+             const doublefeed_options&   get_doublefeed_options() const noexcept { return m_doublefeed_options.get(); }
+             file_transfer_options&      get_file_transfer_options() { return m_filetransfer_options.get_mutable(); }
+             const file_transfer_options& get_file_transfer_options() const noexcept { return m_filetransfer_options.get(); }
+             general_options&            get_general_options() { return m_general_options.get_mutable(); }
+             const general_options&      get_general_options() const noexcept { return m_general_options.get(); }
+             imageinformation_options&   get_imageinformation_options() { return m_imageinformation_options.get_mutable(); }
+             const imageinformation_options& get_imageinformation_options() const noexcept { return m_imageinformation_options.get(); }
+             imageparameter_options&     get_imageparameter_options() { return m_imageparameter_options.get_mutable(); }
+             const imageparameter_options& get_imageparameter_options() const noexcept { return m_imageparameter_options.get(); }
+             imagetype_options&          get_imagetype_options() { return m_imagetype_options.get_mutable(); }
+             const imagetype_options&    get_imagetype_options() const noexcept { return m_imagetype_options.get(); }
+             imprinter_options&          get_imprinter_options() { return m_imprinter_options.get_mutable(); }
+             const imprinter_options&    get_imprinter_options() const noexcept { return m_imprinter_options.get(); }
+             jobcontrol_options&         get_jobcontrol_options() { return m_jobcontrol_options.get_mutable(); }
+             const jobcontrol_options&   get_jobcontrol_options() const noexcept { return m_jobcontrol_options.get(); }
+             language_options&           get_language_options() { return m_language_options.get_mutable(); }
+             const language_options&     get_language_options() const noexcept { return m_language_options.get(); }
+             micr_options&               get_micr_options() { return m_micr_options.get_mutable(); }
+             const micr_options&         get_micr_options() const noexcept { return m_micr_options.get(); }
+             pages_options&              get_pages_options() { return m_pages_options.get_mutable(); }
+             const pages_options&        get_pages_options() const noexcept { return m_pages_options.get(); }
+             paperhandling_options&      get_paperhandling_options() { return m_paperhandling_options.get_mutable(); }
+             const paperhandling_options& get_paperhandling_options() const noexcept { return m_paperhandling_options.get(); }
+             patchcode_options&          get_patchcode_options() { return m_patchcode_options.get_mutable(); }
+             const patchcode_options&    get_patchcode_options() const noexcept { return m_patchcode_options.get(); }
+             powermonitor_options&       get_powermonitor_options() { return m_powermonitor_options.get_mutable(); }
+             const powermonitor_options& get_powermonitor_options() const noexcept { return m_powermonitor_options.get(); }
+             resolution_options&         get_resolution_options() { return m_resolution_options.get_mutable(); }
+             const resolution_options&   get_resolution_options() const noexcept { return m_resolution_options.get(); }
+             userinterface_options&      get_userinterface_options() { return m_userinterface_options.get_mutable(); }
+             const userinterface_options& get_userinterface_options() const noexcept { return m_userinterface_options.get(); }
+             blankpage_options&          get_blank_page_options() { return m_blankpage_options.get_mutable(); }
+             const blankpage_options&    get_blank_page_options() const noexcept { return m_blankpage_options.get(); }
+             pdf_options&                get_pdf_options() { return m_pdf_options.get_mutable(); }
+             const pdf_options&          get_pdf_options() const noexcept { return m_pdf_options.get(); }
      };
   }
 }
+
+namespace std
+{
+    template <>
+    struct hash<dynarithmic::twain::acquire_characteristics>
+    {
+        std::size_t operator()(const dynarithmic::twain::acquire_characteristics& ac) const { return ac.get_hash(); }
+    };
+}
 #endif
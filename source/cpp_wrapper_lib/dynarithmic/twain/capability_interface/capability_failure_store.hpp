@@ -0,0 +1,164 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_CAPABILITY_FAILURE_STORE_HPP
+#define DTWAIN_CAPABILITY_FAILURE_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "twain.h"
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Remembers the capability sets that a device rejected, so that later jobs do not send them again.
+        ///
+        /// Some devices report a capability in CAP_SUPPORTEDCAPS, but reject certain values every time (for example,
+        /// ICAP_HALFTONES set to "none").  Each rejected set costs a round trip to the device, and sometimes a timeout in
+        /// the driver.  A failure is recorded for the device identity, capability and value (see
+        /// capability_interface::set_failure_store()), and written to the store's file when it is recorded.  A set that
+        /// is in the store is skipped without communicating with the device, and a warning is logged.
+        ///
+        /// Only errors that mean the device rejected the value are recorded (see is_learnable_error()).  Errors such as
+        /// a capability sequence error depend on the order of the sets, and are not recorded.  A rejected value is not
+        /// recorded for a capability that depends on other capabilities (see capability_dependency_table), since the same
+        /// value may be accepted when those capabilities have other values.
+        class capability_failure_store
+        {
+            public:
+                struct failure_info
+                {
+                    std::string device;         // see make_device_key()
+                    int32_t cap_value = 0;
+                    std::string value;          // the operation and values that were set
+                    int32_t error_code = 0;     // the error returned by the device when the set failed
+                };
+
+            private:
+                using key_type = std::tuple<std::string, int32_t, std::string>;
+                mutable std::mutex m_mutex;
+                std::string m_strFile;
+                std::map<key_type, int32_t> m_failures;
+                std::size_t m_skipped = 0;
+
+                // Writes all of the failures to the file.  m_mutex must be locked.
+                bool write_file() const;
+
+            public:
+                capability_failure_store() = default;
+                explicit capability_failure_store(std::string file) : m_strFile(std::move(file)) {}
+                capability_failure_store(const capability_failure_store&) = delete;
+                capability_failure_store& operator=(const capability_failure_store&) = delete;
+
+                /// Replaces the characters that separate the fields of the file.  The device and value keys passed to
+                /// add() and find() must not contain these characters.
+                static std::string make_field(std::string s)
+                {
+                    for (auto& ch : s)
+                    {
+                        if (ch == '\t' || ch == '\r' || ch == '\n')
+                            ch = ' ';
+                    }
+                    return s;
+                }
+
+                /// Returns the key used to identify a device.  The manufacturer, product family, product name and
+                /// version of the device are used, so a driver update starts with no recorded failures.
+                static std::string make_device_key(const TW_IDENTITY& id)
+                {
+                    return make_field(std::string(id.Manufacturer) + "|" + id.ProductFamily + "|" + id.ProductName + "|" +
+                                      std::to_string(id.Version.MajorNum) + "." + std::to_string(id.Version.MinorNum) + "|" +
+                                      id.Version.Info);
+                }
+
+                /// Returns true if **error** means that the device rejected the capability **capvalue** or the value, no matter
+                /// what the other capabilities are set to
+                static bool is_learnable_error(int32_t capvalue, int32_t error);
+
+                /// Sets the file the failures are read from and written to.  If empty, the failures are only kept in memory.
+                capability_failure_store& set_file(std::string file)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_strFile = std::move(file);
+                    return *this;
+                }
+
+                std::string get_file() const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_strFile;
+                }
+
+                /// Reads the failures from the file.  A missing file is not an error.
+                bool load();
+
+                /// Removes all the failures, and writes the empty store to the file
+                bool clear();
+
+                /// Records that setting **value** failed with **error** for the capability on **device**, and writes the
+                /// store to the file.
+                void add(const std::string& device, int32_t capvalue, const std::string& value, int32_t error);
+
+                /// Returns true if setting **value** is known to fail for the capability on **device**.  If so, **error**
+                /// is set to the error that was returned, and the set is counted as skipped.
+                bool find(const std::string& device, int32_t capvalue, const std::string& value, int32_t& error)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto iter = m_failures.find(key_type(device, capvalue, value));
+                    if (iter == m_failures.end())
+                        return false;
+                    error = iter->second;
+                    ++m_skipped;
+                    return true;
+                }
+
+                /// Returns the number of sets skipped by find()
+                std::size_t get_skipped_count() const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_skipped;
+                }
+
+                std::size_t size() const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_failures.size();
+                }
+
+                std::vector<failure_info> get_failures() const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    std::vector<failure_info> vFailures;
+                    vFailures.reserve(m_failures.size());
+                    for (auto& f : m_failures)
+                        vFailures.push_back({ std::get<0>(f.first), std::get<1>(f.first), std::get<2>(f.first), f.second });
+                    return vFailures;
+                }
+        };
+    }
+}
+#endif
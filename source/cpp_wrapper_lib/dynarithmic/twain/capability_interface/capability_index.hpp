@@ -0,0 +1,107 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_CAPABILITY_INDEX_HPP
+#define DTWAIN_CAPABILITY_INDEX_HPP
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "twain.h"
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// A set of capability values that can be tested in constant time.
+        ///
+        /// The standard capabilities (values below CAP_CUSTOMBASE) are kept in a bitset, so testing one of them is a
+        /// single bit test.  Custom capabilities are kept in a small sorted table, since a device usually has only a few.
+        class capability_index
+        {
+            public:
+                static constexpr std::size_t standard_size = CAP_CUSTOMBASE;
+
+            private:
+                std::bitset<standard_size> m_standard;
+                std::vector<int32_t> m_custom;
+                std::size_t m_count = 0;
+
+            public:
+                bool contains(int32_t capvalue) const noexcept
+                {
+                    if (static_cast<uint32_t>(capvalue) < standard_size)
+                        return m_standard.test(static_cast<std::size_t>(capvalue));
+                    return std::binary_search(m_custom.begin(), m_custom.end(), capvalue);
+                }
+
+                void insert(int32_t capvalue)
+                {
+                    if (static_cast<uint32_t>(capvalue) < standard_size)
+                    {
+                        if (!m_standard.test(static_cast<std::size_t>(capvalue)))
+                        {
+                            m_standard.set(static_cast<std::size_t>(capvalue));
+                            ++m_count;
+                        }
+                        return;
+                    }
+                    auto iter = std::lower_bound(m_custom.begin(), m_custom.end(), capvalue);
+                    if (iter == m_custom.end() || *iter != capvalue)
+                    {
+                        m_custom.insert(iter, capvalue);
+                        ++m_count;
+                    }
+                }
+
+                void erase(int32_t capvalue)
+                {
+                    if (static_cast<uint32_t>(capvalue) < standard_size)
+                    {
+                        if (m_standard.test(static_cast<std::size_t>(capvalue)))
+                        {
+                            m_standard.reset(static_cast<std::size_t>(capvalue));
+                            --m_count;
+                        }
+                        return;
+                    }
+                    auto iter = std::lower_bound(m_custom.begin(), m_custom.end(), capvalue);
+                    if (iter != m_custom.end() && *iter == capvalue)
+                    {
+                        m_custom.erase(iter);
+                        --m_count;
+                    }
+                }
+
+                void clear()
+                {
+                    m_standard.reset();
+                    m_custom.clear();
+                    m_count = 0;
+                }
+
+                bool empty() const noexcept { return m_count == 0; }
+                std::size_t size() const noexcept { return m_count; }
+        };
+    }
+}
+#endif
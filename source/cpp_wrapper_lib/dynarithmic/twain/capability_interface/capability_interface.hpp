@@ -51,19 +51,34 @@ OF THIRD PARTY RIGHTS.
 #include <vector>
 #include <algorithm>
 #include <set>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <string>
 #ifdef _WIN32
     #include <windows.h>
 #endif
 #include "twain.h"
 #include <dynarithmic/twain/types/twain_capbasics.hpp>
+#include <dynarithmic/twain/capability_interface/capability_failure_store.hpp>
+#include <dynarithmic/twain/capability_interface/capability_index.hpp>
+#include <dynarithmic/twain/capability_interface/capability_metadata.hpp>
+#include <dynarithmic/twain/capability_interface/capability_set_planner.hpp>
+#include <dynarithmic/twain/capability_interface/capability_snapshot.hpp>
+#include <dynarithmic/twain/capability_interface/device_profile.hpp>
 #include <dynarithmic/twain/types/twain_types.hpp>
 #include <dynarithmic/twain/types/twain_range.hpp>
 #include <dynarithmic/twain/tostring/tostring.hpp>
 #include <dynarithmic/twain/types/underlying_type.hpp>
+#include <dynarithmic/twain/logging/trace_recorder.hpp>
+#include <dynarithmic/twain/session/twain_metrics.hpp>
 
 namespace dynarithmic {
 namespace twain {
     class twain_source;
+    class capability_listener;
 
     struct get_operation_type
     {
@@ -126,12 +141,17 @@ namespace twain {
         capability_interface(capability_interface&& rhs) noexcept :
                           m_Source(rhs.m_Source),
                           m_caps(std::move(rhs.m_caps)),
+                          m_supported_caps(std::move(rhs.m_supported_caps)),
                           m_custom_caps(std::move(rhs.m_custom_caps)),
                           m_extended_caps(std::move(rhs.m_extended_caps)),
                           m_extendedimage_caps(std::move(rhs.m_extendedimage_caps)),
                           m_cap_cache(std::move(rhs.m_cap_cache)),
+                          m_array_pool(std::move(rhs.m_array_pool)),
                           m_cacheable_set(std::move(rhs.m_cacheable_set)),
-                          m_return_type(std::move(rhs.m_return_type))
+                          m_return_type(std::move(rhs.m_return_type)),
+                          m_set_plan_report(std::move(rhs.m_set_plan_report)),
+                          m_applied_sets(std::move(rhs.m_applied_sets)),
+                          m_bSkipUnchangedSets(rhs.m_bSkipUnchangedSets)
         {
             rhs.m_Source = nullptr;
         }
@@ -141,12 +161,17 @@ namespace twain {
             if (&rhs != this)
             {
                 m_caps = std::move(rhs.m_caps);
+                m_supported_caps = std::move(rhs.m_supported_caps);
                 m_custom_caps = std::move(rhs.m_custom_caps);
                 m_extended_caps = std::move(rhs.m_extended_caps);
                 m_extendedimage_caps = std::move(rhs.m_extendedimage_caps);
                 m_cap_cache = std::move(rhs.m_cap_cache);
+                m_array_pool = std::move(rhs.m_array_pool);
                 m_cacheable_set = std::move(rhs.m_cacheable_set);
                 m_return_type = rhs.m_return_type;
+                m_set_plan_report = std::move(rhs.m_set_plan_report);
+                m_applied_sets = std::move(rhs.m_applied_sets);
+                m_bSkipUnchangedSets = rhs.m_bSkipUnchangedSets;
                 m_Source = rhs.m_Source;
                 rhs.m_Source = nullptr;
             }
@@ -220,8 +245,9 @@ namespace twain {
             long supported_ops;
             long data_type;
             std::array<int8_t, 7> container_type; 
+            long array_type;    // DTWAIN_ARRAYxxx used to set the capability, or -1 if not known yet
             twain_cap_info(const twain_string_type& n = "", int ops = 0, long type_=TWTY_INT16, long =-1) :
-                            name(n), supported_ops(ops), data_type(type_), container_type{-1,-1,-1,-1,-1,-1,-1} {}
+                            name(n), supported_ops(ops), data_type(type_), container_type{-1,-1,-1,-1,-1,-1,-1}, array_type(-1) {}
         };
 
         typedef std::map<twain_cap_type, twain_cap_info> source_cap_info;
@@ -299,6 +325,7 @@ namespace twain {
 
         DTWAIN_SOURCE m_Source;
         mutable source_cap_info m_caps;
+        capability_index m_supported_caps;  // the keys of m_caps, for the support test done on each get and set
         mutable source_cap_info m_custom_caps;
         mutable source_cap_info m_extended_caps;
         mutable source_cap_info m_extendedimage_caps;
@@ -306,11 +333,249 @@ namespace twain {
         using capability_cache = std::unordered_map<int, cache_vector_type>;
         using cache_set_type = std::unordered_set<int>;
         mutable capability_cache m_cap_cache;
+        mutable twain_array_pool m_array_pool;  // scratch arrays for set_cap_values
         cache_set_type m_cacheable_set;
         mutable cap_return_type m_return_type;
+        mutable std::unique_ptr<capability_set_plan> m_set_plan;  // not null between begin_set_plan() and end_set_plan()
+        capability_set_plan::report m_set_plan_report;
 
         struct capability_info_struct;
         bool m_feeder_supported = false;
+        capability_listener* m_listener = nullptr;
+        twain_source* m_listener_source = nullptr;
+        capability_failure_store* m_failure_store = nullptr;
+        std::string m_failure_device;       // the device key used with m_failure_store
+        device_profile* m_profile_recorder = nullptr;  // not null between begin_profile_recording() and end_profile_recording()
+        mutable std::unordered_map<int, std::string> m_applied_sets;   // the key of the last set sent for each capability
+        bool m_bSkipUnchangedSets = false;
+
+        // Informs the capability_listener (if one is set) of each capability get or set.  Defined after the
+        // capability_listener class.
+        std::chrono::steady_clock::time_point notify_get_start(int capvalue, const getcap_operation_info& gcType) const;
+        void notify_get_result(int capvalue, const getcap_operation_info& gcType, std::chrono::steady_clock::time_point start,
+                               bool bSuccess, LONG error, bool bFromCache) const;
+        std::chrono::steady_clock::time_point notify_set_start(int capvalue, const setcap_operation_info& scType) const;
+        void notify_set_result(int capvalue, const setcap_operation_info& scType, std::chrono::steady_clock::time_point start,
+                               bool bSuccess, LONG error) const;
+
+        // Adds a capability get or set that is sent to the device to the trace, if tracing is enabled.  The event name is
+        // built in a stack buffer from capability_metadata_table, so this does not allocate or call the DTWAIN library.
+        class cap_trace_scope
+        {
+            const char* m_operation;
+            int m_capvalue;
+            bool m_bTrace;
+            uint64_t m_start;
+            public:
+                cap_trace_scope(const char* operation, int capvalue) :
+                    m_operation(operation), m_capvalue(capvalue),
+                    m_bTrace(trace_recorder::instance().is_enabled()), m_start(m_bTrace ? trace_recorder::instance().now() : 0) {}
+                cap_trace_scope(const cap_trace_scope&) = delete;
+                cap_trace_scope& operator=(const cap_trace_scope&) = delete;
+                ~cap_trace_scope()
+                {
+                    if (!m_bTrace)
+                        return;
+                    auto& recorder = trace_recorder::instance();
+                    char name[trace_recorder::max_name_size];
+                    if (const auto* metadata = capability_metadata_table::find(m_capvalue))
+                        snprintf(name, sizeof name, "%s %s", m_operation, metadata->name);
+                    else
+                        snprintf(name, sizeof name, "%s capability %d", m_operation, m_capvalue);
+                    recorder.complete(trace_recorder::category::capability, name, m_start, recorder.now() - m_start);
+                }
+        };
+
+        // Reads the values of one capability into the vector that matches its data type (see snapshot())
+        bool read_snapshot_values(capability_snapshot::entry& e, int cap, const getcap_operation_info& gcType, std::vector<long>& vLong,
+                                  std::vector<double>& vDouble, std::vector<std::string>& vString) const
+        {
+            cap_return_type ret = { false, DTWAIN_ERR_CAP_NO_SUPPORT };
+            switch (e.data_type)
+            {
+                case TWTY_FIX32:
+                    ret = get_cap_values(vDouble, cap, gcType);
+                break;
+                case TWTY_STR32:
+                case TWTY_STR64:
+                case TWTY_STR128:
+                case TWTY_STR255:
+                case TWTY_STR1024:
+                case TWTY_UNI512:
+                    ret = get_cap_values(vString, cap, gcType);
+                break;
+                case TWTY_FRAME:
+                case TWTY_HANDLE:
+                    return false;
+                default:
+                    ret = get_cap_values(vLong, cap, gcType);
+            }
+            if (!ret.return_value)
+                e.error_code = ret.error_code;
+            return ret.return_value;
+        }
+
+        // Compares a value that was set with the current value read back from the device.  FIX32 values only keep
+        // 1/65536 of precision, so floating point values are compared to within that.
+        template <typename T>
+        static bool is_same_set_value(const T& setValue, const T& currentValue) { return setValue == currentValue; }
+
+        static bool is_same_set_value(double setValue, double currentValue)
+        {
+            return std::fabs(setValue - currentValue) <= 1.0 / 65536.0;
+        }
+
+        static bool is_same_set_value(const twain_frame<double>& setValue, const twain_frame<double>& currentValue)
+        {
+            return is_same_set_value(setValue.left, currentValue.left) && is_same_set_value(setValue.top, currentValue.top) &&
+                   is_same_set_value(setValue.right, currentValue.right) && is_same_set_value(setValue.bottom, currentValue.bottom);
+        }
+
+        // Adds a set to the active capability_set_plan.  A set of a single value can be verified by reading the current
+        // value, so a verify function is added for it.
+        template <typename Container>
+        void add_to_set_plan(const Container& C, int capvalue, const setcap_operation_info& scType) const
+        {
+            using value_type = typename Container::value_type;
+            const bool bUnchanged = m_bSkipUnchangedSets && is_set_applied(capvalue, make_set_value_key(C, scType));
+            std::vector<value_type> vValues(C.begin(), C.end());
+            const long operation = vValues.empty() ? static_cast<long>(set_operation_type::RESET) : static_cast<long>(scType.get_operation());
+            capability_set_plan::verify_function verify;
+            if (vValues.size() == 1 && operation == set_operation_type::SET)
+            {
+                const value_type setValue = vValues.front();
+                verify = [this, capvalue, setValue]
+                {
+                    std::vector<value_type> vCurrent;
+                    const auto ret = get_cap_values(vCurrent, capvalue, get_current());
+
+                    // If the current value cannot be read, there is nothing to compare with
+                    if (!ret.return_value || vCurrent.empty())
+                        return true;
+                    return is_same_set_value(setValue, static_cast<value_type>(vCurrent.front()));
+                };
+            }
+            m_set_plan->add(capvalue, operation, [this, vValues = std::move(vValues), capvalue, scType]
+                            {
+                                const auto ret = set_cap_values(vValues, capvalue, scType);
+                                return std::make_pair(ret.return_value, static_cast<int32_t>(ret.error_code));
+                            },
+                            std::move(verify), bUnchanged);
+        }
+
+        // Removes the capabilities that depend on **capvalue** from the sets that were sent, since setting a
+        // capability can change the capabilities that depend on it
+        void forget_dependent_sets(int capvalue) const
+        {
+            for (auto iter = m_applied_sets.begin(); iter != m_applied_sets.end();)
+            {
+                if (capability_dependency_table::depends_on(iter->first, capvalue))
+                    iter = m_applied_sets.erase(iter);
+                else
+                    ++iter;
+            }
+        }
+
+        static void append_key_value(std::ostringstream& strm, const std::string& value)
+        {
+            strm << capability_failure_store::make_field(value);
+        }
+
+        static void append_key_value(std::ostringstream& strm, const twain_frame<double>& value)
+        {
+            strm << value.left << " " << value.top << " " << value.right << " " << value.bottom;
+        }
+
+        template <typename T>
+        static void append_key_value(std::ostringstream& strm, const T& value)
+        {
+            strm << +value;
+        }
+
+        // Returns the key of a set:  the set operation, followed by the values.  The key identifies the set in the
+        // capability_failure_store, and is compared with the last set sent to find unchanged sets.
+        template <typename Container>
+        static std::string make_set_value_key(const Container& C, const setcap_operation_info& scType)
+        {
+            std::ostringstream strm;
+            strm << std::setprecision(10);
+            if (C.empty())
+                strm << set_operation_type::RESET;
+            else
+                strm << scType.get_operation();
+            const char* separator = ":";
+            for (const auto& value : C)
+            {
+                strm << separator;
+                append_key_value(strm, static_cast<typename Container::value_type>(value));
+                separator = ",";
+            }
+            return strm.str();
+        }
+
+        template <typename T>
+        static std::string make_profile_value(const T& value)
+        {
+            std::ostringstream strm;
+            strm << std::setprecision(10);
+            append_key_value(strm, value);
+            return strm.str();
+        }
+
+        static bool parse_profile_value(const std::string& text, std::string& value)
+        {
+            value = text;
+            return true;
+        }
+
+        static bool parse_profile_value(const std::string& text, twain_frame<double>& value)
+        {
+            std::istringstream strm(text);
+            return static_cast<bool>(strm >> value.left >> value.top >> value.right >> value.bottom);
+        }
+
+        template <typename T>
+        static bool parse_profile_value(const std::string& text, T& value)
+        {
+            std::istringstream strm(text);
+            return static_cast<bool>(strm >> value);
+        }
+
+        // Adds a set that was sent to the device to the profile being recorded
+        template <typename Container>
+        void record_profile_set(const Container& C, int capvalue, const setcap_operation_info& scType) const
+        {
+            device_profile::set_entry entry;
+            entry.cap_value = capvalue;
+            entry.operation = C.empty() ? static_cast<long>(set_operation_type::RESET) : static_cast<long>(scType.get_operation());
+            for (const auto& value : C)
+                entry.values.push_back(make_profile_value(static_cast<typename Container::value_type>(value)));
+            m_profile_recorder->add(std::move(entry));
+        }
+
+        // Replaces the value of a recorded set with the current value of the capability
+        template <typename T>
+        bool read_profile_value(device_profile::set_entry& entry) const
+        {
+            std::vector<T> vCurrent;
+            const auto ret = get_cap_values(vCurrent, entry.cap_value, get_current());
+            if (!ret.return_value || vCurrent.size() != 1)
+                return false;
+            entry.values.front() = make_profile_value(vCurrent.front());
+            return true;
+        }
+
+        template <typename T>
+        cap_return_type replay_profile_set(const device_profile::set_entry& entry) const
+        {
+            std::vector<T> vValues(entry.values.size());
+            for (std::size_t i = 0; i < vValues.size(); ++i)
+            {
+                if (!parse_profile_value(entry.values[i], vValues[i]))
+                    return {false, DTWAIN_ERR_INVALID_PARAM};
+            }
+            return set_cap_values(vValues, entry.cap_value, setcap_operation_info().set_operation(static_cast<set_operation_type::value_type>(entry.operation)));
+        }
 
         template <typename Container>
         void copy_to_cache(const Container& ct, int capvalue) const
@@ -350,6 +615,7 @@ namespace twain {
         {
             char szBuffer[256];
             m_caps.clear();
+            m_supported_caps.clear();
             m_custom_caps.clear();
             m_cacheable_set.clear();
             m_extendedimage_caps.clear();
@@ -357,14 +623,27 @@ namespace twain {
             auto vCaps = get_cap_values<std::vector<CAP_SUPPORTEDCAPS_::value_type>>(CAP_SUPPORTEDCAPS);
             std::for_each(vCaps.begin(), vCaps.end(), [&](const CAP_SUPPORTEDCAPS_::value_type capVal)
             {
-                API_INSTANCE DTWAIN_GetNameFromCapA(capVal, szBuffer, 255);
+                // The name and data type of the standard capabilities are known at compile time.  Only the custom
+                // capabilities need to be looked up.  The supported operations depend on the device.
+                const char* capName = szBuffer;
+                DTWAIN_LONG theType;
+                if (const auto* metadata = capability_metadata_table::find(capVal))
+                {
+                    capName = metadata->name;
+                    theType = metadata->data_type;
+                }
+                else
+                {
+                    API_INSTANCE DTWAIN_GetNameFromCapA(capVal, szBuffer, 255);
+                    theType = API_INSTANCE DTWAIN_GetCapDataType(m_Source, capVal);
+                }
                 LONG ops;
                 DTWAIN_BOOL theOpts = API_INSTANCE DTWAIN_GetCapOperations(m_Source, capVal, &ops);
-                DTWAIN_LONG theType = API_INSTANCE DTWAIN_GetCapDataType(m_Source, capVal);
                 if (theOpts)
-                    m_caps[capVal] = { szBuffer, ops, theType };
+                    m_caps[capVal] = { capName, ops, theType };
                 else
-                    m_caps[capVal] = { szBuffer, -1, theType };
+                    m_caps[capVal] = { capName, -1, theType };
+                m_supported_caps.insert(capVal);
                 m_cacheable_set.insert(capVal);
             });
             initialize_cached_set();
@@ -441,7 +720,7 @@ namespace twain {
         {
             if (!m_Source)
                 return { false, DTWAIN_ERR_BAD_SOURCE };
-            if (!m_caps.empty() && m_caps.find(capvalue) == m_caps.end())
+            if (!m_supported_caps.empty() && !m_supported_caps.contains(capvalue))
                 return { false, DTWAIN_ERR_CAP_NO_SUPPORT };
 
             const bool is_cache =
@@ -452,18 +731,29 @@ namespace twain {
             {
                 container.clear();
                 if (copy_from_cache(container, capvalue))
+                {
+                    if (m_listener)
+                        notify_get_result(capvalue, gcType, std::chrono::steady_clock::now(), true, DTWAIN_NO_ERROR, true);
                     return { true, DTWAIN_NO_ERROR };
+                }
             }
 
+            cap_trace_scope traceScope("get", capvalue);
             twain_array ta;
             auto getToUse = static_cast<LONG>(gcType.get_operation());
             auto containerType = gcType.get_container_type();
             auto dataType = gcType.get_data_type();
 
+            const auto startTime = m_listener ? notify_get_start(capvalue, gcType) : std::chrono::steady_clock::time_point();
             bool retVal = API_INSTANCE DTWAIN_GetCapValuesEx2(m_Source, capvalue,
                 getToUse, containerType, dataType, ta.get_array_ptr()) != 0;
+            const LONG lastError = retVal ? DTWAIN_NO_ERROR : API_INSTANCE DTWAIN_GetLastError();
             if (!retVal)
-                return { false, API_INSTANCE DTWAIN_GetLastError() };
+                twain_metrics::instance().on_capability_failure();
+            if (m_listener)
+                notify_get_result(capvalue, gcType, startTime, retVal, lastError, false);
+            if (!retVal)
+                return { false, lastError };
             container.clear();
             twain_array_copy_traits::copy_from_twain_array(ta, ta.get_count(), container);
             if (is_cache)
@@ -618,6 +908,8 @@ namespace twain {
 
         static std::string get_cap_name_s(twain_cap_type t)
         {
+            if (const auto* metadata = capability_metadata_table::find(t))
+                return metadata->name;
             char capName[256];
             API_INSTANCE DTWAIN_GetNameFromCapA(t, capName, 255);
             return capName;
@@ -627,9 +919,8 @@ namespace twain {
         static ContainerOut get_cap_name_s(const ContainerIn& ct)
         {
             ContainerOut ret;
-            char capName[256];
             std::transform(ct.begin(), ct.end(), std::inserter(ret, ret.begin()), [&](uint16_t val) 
-                { API_INSTANCE DTWAIN_GetNameFromCapA(val, capName, 255); return capName; });
+                { return get_cap_name_s(static_cast<twain_cap_type>(val)); });
             return ret;
         }
 
@@ -657,26 +948,83 @@ namespace twain {
             const auto theSource = m_Source;
             if (!theSource)
                 return {false, DTWAIN_ERR_BAD_SOURCE};
-            if (!m_caps.empty() && m_caps.find(capvalue) == m_caps.end())
+            if (!m_supported_caps.empty() && !m_supported_caps.contains(capvalue))
                 return {false, DTWAIN_ERR_CAP_NO_SUPPORT};
+            if (m_set_plan)
+            {
+                add_to_set_plan(C, capvalue, scType);
+                return {true, DTWAIN_NO_ERROR};
+            }
+
+            // The key of the set is only built when it is looked up or recorded, so that a set does not allocate
+            // when there is no failure store and unchanged sets are not skipped.
+            const std::string valueKey = (m_failure_store || m_bSkipUnchangedSets) ? make_set_value_key(C, scType) : std::string();
 
+            // Do not send a set that the device is known to reject.  A recorded failure that is not learnable (for
+            // example, one written by an earlier version) is ignored.
+            if (m_failure_store)
+            {
+                int32_t knownError = DTWAIN_NO_ERROR;
+                if (m_failure_store->find(m_failure_device, capvalue, valueKey, knownError) &&
+                    capability_failure_store::is_learnable_error(capvalue, knownError))
+                {
+                    const std::string msg = "Warning: " + get_cap_name(capvalue) + " set (" + valueKey +
+                                            ") skipped, since the device rejected it previously with error " + std::to_string(knownError);
+                    API_INSTANCE DTWAIN_LogMessageA(msg.c_str());
+                    return {false, knownError};
+                }
+            }
+
+            cap_trace_scope traceScope("set", capvalue);
             twain_array ta;
+            twain_array* pArray = nullptr;
             BOOL retval = FALSE;
+            const auto startTime = m_listener ? notify_set_start(capvalue, scType) : std::chrono::steady_clock::time_point();
             if ( C.empty() )
                 retval = API_INSTANCE DTWAIN_SetCapValues(theSource, capvalue, DTWAIN_CAPRESET, NULL);
             else
             { 
-                twain_array_copy_traits::copy_to_twain_array(theSource, ta, capvalue, C);
+                // Reuse this source's scratch array for the capability's array type, instead of creating a new array
+                if (twain_array_copy_traits::is_poolable<typename Container::value_type>::value)
+                {
+                    const LONG arrayType = get_cap_array_type(capvalue);
+                    twain_array* pScratch = arrayType != -1 ? m_array_pool.acquire(arrayType, C.size()) : nullptr;
+                    if (pScratch && twain_array_copy_traits::fill_twain_array(*pScratch, C))
+                        pArray = pScratch;
+                }
+                if (!pArray)
+                {
+                    twain_array_copy_traits::copy_to_twain_array(theSource, ta, capvalue, C);
+                    pArray = &ta;
+                }
                 retval = API_INSTANCE DTWAIN_SetCapValuesEx2(theSource, 
                                                              capvalue, 
                                                              static_cast<LONG>(scType.get_operation()),
                                                              scType.get_container_type(), 
                                                              scType.get_data_type(), 
-                                                             ta.get_array());
+                                                             pArray->get_array());
             }
             LONG last_error = DTWAIN_NO_ERROR;
             if (!retval)
+            {
                 last_error = API_INSTANCE DTWAIN_GetLastError();
+                twain_metrics::instance().on_capability_failure();
+                if (m_failure_store && capability_failure_store::is_learnable_error(capvalue, last_error))
+                    m_failure_store->add(m_failure_device, capvalue, valueKey, last_error);
+            }
+
+            // A failed set may have left the capability with any value
+            if (m_bSkipUnchangedSets)
+            {
+                if (retval)
+                    set_applied(capvalue, valueKey);
+                else
+                    forget_applied_set(capvalue);
+            }
+            if (m_listener)
+                notify_set_result(capvalue, scType, startTime, retval ? true : false, last_error);
+            if (retval && m_profile_recorder)
+                record_profile_set(C, capvalue, scType);
             return {retval ? true : false, last_error};
         }
 
@@ -687,6 +1035,166 @@ namespace twain {
                             "Capability type does not match container value type");
             return set_cap_values(C, T::cap_value, scType);
         }
+
+        /// Starts planning capability sets.  Until end_set_plan() is called, set_cap_values() does not send the values
+        /// to the device, but adds the set to a capability_set_plan and returns success.
+        ///
+        /// @note Do not get a capability's current value while a plan is active, since the sets have not been sent yet.
+        void begin_set_plan()
+        {
+            if (!m_set_plan)
+                m_set_plan = std::make_unique<capability_set_plan>();
+        }
+
+        /// Sends the capability sets made since begin_set_plan() to the device, in dependency order.  The capabilities
+        /// that another set could have changed are verified, and set again once if they did not keep their value.
+        ///
+        /// @returns A report of the order of the sets, and the sets that were redundant, retried, changed or failed.
+        const capability_set_plan::report& end_set_plan()
+        {
+            if (m_set_plan)
+            {
+                // the plan is released first, so that the sets it runs go to the device
+                auto plan = std::move(m_set_plan);
+                m_set_plan_report = plan->run();
+            }
+            return m_set_plan_report;
+        }
+
+        bool is_set_plan_active() const { return m_set_plan != nullptr; }
+
+        /// Returns the report of the last plan run by end_set_plan()
+        const capability_set_plan::report& get_set_plan_report() const { return m_set_plan_report; }
+
+        /// Skips the sets in a plan (see begin_set_plan()) that send the same value as the last set of the capability,
+        /// unless a set of a capability it depends on is sent first.  Use this when the device keeps its capability values
+        /// between acquisitions, and call forget_applied_sets() when something else may have changed them (for
+        /// example, the user changing the settings in the device's user interface).
+        ///
+        /// The sets are only recorded while this is on, so the sets recorded so far are forgotten when it is changed.
+        void set_skip_unchanged_sets(bool bSkip)
+        {
+            if (bSkip != m_bSkipUnchangedSets)
+                m_applied_sets.clear();
+            m_bSkipUnchangedSets = bSkip;
+        }
+        bool is_skip_unchanged_sets() const { return m_bSkipUnchangedSets; }
+
+        /// Returns the key that set_cap_values() records for a set of the values in **C**.  Use this to record a set
+        /// made by a DTWAIN function with set_applied(), so that it matches the sets made with set_cap_values().
+        template <typename Container>
+        static std::string get_set_value_key(const Container& C, const setcap_operation_info& scType = setcap_operation_info())
+        {
+            return make_set_value_key(C, scType);
+        }
+
+        /// Returns true if **valueKey** was the last set sent for the capability
+        bool is_set_applied(int capvalue, const std::string& valueKey) const
+        {
+            auto iter = m_applied_sets.find(capvalue);
+            return iter != m_applied_sets.end() && iter->second == valueKey;
+        }
+
+        /// Records that the capability was set to **valueKey**.  This is also used for capabilities that are set by a
+        /// DTWAIN function instead of set_cap_values() (for example, DTWAIN_SetAcquireArea() sets ICAP_FRAMES).  Nothing
+        /// is recorded unless unchanged sets are skipped (see set_skip_unchanged_sets()).
+        void set_applied(int capvalue, std::string valueKey) const
+        {
+            if (!m_bSkipUnchangedSets)
+                return;
+            forget_dependent_sets(capvalue);
+            m_applied_sets[capvalue] = std::move(valueKey);
+        }
+
+        /// Forgets the last set of the capability, and of the capabilities that depend on it, so they are sent again
+        void forget_applied_set(int capvalue) const
+        {
+            if (m_applied_sets.empty())
+                return;
+            forget_dependent_sets(capvalue);
+            m_applied_sets.erase(capvalue);
+        }
+
+        void forget_applied_sets() { m_applied_sets.clear(); }
+
+        /// Starts recording the capability sets sent to the device into **profile**.  The sets already in the profile
+        /// are removed.
+        void begin_profile_recording(device_profile& profile)
+        {
+            profile.clear_sets();
+            m_profile_recorder = &profile;
+        }
+
+        /// Stops recording.  The value of each single-value set is replaced with the current value of the capability,
+        /// so that the profile holds the values the device kept.
+        void end_profile_recording()
+        {
+            auto* profile = m_profile_recorder;
+            m_profile_recorder = nullptr;
+            if (!profile)
+                return;
+            for (auto& entry : profile->get_sets())
+            {
+                if (entry.values.size() != 1 || entry.operation != set_operation_type::SET)
+                    continue;
+                switch (get_cap_data_type(entry.cap_value))
+                {
+                    case TWTY_FIX32:
+                        entry.verified = read_profile_value<double>(entry);
+                    break;
+                    case TWTY_STR32:
+                    case TWTY_STR64:
+                    case TWTY_STR128:
+                    case TWTY_STR255:
+                    case TWTY_STR1024:
+                    case TWTY_UNI512:
+                        entry.verified = read_profile_value<std::string>(entry);
+                    break;
+                    case TWTY_FRAME:
+                        entry.verified = read_profile_value<twain_frame<double>>(entry);
+                    break;
+                    case TWTY_HANDLE:
+                    break;
+                    default:
+                        entry.verified = read_profile_value<long>(entry);
+                }
+            }
+        }
+
+        /// Sends the sets of **profile** to the device, in the order they were recorded.  The sets are not planned or
+        /// verified.
+        ///
+        /// @returns true if all of the sets succeeded.
+        bool replay_profile(const device_profile& profile)
+        {
+            bool bAllSet = true;
+            for (auto& entry : profile.get_sets())
+            {
+                cap_return_type ret = { false, DTWAIN_ERR_CAP_NO_SUPPORT };
+                switch (get_cap_data_type(entry.cap_value))
+                {
+                    case TWTY_FIX32:
+                        ret = replay_profile_set<double>(entry);
+                    break;
+                    case TWTY_STR32:
+                    case TWTY_STR64:
+                    case TWTY_STR128:
+                    case TWTY_STR255:
+                    case TWTY_STR1024:
+                    case TWTY_UNI512:
+                        ret = replay_profile_set<std::string>(entry);
+                    break;
+                    case TWTY_FRAME:
+                        ret = replay_profile_set<twain_frame<double>>(entry);
+                    break;
+                    default:
+                        ret = replay_profile_set<long>(entry);
+                }
+                if (!ret.return_value)
+                    bAllSet = false;
+            }
+            return bAllSet;
+        }
             
         ///////////////////////////////////////////////////////////////////////////////////////////////
         template <typename CapType>
@@ -694,7 +1202,7 @@ namespace twain {
         {
             if (!m_Source)
                 return {false, DTWAIN_ERR_BAD_SOURCE};
-            if (!m_caps.empty() && m_caps.find(capToTest) == m_caps.end())
+            if (!m_supported_caps.empty() && !m_supported_caps.contains(capToTest))
                 return {false, DTWAIN_ERR_CAP_NO_SUPPORT};
             
             const bool is_cache = (m_cacheable_set.find(capToTest) != m_cacheable_set.end());
@@ -723,7 +1231,7 @@ namespace twain {
                                         { return variant_get_<CapType>(vt); });
 
                         twain_range<dtwain_underlying_type_v<CapType>> tr(vc.begin(), vc.end());
-                        bool found = tr.value_exists(static_cast<dtwain_underlying_type_v<CapType>>(capvalue));
+                        bool found = tr.contains(static_cast<dtwain_underlying_type_v<CapType>>(capvalue));
                         if ( found )
                             return {found, 1};
                         return {found, 0};
@@ -737,7 +1245,7 @@ namespace twain {
         {
             if (!m_Source)
                 return {false, DTWAIN_ERR_BAD_SOURCE};
-            if (!m_caps.empty() && m_caps.find(capToTest) == m_caps.end())
+            if (!m_supported_caps.empty() && !m_supported_caps.contains(capToTest))
                 return {false, DTWAIN_ERR_CAP_NO_SUPPORT};
             
             const bool is_cache = (m_cacheable_set.find(capToTest) != m_cacheable_set.end());
@@ -1058,6 +1566,20 @@ namespace twain {
             return get_cap_values(T::cap_value, scType);
         }
 
+        // Returns the DTWAIN_ARRAYxxx type used to set the capability, or -1 if it cannot be determined
+        LONG get_cap_array_type(int capValue) const
+        {
+            auto iter = m_caps.find(capValue);
+            if (iter != m_caps.end() && iter->second.array_type != -1)
+                return iter->second.array_type;
+            LONG arrayType = API_INSTANCE DTWAIN_GetCapArrayType(m_Source, capValue);
+            if (arrayType <= 0)
+                arrayType = -1;
+            if (iter != m_caps.end())
+                iter->second.array_type = arrayType;
+            return arrayType;
+        }
+
         int32_t get_cap_data_type(int capValue)
         {
             auto iter = m_caps.find(capValue);
@@ -1066,6 +1588,29 @@ namespace twain {
             return -1;
         }
         
+        /// Sets the listener that is informed of each capability get and set done through this interface.
+        ///
+        /// @param[in] ts The twain_source passed to the listener functions
+        /// @param[in] listener The listener.  If nullptr, no listener is called.
+        /// @note The listener is not owned by the capability_interface.
+        void set_listener(twain_source* ts, capability_listener* listener)
+        {
+            m_listener_source = ts;
+            m_listener = ts ? listener : nullptr;
+        }
+
+        /// Sets the store of capability sets that devices have rejected.  Sets that are in the store for **device**
+        /// are not sent, and sets that the device rejects are added to the store.
+        ///
+        /// @param[in] store The store.  If nullptr, all sets are sent to the device.
+        /// @param[in] device The device key (see capability_failure_store::make_device_key())
+        /// @note The store is not owned by the capability_interface.
+        void set_failure_store(capability_failure_store* store, std::string device)
+        {
+            m_failure_store = store;
+            m_failure_device = std::move(device);
+        }
+
         bool attach(DTWAIN_SOURCE s)
         {
             m_Source = s;
@@ -1075,7 +1620,11 @@ namespace twain {
         void detach()
         {
             m_Source = nullptr;
+            m_set_plan.reset();
+            m_profile_recorder = nullptr;
+            m_applied_sets.clear();
             m_cap_cache.clear();
+            m_array_pool.clear();
             m_cacheable_set.clear();
         }
         
@@ -1089,7 +1638,40 @@ namespace twain {
 
         bool is_cap_supported(twain_cap_type capValue) const
         {
-            return m_caps.find(capValue) != m_caps.end();
+            return m_supported_caps.contains(capValue);
+        }
+
+        /// Reads the supported (and optionally the current) values of the capabilities in **caps** from the device in
+        /// one pass, in capability order.  Capabilities that the device does not support are recorded as unsupported
+        /// without communicating with the device.
+        ///
+        /// @param[in] caps The capabilities to read.  Duplicates are read once.
+        /// @param[in] bGetCurrent If true, the current values (MSG_GETCURRENT) are also read.
+        /// @returns A capability_snapshot that can be queried without further communication with the device.
+        /// @note Frame (TWTY_FRAME) capabilities are recorded as supported or unsupported, but their values are not read.
+        capability_snapshot snapshot(std::vector<int> caps, bool bGetCurrent = true) const
+        {
+            std::sort(caps.begin(), caps.end());
+            caps.erase(std::unique(caps.begin(), caps.end()), caps.end());
+
+            capability_snapshot snap;
+            snap.m_entries.reserve(caps.size());
+            for (auto cap : caps)
+            {
+                capability_snapshot::entry e;
+                e.cap_value = cap;
+                e.supported = m_Source && is_cap_supported(static_cast<twain_cap_type>(cap));
+                if (e.supported)
+                {
+                    auto iter = m_caps.find(cap);
+                    e.data_type = iter != m_caps.end() ? iter->second.data_type : -1;
+                    e.values_read = read_snapshot_values(e, cap, get(), e.long_values, e.double_values, e.string_values);
+                    if (bGetCurrent)
+                        e.current_read = read_snapshot_values(e, cap, get_current(), e.long_current, e.double_current, e.string_current);
+                }
+                snap.m_entries.push_back(std::move(e));
+            }
+            return snap;
         }
 
         template <typename T>
@@ -1135,7 +1717,7 @@ namespace twain {
                 else
                 {
                     twain_range<typename Cap::value_type> tr(vect.begin(), vect.end());
-                    bool found = tr.value_exists(static_cast<dtwain_underlying_type_v<typename Cap::value_type>>(capValue));
+                    bool found = tr.contains(static_cast<dtwain_underlying_type_v<typename Cap::value_type>>(capValue));
                     if ( found )
                         return true;
                     return false;
@@ -2209,16 +2791,78 @@ namespace twain {
         twain_container_type::value_type get_zoomfactor_container_type(const setcap_operation_info& scType) { return get_cap_container_type(0x113e, scType); }
     };
 
+    /// Receives notifications of the capability gets and sets done by a twain_source's capability_interface.
+    ///
+    /// The start functions are called before the request is sent to the device, and the result functions after the
+    /// device has responded.  A get that is satisfied from the capability cache does not call capvaluegetstart(), and
+    /// calls capvaluegetresult() with result_info::from_cache set to true.
     class capability_listener
     {
         public:
+            struct result_info
+            {
+                bool success = true;
+                LONG error = DTWAIN_NO_ERROR;
+                std::chrono::nanoseconds elapsed{};
+                bool from_cache = false;
+            };
+
             virtual void capvaluegetstart(twain_source&, int, const capability_interface::getcap_operation_info&) {}
             virtual void capvaluegetend(twain_source&, int, const capability_interface::getcap_operation_info&, bool) {}
             virtual void capvaluesetstart(twain_source&, int, const capability_interface::setcap_operation_info&) {}
             virtual void capvaluesetend(twain_source&, int, const capability_interface::setcap_operation_info&, bool) {}
+
+            /// Called when a get has completed.  By default, calls capvaluegetend() for gets that were sent to the device.
+            virtual void capvaluegetresult(twain_source& ts, int capvalue, const capability_interface::getcap_operation_info& gcType,
+                                           const result_info& info)
+            {
+                if (!info.from_cache)
+                    capvaluegetend(ts, capvalue, gcType, info.success);
+            }
+
+            /// Called when a set has completed.  By default, calls capvaluesetend().
+            virtual void capvaluesetresult(twain_source& ts, int capvalue, const capability_interface::setcap_operation_info& scType,
+                                           const result_info& info)
+            {
+                capvaluesetend(ts, capvalue, scType, info.success);
+            }
             virtual ~capability_listener() {}
     };
 
+    inline std::chrono::steady_clock::time_point capability_interface::notify_get_start(int capvalue, const getcap_operation_info& gcType) const
+    {
+        m_listener->capvaluegetstart(*m_listener_source, capvalue, gcType);
+        return std::chrono::steady_clock::now();
+    }
+
+    inline void capability_interface::notify_get_result(int capvalue, const getcap_operation_info& gcType,
+                                                        std::chrono::steady_clock::time_point start, bool bSuccess, LONG error,
+                                                        bool bFromCache) const
+    {
+        capability_listener::result_info info;
+        info.success = bSuccess;
+        info.error = error;
+        info.elapsed = bFromCache ? std::chrono::nanoseconds() : std::chrono::steady_clock::now() - start;
+        info.from_cache = bFromCache;
+        m_listener->capvaluegetresult(*m_listener_source, capvalue, gcType, info);
+    }
+
+    inline std::chrono::steady_clock::time_point capability_interface::notify_set_start(int capvalue, const setcap_operation_info& scType) const
+    {
+        m_listener->capvaluesetstart(*m_listener_source, capvalue, scType);
+        return std::chrono::steady_clock::now();
+    }
+
+    inline void capability_interface::notify_set_result(int capvalue, const setcap_operation_info& scType,
+                                                        std::chrono::steady_clock::time_point start, bool bSuccess, LONG error) const
+    {
+        capability_listener::result_info info;
+        info.success = bSuccess;
+        info.error = error;
+        info.elapsed = std::chrono::steady_clock::now() - start;
+        m_listener->capvaluesetresult(*m_listener_source, capvalue, scType, info);
+    }
+
     class extendedimagecap_handler
     {
         bool m_bStarted;
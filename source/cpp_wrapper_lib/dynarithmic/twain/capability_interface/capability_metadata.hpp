@@ -0,0 +1,293 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+// Generated from the capability section of DTWAIN's twaininfo.txt.  Lists the standard (non-custom) capabilities,
+// sorted by capability value.
+#ifndef DTWAIN_CAPABILITY_METADATA_HPP
+#define DTWAIN_CAPABILITY_METADATA_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "twain.h"
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Information about a standard TWAIN capability that does not depend on the device.
+        ///
+        /// **containers** holds the DTWAIN_CONTxxx values allowed by the TWAIN specification, one entry for each of
+        /// MSG_GET, MSG_GETCURRENT, MSG_GETDEFAULT, MSG_SET, MSG_SET (constraint), MSG_RESET and MSG_QUERYSUPPORT.
+        /// An entry of 0 means the operation is not allowed for the capability.
+        struct capability_metadata
+        {
+            int32_t cap_value;
+            const char* name;
+            int32_t data_type;                      // TWTY_xxx
+            std::array<uint8_t, 7> containers;
+
+            /// Returns the TWQC_xxx (DTWAIN_CO_xxx) operations that the TWAIN specification allows for the capability.  The
+            /// operations a device actually supports must still be queried from the device.
+            constexpr long get_allowed_ops() const noexcept
+            {
+                constexpr long ops[] = { TWQC_GET, TWQC_GETCURRENT, TWQC_GETDEFAULT, TWQC_SET, TWQC_SETCONSTRAINT, TWQC_RESET };
+                long allowed = 0;
+                for (std::size_t i = 0; i < std::size(ops); ++i)
+                {
+                    if (containers[i])
+                        allowed |= ops[i];
+                }
+                return allowed;
+            }
+        };
+
+        namespace capability_metadata_table
+        {
+            namespace details
+            {
+                inline constexpr capability_metadata entries[] = {
+                    { 0x0001, "CAP_XFERCOUNT",                          1, {  96,  32,  32,  32,  32,  32,  32 } },
+                    { 0x0100, "ICAP_COMPRESSION",                       4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x0101, "ICAP_PIXELTYPE",                         4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x0102, "ICAP_UNITS",                             4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x0103, "ICAP_XFERMECH",                          4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1000, "CAP_AUTHOR",                            11, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1001, "CAP_CAPTION",                           12, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1002, "CAP_FEEDERENABLED",                      6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1003, "CAP_FEEDERLOADED",                       6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1004, "CAP_TIMEDATE",                           9, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1005, "CAP_SUPPORTEDCAPS",                      4, {   8,   8,   8,   0,   0,   0,  32 } },
+                    { 0x1006, "CAP_EXTENDEDCAPS",                       4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x1007, "CAP_AUTOFEED",                           6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1008, "CAP_CLEARPAGE",                          6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1009, "CAP_FEEDPAGE",                           6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x100A, "CAP_REWINDPAGE",                         6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x100B, "CAP_INDICATORS",                         6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x100C, "CAP_SUPPORTEDCAPSEXT",                   6, {   8,   8,   8,   0,   0,   0,  32 } },
+                    { 0x100D, "CAP_PAPERDETECTABLE",                    6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x100E, "CAP_UICONTROLLABLE",                     6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x100F, "CAP_DEVICEONLINE",                       6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1010, "CAP_AUTOSCAN",                           6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1011, "CAP_THUMBNAILSENABLED",                  6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1012, "CAP_DUPLEX",                             4, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1013, "CAP_DUPLEXENABLED",                      6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1014, "CAP_ENABLEDSUIONLY",                     6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1015, "CAP_CUSTOMDSDATA",                       6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1016, "CAP_ENDORSER",                           5, {  96,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1017, "CAP_JOBCONTROL",                         4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1018, "CAP_ALARMS",                             4, {   8,   8,   8,  40,   8,  40,  32 } },
+                    { 0x1019, "CAP_ALARMVOLUME",                        2, {  96,  32,  32,  32,  96,  32,  32 } },
+                    { 0x101A, "CAP_AUTOMATICCAPTURE",                   2, {  96,  32,  32,  32,  96,  32,  32 } },
+                    { 0x101B, "CAP_TIMEBEFOREFIRSTCAPTURE",             2, {  96,  32,  32,  32,  96,  32,  32 } },
+                    { 0x101C, "CAP_TIMEBETWEENCAPTURES",                2, {  96,  32,  32,  32,  96,  32,  32 } },
+                    { 0x101D, "CAP_CLEARBUFFERS",                       4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x101E, "CAP_MAXBATCHBUFFERS",                    5, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x101F, "CAP_DEVICETIMEDATE",                     9, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1020, "CAP_POWERSUPPLY",                        4, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1021, "CAP_CAMERAPREVIEWUI",                    6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1022, "CAP_DEVICEEVENT",                        4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x1024, "CAP_SERIALNUMBER",                      12, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1026, "CAP_PRINTER",                            4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1027, "CAP_PRINTERENABLED",                     6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1028, "CAP_PRINTERINDEX",                       5, {  96,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1029, "CAP_PRINTERMODE",                        4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x102A, "CAP_PRINTERSTRING",                     12, {  48,  32,  32,  32,  32,  32,  32 } },
+                    { 0x102B, "CAP_PRINTERSUFFIX",                     12, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x102C, "CAP_LANGUAGE",                           4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x102D, "CAP_FEEDERALIGNMENT",                    4, {  48,  32,  32,  32,  32,  32,  32 } },
+                    { 0x102E, "CAP_FEEDERORDER",                        4, {  48,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1030, "CAP_REACQUIREALLOWED",                   6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1032, "CAP_BATTERYMINUTES",                     2, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1033, "CAP_BATTERYPERCENTAGE",                  2, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1034, "CAP_CAMERASIDE",                         4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1035, "CAP_SEGMENTED",                          4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1036, "CAP_CAMERAENABLED",                      6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1037, "CAP_CAMERAORDER",                        4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x1038, "CAP_MICRENABLED",                        6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1039, "CAP_FEEDERPREP",                         6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x103A, "CAP_FEEDERPOCKET",                       4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x103B, "CAP_AUTOMATICSENSEMEDIUM",               6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x103C, "CAP_CUSTOMINTERFACEGUID",               12, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x103D, "CAP_SUPPORTEDCAPSSEGMENTUNIQUE",         4, {   8,   8,   8,   0,   0,   0,  32 } },
+                    { 0x103E, "CAP_SUPPORTEDDATS",                      5, {   8,   8,   8,   0,   0,   0,  32 } },
+                    { 0x103F, "CAP_DOUBLEFEEDDETECTION",                4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x1040, "CAP_DOUBLEFEEDDETECTIONLENGTH",          7, {  64,  32,  32,  32,  96,  32,  32 } },
+                    { 0x1041, "CAP_DOUBLEFEEDDETECTIONSENSITIVITY",     4, {  16,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1042, "CAP_DOUBLEFEEDDETECTIONRESPONSE",        4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x1043, "CAP_PAPERHANDLING",                      4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x1044, "CAP_INDICATORSMODE",                     4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x1045, "CAP_PRINTERVERTICALOFFSET",              7, {  96,  32,  32,  32,  96,  32,  32 } },
+                    { 0x1046, "CAP_POWERSAVETIME",                      1, {  96,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1047, "CAP_PRINTERCHARROTATION",                5, { 112,  32,  32, 112, 112,  32,  32 } },
+                    { 0x1048, "CAP_PRINTERFONTSTYLE",                   4, {   8,   8,   8,   8,   8,   8,  32 } },
+                    { 0x1049, "CAP_PRINTERINDEXLEADCHAR",               9, {  48,  32,  32,  48,  48,  32,  32 } },
+                    { 0x104A, "CAP_PRINTERINDEXMAXVALUE",               5, { 112,  32,  32, 112, 112,  32,  32 } },
+                    { 0x104B, "CAP_PRINTERINDEXNUMDIGITS",              5, { 112,  32,  32, 112, 112,  32,  32 } },
+                    { 0x104C, "CAP_PRINTERINDEXSTEP",                   5, { 112,  32,  32, 112, 112,  32,  32 } },
+                    { 0x104D, "CAP_PRINTERINDEXTRIGGER",                4, {   8,   8,   8,   8,   8,   8,  32 } },
+                    { 0x104E, "CAP_PRINTERSTRINGPREVIEW",              12, {   8,   8,   8,   0,   0,   0,  32 } },
+                    { 0x104F, "CAP_SHEETCOUNT",                         5, {  96,  32,  32,  96,  64,  32,  32 } },
+                    { 0x1050, "CAP_IMAGEADDRESSENABLED",                6, {  48,  32,  32,  48,  48,  32,  32 } },
+                    { 0x1051, "CAP_IAFIELDA_LEVEL",                     4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1052, "CAP_IAFIELDB_LEVEL",                     4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1053, "CAP_IAFIELDC_LEVEL",                     4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1054, "CAP_IAFIELDD_LEVEL",                     4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1055, "CAP_IAFIELDE_LEVEL",                     4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1056, "CAP_IAFIELDA_PRINTFORMAT",               9, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1057, "CAP_IAFIELDB_PRINTFORMAT",               9, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1058, "CAP_IAFIELDC_PRINTFORMAT",               9, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1059, "CAP_IAFIELDD_PRINTFORMAT",               9, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x105A, "CAP_IAFIELDE_PRINTFORMAT",               9, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x105B, "CAP_IAFIELDA_VALUE",                     4, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x105C, "CAP_IAFIELDB_VALUE",                     4, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x105D, "CAP_IAFIELDC_VALUE",                     4, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x105E, "CAP_IAFIELDD_VALUE",                     4, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x105F, "CAP_IAFIELDE_VALUE",                     4, {  32,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1060, "CAP_IAFIELDA_LASTPAGE",                  4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1061, "CAP_IAFIELDB_LASTPAGE",                  4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1062, "CAP_IAFIELDC_LASTPAGE",                  4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1063, "CAP_IAFIELDD_LASTPAGE",                  4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1064, "CAP_IAFIELDE_LASTPAGE",                  4, {  16,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1100, "ICAP_AUTOBRIGHT",                        6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1101, "ICAP_BRIGHTNESS",                        7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1103, "ICAP_CONTRAST",                          7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1104, "ICAP_CUSTHALFTONE",                      3, {   8,   8,   8,  40,   8,   8,  32 } },
+                    { 0x1105, "ICAP_EXPOSURETIME",                      7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1106, "ICAP_FILTER",                            4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1107, "ICAP_FLASHUSED",                         6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1108, "ICAP_GAMMA",                             7, {  96,  32,  32,  32,  32,  32,  32 } },
+                    { 0x1109, "ICAP_HALFTONES",                         9, {  48,  32,  32,  16,  48,  32,  32 } },
+                    { 0x110A, "ICAP_HIGHLIGHT",                         7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x110C, "ICAP_IMAGEFILEFORMAT",                   4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x110D, "ICAP_LAMPSTATE",                         6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x110E, "ICAP_LIGHTSOURCE",                       4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1110, "ICAP_ORIENTATION",                       4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1111, "ICAP_PHYSICALWIDTH",                     7, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1112, "ICAP_PHYSICALHEIGHT",                    7, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1113, "ICAP_SHADOW",                            7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1114, "ICAP_FRAMES",                            8, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1116, "ICAP_XNATIVERESOLUTION",                 7, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1117, "ICAP_YNATIVERESOLUTION",                 7, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1118, "ICAP_XRESOLUTION",                       7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1119, "ICAP_YRESOLUTION",                       7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x111A, "ICAP_MAXFRAMES",                         4, {  96,  32,  32,  32,  32,  32,  32 } },
+                    { 0x111B, "ICAP_TILES",                             6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x111C, "ICAP_BITORDER",                          4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x111D, "ICAP_CCITTKFACTOR",                      4, {  96,  32,  32,  32,  32,  32,  32 } },
+                    { 0x111E, "ICAP_LIGHTPATH",                         4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x111F, "ICAP_PIXELFLAVOR",                       4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1120, "ICAP_PLANARCHUNKY",                      4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1121, "ICAP_ROTATION",                          7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1122, "ICAP_SUPPORTEDSIZES",                    4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1123, "ICAP_THRESHOLD",                         7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1124, "ICAP_XSCALING",                          7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1125, "ICAP_YSCALING",                          7, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1126, "ICAP_BITORDERCODES",                     4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1127, "ICAP_PIXELFLAVORCODES",                  4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1128, "ICAP_JPEGPIXELTYPE",                     4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x112A, "ICAP_TIMEFILL",                          4, {  96,  32,  32,  32,  96,  32,  32 } },
+                    { 0x112B, "ICAP_BITDEPTH",                          4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x112C, "ICAP_BITDEPTHREDUCTION",                 4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x112D, "ICAP_UNDEFINEDIMAGESIZE",                6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x112E, "ICAP_IMAGEDATASET",                      5, { 104,   8,   8, 104, 104,   8,  32 } },
+                    { 0x112F, "ICAP_EXTIMAGEINFO",                      6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1130, "ICAP_MINIMUMHEIGHT",                     7, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1131, "ICAP_MINIMUMWIDTH",                      7, {  32,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1134, "ICAP_AUTODISCARDBLANKPAGES",             2, {  96,  32,  32,  32,  96,  32,  32 } },
+                    { 0x1136, "ICAP_FLIPROTATION",                      4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1137, "ICAP_BARCODEDETECTIONENABLED",           6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1138, "ICAP_SUPPORTEDBARCODETYPES",             4, {   8,   8,   8,   0,   0,   0,  32 } },
+                    { 0x1139, "ICAP_BARCODEMAXSEARCHPRIORITIES",        5, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x113A, "ICAP_BARCODESEARCHPRIORITIES",           4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x113B, "ICAP_BARCODESEARCHMODE",                 4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x113C, "ICAP_BARCODEMAXRETRIES",                 5, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x113D, "ICAP_BARCODETIMEOUT",                    5, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x113E, "ICAP_ZOOMFACTOR",                        1, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x113F, "ICAP_PATCHCODEDETECTIONENABLED",         6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1140, "ICAP_SUPPORTEDPATCHCODETYPES",           4, {   8,   8,   8,   0,   0,   0,  32 } },
+                    { 0x1141, "ICAP_PATCHCODEMAXSEARCHPRIORITIES",      5, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1142, "ICAP_PATCHCODESEARCHPRIORITIES",         4, {   8,   8,   8,  40,  40,   8,  32 } },
+                    { 0x1143, "ICAP_PATCHCODESEARCHMODE",               4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1144, "ICAP_PATCHCODEMAXRETRIES",               5, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1145, "ICAP_PATCHCODETIMEOUT",                  5, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1146, "ICAP_FLASHUSED2",                        4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1147, "ICAP_IMAGEFILTER",                       4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1148, "ICAP_NOISEFILTER",                       4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1149, "ICAP_OVERSCAN",                          4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1150, "ICAP_AUTOMATICBORDERDETECTION",          6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1151, "ICAP_AUTOMATICDESKEW",                   6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1152, "ICAP_AUTOMATICROTATE",                   6, {  48,  32,  32,  32,  49,  32,  32 } },
+                    { 0x1153, "ICAP_JPEGQUALITY",                       1, { 112,  32,  32,  32, 112,  32,  32 } },
+                    { 0x1154, "ICAP_FEEDERTYPE",                        4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1155, "ICAP_ICCPROFILE",                        4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1156, "ICAP_AUTOSIZE",                          4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1157, "ICAP_AUTOMATICCROPUSESFRAME",            6, {  48,  32,  32,   0,   0,   0,  32 } },
+                    { 0x1158, "ICAP_AUTOMATICLENGTHDETECTION",          6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1159, "ICAP_AUTOMATICCOLORENABLED",             6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x115A, "ICAP_AUTOMATICCOLORNONCOLORPIXELTYPE",   4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x115B, "ICAP_COLORMANAGEMENTENABLED",            6, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x115C, "ICAP_IMAGEMERGE",                        4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x115D, "ICAP_IMAGEMERGEHEIGHTTHRESHOLD",         7, {  96,  32,  32,  32,  96,  32,  32 } },
+                    { 0x115E, "ICAP_SUPPORTEDEXTIMAGEINFO",             4, {   8,   8,   8,   0,   0,   0,  32 } },
+                    { 0x115F, "ICAP_FILMTYPE",                          4, {  16,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1160, "ICAP_MIRROR",                            4, {  16,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1161, "ICAP_JPEGSUBSAMPLING",                   4, {  16,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1201, "ACAP_AUDIOFILEFORMAT",                   4, {  48,  32,  32,  32,  48,  32,  32 } },
+                    { 0x1202, "ACAP_XFERMECH",                          4, {  48,  32,  32,  32,  48,  32,  32 } }
+                };
+
+                constexpr bool is_sorted() noexcept
+                {
+                    for (std::size_t i = 1; i < std::size(entries); ++i)
+                    {
+                        if (entries[i - 1].cap_value >= entries[i].cap_value)
+                            return false;
+                    }
+                    return true;
+                }
+                static_assert(is_sorted(), "The capability metadata must be sorted by capability value");
+            }
+
+            /// Returns the metadata for the capability **capvalue**, or nullptr if **capvalue** is not a standard
+            /// capability (for example, a custom capability).
+            ///
+            /// The table is built at compile time, so this does not lock, allocate or call the DTWAIN library.
+            constexpr const capability_metadata* find(int32_t capvalue) noexcept
+            {
+                std::size_t lo = 0;
+                std::size_t hi = std::size(details::entries);
+                while (lo < hi)
+                {
+                    const std::size_t mid = lo + (hi - lo) / 2;
+                    if (details::entries[mid].cap_value < capvalue)
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+                return lo < std::size(details::entries) && details::entries[lo].cap_value == capvalue ? &details::entries[lo] : nullptr;
+            }
+
+            constexpr std::size_t size() noexcept { return std::size(details::entries); }
+        }
+    }
+}
+#endif
@@ -0,0 +1,404 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_CAPABILITY_SET_PLANNER_HPP
+#define DTWAIN_CAPABILITY_SET_PLANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "twain.h"
+#include <dynarithmic/twain/capability_interface/capability_metadata.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// A capability (the **dependent**) whose allowed or current values may change when another capability (the
+        /// **prerequisite**) is set.  For example, setting ICAP_UNITS changes the meaning of the resolution and frame
+        /// values, so ICAP_UNITS must be set first.
+        struct capability_dependency
+        {
+            int32_t prerequisite;
+            int32_t dependent;
+        };
+
+        namespace capability_dependency_table
+        {
+            namespace details
+            {
+                inline constexpr capability_dependency entries[] = {
+                    { ICAP_UNITS, ICAP_XRESOLUTION },
+                    { ICAP_UNITS, ICAP_YRESOLUTION },
+                    { ICAP_UNITS, ICAP_FRAMES },
+                    { ICAP_SUPPORTEDSIZES, ICAP_FRAMES },
+                    { ICAP_ORIENTATION, ICAP_FRAMES },
+                    { ICAP_XFERMECH, ICAP_PIXELTYPE },
+                    { ICAP_XFERMECH, ICAP_COMPRESSION },
+                    { ICAP_PIXELTYPE, ICAP_BITDEPTH },
+                    { ICAP_PIXELTYPE, ICAP_BITDEPTHREDUCTION },
+                    { ICAP_PIXELTYPE, ICAP_THRESHOLD },
+                    { ICAP_PIXELTYPE, ICAP_HALFTONES },
+                    { ICAP_PIXELTYPE, ICAP_CUSTHALFTONE },
+                    { ICAP_PIXELTYPE, ICAP_PIXELFLAVOR },
+                    { ICAP_PIXELTYPE, ICAP_COMPRESSION },
+                    { ICAP_PIXELTYPE, ICAP_JPEGPIXELTYPE },
+                    { ICAP_BITDEPTH, ICAP_BITDEPTHREDUCTION },
+                    { ICAP_BITDEPTHREDUCTION, ICAP_THRESHOLD },
+                    { ICAP_BITDEPTHREDUCTION, ICAP_HALFTONES },
+                    { ICAP_BITDEPTHREDUCTION, ICAP_CUSTHALFTONE },
+                    { ICAP_COMPRESSION, ICAP_JPEGQUALITY },
+                    { ICAP_COMPRESSION, ICAP_JPEGPIXELTYPE },
+                    { ICAP_COMPRESSION, ICAP_JPEGSUBSAMPLING },
+                    { ICAP_COMPRESSION, ICAP_CCITTKFACTOR },
+                    { ICAP_COMPRESSION, ICAP_BITORDERCODES },
+                    { ICAP_COMPRESSION, ICAP_PIXELFLAVORCODES },
+                    { ICAP_COMPRESSION, ICAP_TIMEFILL },
+                    { ICAP_AUTOBRIGHT, ICAP_BRIGHTNESS },
+                    { ICAP_LIGHTPATH, ICAP_FILMTYPE },
+                    { ICAP_UNDEFINEDIMAGESIZE, ICAP_AUTOMATICBORDERDETECTION },
+                    { ICAP_AUTOMATICCOLORENABLED, ICAP_AUTOMATICCOLORNONCOLORPIXELTYPE },
+                    { ICAP_BARCODEDETECTIONENABLED, ICAP_BARCODESEARCHPRIORITIES },
+                    { ICAP_BARCODEDETECTIONENABLED, ICAP_BARCODESEARCHMODE },
+                    { ICAP_BARCODEDETECTIONENABLED, ICAP_BARCODEMAXRETRIES },
+                    { ICAP_BARCODEDETECTIONENABLED, ICAP_BARCODETIMEOUT },
+                    { ICAP_PATCHCODEDETECTIONENABLED, ICAP_PATCHCODESEARCHPRIORITIES },
+                    { ICAP_PATCHCODEDETECTIONENABLED, ICAP_PATCHCODESEARCHMODE },
+                    { ICAP_PATCHCODEDETECTIONENABLED, ICAP_PATCHCODEMAXRETRIES },
+                    { ICAP_PATCHCODEDETECTIONENABLED, ICAP_PATCHCODETIMEOUT },
+                    { CAP_FEEDERENABLED, CAP_AUTOFEED },
+                    { CAP_FEEDERENABLED, CAP_AUTOSCAN },
+                    { CAP_FEEDERENABLED, CAP_DUPLEXENABLED },
+                    { CAP_FEEDERENABLED, CAP_FEEDERPREP },
+                    { CAP_FEEDERENABLED, CAP_FEEDERORDER },
+                    { CAP_FEEDERENABLED, CAP_FEEDERPOCKET },
+                    { CAP_FEEDERENABLED, ICAP_FEEDERTYPE },
+                    { CAP_FEEDERENABLED, CAP_PAPERHANDLING },
+                    { CAP_DOUBLEFEEDDETECTION, CAP_DOUBLEFEEDDETECTIONLENGTH },
+                    { CAP_DOUBLEFEEDDETECTION, CAP_DOUBLEFEEDDETECTIONSENSITIVITY },
+                    { CAP_DOUBLEFEEDDETECTION, CAP_DOUBLEFEEDDETECTIONRESPONSE },
+                    { CAP_AUTOMATICCAPTURE, CAP_TIMEBEFOREFIRSTCAPTURE },
+                    { CAP_AUTOMATICCAPTURE, CAP_TIMEBETWEENCAPTURES },
+                    { CAP_PRINTER, CAP_PRINTERENABLED },
+                    { CAP_PRINTER, CAP_PRINTERMODE },
+                    { CAP_PRINTER, CAP_PRINTERSTRING },
+                    { CAP_PRINTER, CAP_PRINTERSUFFIX },
+                    { CAP_PRINTER, CAP_PRINTERINDEX },
+                    { CAP_PRINTER, CAP_PRINTERINDEXLEADCHAR },
+                    { CAP_PRINTER, CAP_PRINTERINDEXMAXVALUE },
+                    { CAP_PRINTER, CAP_PRINTERINDEXNUMDIGITS },
+                    { CAP_PRINTER, CAP_PRINTERINDEXSTEP },
+                    { CAP_PRINTER, CAP_PRINTERINDEXTRIGGER },
+                    { CAP_PRINTER, CAP_PRINTERCHARROTATION },
+                    { CAP_PRINTER, CAP_PRINTERFONTSTYLE },
+                    { CAP_PRINTER, CAP_PRINTERVERTICALOFFSET }
+                };
+
+                // A capability can only be set after its prerequisites, so the table must not contain a cycle
+                constexpr bool depends_on(int32_t dependent, int32_t prerequisite, std::size_t depth = 0) noexcept
+                {
+                    if (depth > std::size(entries))
+                        return true;
+                    for (auto& entry : entries)
+                    {
+                        if (entry.prerequisite == prerequisite &&
+                            (entry.dependent == dependent || depends_on(dependent, entry.dependent, depth + 1)))
+                            return true;
+                    }
+                    return false;
+                }
+
+                constexpr bool is_acyclic() noexcept
+                {
+                    for (auto& entry : entries)
+                    {
+                        if (depends_on(entry.prerequisite, entry.dependent))
+                            return false;
+                    }
+                    return true;
+                }
+                static_assert(is_acyclic(), "The capability dependency table must not contain a cycle");
+            }
+
+            /// Returns true if setting **prerequisite** can change **dependent**, either directly or through other
+            /// capabilities (for example, ICAP_PIXELTYPE changes ICAP_THRESHOLD through ICAP_BITDEPTHREDUCTION).
+            constexpr bool depends_on(int32_t dependent, int32_t prerequisite) noexcept
+            {
+                return details::depends_on(dependent, prerequisite);
+            }
+
+            /// Returns true if another capability must be set before **dependent** (for example, ICAP_XRESOLUTION depends on
+            /// ICAP_UNITS), so whether a value of **dependent** is valid depends on the values of other capabilities.
+            constexpr bool has_prerequisite(int32_t dependent) noexcept
+            {
+                for (auto& entry : details::entries)
+                {
+                    if (entry.dependent == dependent)
+                        return true;
+                }
+                return false;
+            }
+
+            constexpr std::size_t size() noexcept { return std::size(details::entries); }
+        }
+
+        /// Collects capability sets, then sends them to the device in dependency order.
+        ///
+        /// The sets are sent in the order they were added, except that a capability is always set after the capabilities
+        /// it depends on (see capability_dependency_table).  When a capability is set more than once with the same
+        /// operation, only the last set is sent.  After all the sets are sent, only the capabilities that another set in
+        /// the plan could have changed are read back.  If one of these no longer has the value that was set, it is set
+        /// again once.  A set that is marked as unchanged (the device already has the value) is only sent if a set of one
+        /// of its prerequisites was sent before it.
+        ///
+        /// The capability_interface creates and runs a plan between capability_interface::begin_set_plan() and
+        /// capability_interface::end_set_plan().
+        class capability_set_plan
+        {
+            public:
+                /// Sends the set to the device.  Returns whether the set succeeded, and the error if it failed.
+                using apply_function = std::function<std::pair<bool, int32_t>()>;
+
+                /// Returns false if the current value of the capability does not match the value that was set
+                using verify_function = std::function<bool()>;
+
+                /// Describes what happened when the plan was run
+                struct report
+                {
+                    std::vector<int32_t> order;         // the capabilities, in the order they were set
+                    std::vector<int32_t> redundant;     // sets that were not sent, since a later set replaced them
+                    std::vector<int32_t> unchanged;     // sets that were not sent, since the device already had the value
+                    std::vector<int32_t> retried;       // sets whose value did not hold, and were sent again
+                    std::vector<int32_t> changed;       // sets whose value did not hold, even after being sent again
+                    std::vector<std::pair<int32_t, int32_t>> failed;  // sets the device rejected, and the error
+                    std::size_t verified = 0;           // the number of current values read back
+                    bool reordered = false;             // true if the sets were not sent in the order they were added
+
+                    bool empty() const { return order.empty() && redundant.empty() && unchanged.empty(); }
+
+                    std::string to_string() const
+                    {
+                        const auto get_name = [](int32_t capvalue)
+                        {
+                            if (const auto* meta = capability_metadata_table::find(capvalue))
+                                return std::string(meta->name);
+                            return std::to_string(capvalue);
+                        };
+                        const auto write_list = [&](std::ostringstream& strm, const char* title, const std::vector<int32_t>& caps)
+                        {
+                            strm << title << " (" << caps.size() << "):";
+                            for (auto cap : caps)
+                                strm << " " << get_name(cap);
+                            strm << "\n";
+                        };
+
+                        std::ostringstream strm;
+                        write_list(strm, reordered ? "Set order (reordered)" : "Set order", order);
+                        if (!redundant.empty())
+                            write_list(strm, "Redundant", redundant);
+                        if (!unchanged.empty())
+                            write_list(strm, "Unchanged", unchanged);
+                        strm << "Verified: " << verified << "\n";
+                        if (!retried.empty())
+                            write_list(strm, "Retried", retried);
+                        if (!changed.empty())
+                            write_list(strm, "Changed by device", changed);
+                        if (!failed.empty())
+                        {
+                            strm << "Failed (" << failed.size() << "):";
+                            for (auto& f : failed)
+                                strm << " " << get_name(f.first) << "[" << f.second << "]";
+                            strm << "\n";
+                        }
+                        return strm.str();
+                    }
+                };
+
+            private:
+                struct set_request
+                {
+                    int32_t cap_value;
+                    long operation;
+                    apply_function apply;
+                    verify_function verify;
+                    bool unchanged = false;
+                    bool succeeded = false;
+                };
+
+                std::vector<set_request> m_requests;
+
+                // Removes the sets that are followed by a set of the same capability using the same operation.  A set
+                // followed by a different operation (for example, a reset followed by a set) is kept.
+                void remove_redundant(report& rpt)
+                {
+                    std::vector<set_request> vKept;
+                    vKept.reserve(m_requests.size());
+                    for (std::size_t i = 0; i < m_requests.size(); ++i)
+                    {
+                        bool bRedundant = false;
+                        for (std::size_t j = i + 1; j < m_requests.size(); ++j)
+                        {
+                            if (m_requests[j].cap_value == m_requests[i].cap_value)
+                            {
+                                bRedundant = m_requests[j].operation == m_requests[i].operation;
+                                break;
+                            }
+                        }
+                        if (bRedundant)
+                            rpt.redundant.push_back(m_requests[i].cap_value);
+                        else
+                            vKept.push_back(std::move(m_requests[i]));
+                    }
+                    m_requests.swap(vKept);
+                }
+
+                // Orders the sets so that each capability is set after its prerequisites.  Otherwise the sets keep the
+                // order in which they were added.
+                void sort_by_dependency(report& rpt)
+                {
+                    const std::size_t count = m_requests.size();
+                    std::vector<std::vector<bool>> vMustPrecede(count, std::vector<bool>(count));
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        for (std::size_t j = 0; j < count; ++j)
+                        {
+                            if (i == j)
+                                continue;
+                            const int32_t capI = m_requests[i].cap_value;
+                            const int32_t capJ = m_requests[j].cap_value;
+                            vMustPrecede[i][j] = capI == capJ ? i < j : capability_dependency_table::depends_on(capJ, capI);
+                        }
+                    }
+
+                    std::vector<bool> vDone(count);
+                    std::vector<std::size_t> vOrder;
+                    vOrder.reserve(count);
+                    while (vOrder.size() < count)
+                    {
+                        std::size_t next = count;
+                        for (std::size_t j = 0; j < count && next == count; ++j)
+                        {
+                            if (vDone[j])
+                                continue;
+                            bool bReady = true;
+                            for (std::size_t i = 0; i < count && bReady; ++i)
+                                bReady = vDone[i] || !vMustPrecede[i][j];
+                            if (bReady)
+                                next = j;
+                        }
+
+                        // cannot happen with an acyclic table, but keep the original order if it does
+                        if (next == count)
+                        {
+                            next = 0;
+                            while (vDone[next])
+                                ++next;
+                        }
+                        vDone[next] = true;
+                        vOrder.push_back(next);
+                    }
+
+                    std::vector<set_request> vSorted;
+                    vSorted.reserve(count);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        rpt.reordered = rpt.reordered || vOrder[i] != i;
+                        vSorted.push_back(std::move(m_requests[vOrder[i]]));
+                    }
+                    m_requests.swap(vSorted);
+                }
+
+                // Returns true if a set that succeeded before position **pos** could have changed the capability at **pos**
+                bool is_affected(std::size_t pos) const
+                {
+                    for (std::size_t i = 0; i < pos; ++i)
+                    {
+                        if (m_requests[i].succeeded &&
+                            capability_dependency_table::depends_on(m_requests[pos].cap_value, m_requests[i].cap_value))
+                            return true;
+                    }
+                    return false;
+                }
+
+            public:
+                /// Adds a set to the plan
+                ///
+                /// @param[in] capvalue The capability being set
+                /// @param[in] operation The set operation.  A set is only replaced by a later set that uses the same operation.
+                /// @param[in] apply Sends the set to the device
+                /// @param[in] verify Compares the current value with the value that was set.  If empty, the set is not verified.
+                /// @param[in] unchanged true if the device already has the value, so the set is only needed if a prerequisite
+                /// is set first.
+                void add(int32_t capvalue, long operation, apply_function apply, verify_function verify = {}, bool unchanged = false)
+                {
+                    m_requests.push_back({ capvalue, operation, std::move(apply), std::move(verify), unchanged });
+                }
+
+                std::size_t size() const { return m_requests.size(); }
+                bool empty() const { return m_requests.empty(); }
+
+                /// Sends the sets to the device, then verifies and retries the sets that another set could have changed
+                report run()
+                {
+                    report rpt;
+                    remove_redundant(rpt);
+                    sort_by_dependency(rpt);
+
+                    rpt.order.reserve(m_requests.size());
+                    for (std::size_t i = 0; i < m_requests.size(); ++i)
+                    {
+                        auto& request = m_requests[i];
+                        if (request.unchanged && !is_affected(i))
+                        {
+                            rpt.unchanged.push_back(request.cap_value);
+                            continue;
+                        }
+                        rpt.order.push_back(request.cap_value);
+                        const auto result = request.apply();
+                        request.succeeded = result.first;
+                        if (!result.first)
+                            rpt.failed.push_back({ request.cap_value, result.second });
+                    }
+
+                    for (std::size_t i = 0; i < m_requests.size(); ++i)
+                    {
+                        auto& request = m_requests[i];
+                        if (!request.succeeded || !request.verify || !is_affected(i))
+                            continue;
+                        ++rpt.verified;
+                        if (request.verify())
+                            continue;
+                        if (request.apply().first && request.verify())
+                            rpt.retried.push_back(request.cap_value);
+                        else
+                            rpt.changed.push_back(request.cap_value);
+                    }
+                    m_requests.clear();
+                    return rpt;
+                }
+        };
+    }
+}
+#endif
@@ -0,0 +1,126 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_CAPABILITY_SNAPSHOT_HPP
+#define DTWAIN_CAPABILITY_SNAPSHOT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        class capability_interface;
+
+        /// The values of a set of capabilities, read from a device in one pass by capability_interface::snapshot().
+        ///
+        /// A snapshot does not change once it is taken, and reading from it does not communicate with the device.
+        class capability_snapshot
+        {
+            public:
+                struct entry
+                {
+                    int cap_value = 0;
+                    bool supported = false;         // the device lists the capability in CAP_SUPPORTEDCAPS
+                    bool values_read = false;       // the supported values were retrieved
+                    bool current_read = false;      // the current values were retrieved
+                    int32_t error_code = 0;         // error from the last failed retrieval, or 0
+                    long data_type = -1;            // TWTY_xxx
+
+                    // The values are kept in one of these, depending on the data type
+                    std::vector<long> long_values;
+                    std::vector<double> double_values;
+                    std::vector<std::string> string_values;
+                    std::vector<long> long_current;
+                    std::vector<double> double_current;
+                    std::vector<std::string> string_current;
+                };
+
+            private:
+                friend class capability_interface;
+                std::vector<entry> m_entries;   // sorted by capability value
+
+                template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, bool>::type = 1>
+                static std::vector<T> convert(const std::vector<long>& vLong, const std::vector<double>& vDouble,
+                                              const std::vector<std::string>&)
+                {
+                    std::vector<T> ret;
+                    if (!vDouble.empty())
+                        std::transform(vDouble.begin(), vDouble.end(), std::back_inserter(ret), [](double d) { return static_cast<T>(d); });
+                    else
+                        std::transform(vLong.begin(), vLong.end(), std::back_inserter(ret), [](long l) { return static_cast<T>(l); });
+                    return ret;
+                }
+
+                template <typename T, typename std::enable_if<std::is_same<T, std::string>::value, bool>::type = 1>
+                static std::vector<T> convert(const std::vector<long>&, const std::vector<double>&,
+                                              const std::vector<std::string>& vString)
+                {
+                    return vString;
+                }
+
+            public:
+                /// Returns the entry for capability **capvalue**, or nullptr if it is not part of the snapshot
+                const entry* find(int capvalue) const
+                {
+                    auto iter = std::lower_bound(m_entries.begin(), m_entries.end(), capvalue,
+                                                 [](const entry& e, int cap) { return e.cap_value < cap; });
+                    if (iter != m_entries.end() && iter->cap_value == capvalue)
+                        return &*iter;
+                    return nullptr;
+                }
+
+                bool is_cap_supported(int capvalue) const
+                {
+                    auto pEntry = find(capvalue);
+                    return pEntry && pEntry->supported;
+                }
+
+                /// Returns the values the device supports for **capvalue** (MSG_GET), converted to T.  For a range, these
+                /// are the minimum, maximum, step, default and current values.
+                template <typename T>
+                std::vector<T> get_values(int capvalue) const
+                {
+                    auto pEntry = find(capvalue);
+                    if (!pEntry)
+                        return {};
+                    return convert<T>(pEntry->long_values, pEntry->double_values, pEntry->string_values);
+                }
+
+                /// Returns the current values of **capvalue** (MSG_GETCURRENT), converted to T
+                template <typename T>
+                std::vector<T> get_current_values(int capvalue) const
+                {
+                    auto pEntry = find(capvalue);
+                    if (!pEntry)
+                        return {};
+                    return convert<T>(pEntry->long_current, pEntry->double_current, pEntry->string_current);
+                }
+
+                const std::vector<entry>& get_entries() const { return m_entries; }
+        };
+    }
+}
+#endif
@@ -0,0 +1,149 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_CAPABILITY_STATISTICS_LISTENER_HPP
+#define DTWAIN_CAPABILITY_STATISTICS_LISTENER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dynarithmic/twain/capability_interface/capability_interface.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// A capability_listener that keeps the number of calls, failures and time spent for each capability.
+        ///
+        /// Use this to find the capabilities that make a device slow to negotiate:
+        /// \code
+        /// twain_source& source = ...;
+        /// source.set_cap_listener(std::make_unique<capability_statistics_listener>());
+        /// // ... open the source, set the acquire characteristics and acquire ...
+        /// auto& stats = static_cast<capability_statistics_listener&>(source.get_cap_listener());
+        /// std::cout << stats.get_report();
+        /// \endcode
+        class capability_statistics_listener : public capability_listener
+        {
+            public:
+                struct cap_statistics
+                {
+                    uint64_t get_count = 0;         // gets sent to the device
+                    uint64_t get_failures = 0;
+                    uint64_t cache_hits = 0;        // gets satisfied from the capability cache
+                    uint64_t set_count = 0;
+                    uint64_t set_failures = 0;
+                    std::chrono::nanoseconds get_time{};
+                    std::chrono::nanoseconds set_time{};
+                    std::chrono::nanoseconds max_time{};
+                    std::chrono::nanoseconds total_time() const { return get_time + set_time; }
+                };
+
+                using statistics_map = std::map<int, cap_statistics>;
+
+            private:
+                mutable std::mutex m_mutex;
+                statistics_map m_statistics;
+
+            public:
+                void capvaluegetresult(twain_source&, int capvalue, const capability_interface::getcap_operation_info&,
+                                       const result_info& info) override
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto& stats = m_statistics[capvalue];
+                    if (info.from_cache)
+                    {
+                        ++stats.cache_hits;
+                        return;
+                    }
+                    ++stats.get_count;
+                    if (!info.success)
+                        ++stats.get_failures;
+                    stats.get_time += info.elapsed;
+                    stats.max_time = (std::max)(stats.max_time, info.elapsed);
+                }
+
+                void capvaluesetresult(twain_source&, int capvalue, const capability_interface::setcap_operation_info&,
+                                       const result_info& info) override
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto& stats = m_statistics[capvalue];
+                    ++stats.set_count;
+                    if (!info.success)
+                        ++stats.set_failures;
+                    stats.set_time += info.elapsed;
+                    stats.max_time = (std::max)(stats.max_time, info.elapsed);
+                }
+
+                /// Returns a copy of the statistics, keyed by capability value
+                statistics_map get_statistics() const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_statistics;
+                }
+
+                void reset()
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_statistics.clear();
+                }
+
+                /// Returns a report of the capabilities, sorted by the total time spent getting and setting the capability
+                /// (highest first)
+                ///
+                /// @param[in] maxLines If not 0, the maximum number of capabilities to list.
+                std::string get_report(std::size_t maxLines = 0) const
+                {
+                    std::vector<std::pair<int, cap_statistics>> vLines;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        vLines.assign(m_statistics.begin(), m_statistics.end());
+                    }
+                    std::sort(vLines.begin(), vLines.end(), [](const auto& l, const auto& r)
+                        { return l.second.total_time() > r.second.total_time(); });
+                    if (maxLines > 0 && vLines.size() > maxLines)
+                        vLines.resize(maxLines);
+
+                    const auto ms = [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1000000.0; };
+                    std::ostringstream strm;
+                    strm << std::fixed << std::setprecision(3);
+                    strm << std::left << std::setw(32) << "Capability" << std::right << std::setw(7) << "Gets" << std::setw(7) << "Cached"
+                         << std::setw(7) << "Sets" << std::setw(9) << "Failures" << std::setw(12) << "Get(ms)" << std::setw(12) << "Set(ms)"
+                         << std::setw(12) << "Max(ms)" << "\n";
+                    for (auto& line : vLines)
+                    {
+                        const auto& stats = line.second;
+                        strm << std::left << std::setw(32) << capability_interface::get_cap_name_s(line.first) << std::right
+                             << std::setw(7) << stats.get_count << std::setw(7) << stats.cache_hits << std::setw(7) << stats.set_count
+                             << std::setw(9) << stats.get_failures + stats.set_failures << std::setw(12) << ms(stats.get_time)
+                             << std::setw(12) << ms(stats.set_time) << std::setw(12) << ms(stats.max_time) << "\n";
+                    }
+                    return strm.str();
+                }
+        };
+    }
+}
+#endif
@@ -0,0 +1,97 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_DEVICE_PROFILE_HPP
+#define DTWAIN_DEVICE_PROFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// The capability sets that configured a device for a job, so that a later job with the same options can send
+        /// them again without planning and verifying the sets.
+        ///
+        /// A profile is recorded while twain_source::start_apply() runs (see twain_source::set_device_profile()).  The
+        /// sets are kept in the order they were sent to the device, and the value of each single-value set is replaced
+        /// with the current value the device reports afterwards, so replaying the profile gives the state that was
+        /// verified.  The profile is tied to a device (see capability_failure_store::make_device_key()) and to an
+        /// options key chosen by the application (for example, the options of the job that recorded it).
+        class device_profile
+        {
+            public:
+                struct set_entry
+                {
+                    int32_t cap_value = 0;
+                    long operation = 0;                 // a set_operation_type value
+                    std::vector<std::string> values;    // empty for a reset
+                    bool verified = false;              // the value was read back from the device
+                };
+
+            private:
+                std::string m_device;
+                std::string m_options;
+                std::vector<set_entry> m_sets;
+                bool m_bModified = false;
+
+            public:
+                device_profile() = default;
+                device_profile(std::string device, std::string options) : m_device(std::move(device)), m_options(std::move(options)) {}
+
+                device_profile& set_device(std::string device) { m_device = std::move(device); return *this; }
+                const std::string& get_device() const { return m_device; }
+
+                device_profile& set_options(std::string options) { m_options = std::move(options); return *this; }
+                const std::string& get_options() const { return m_options; }
+
+                const std::vector<set_entry>& get_sets() const { return m_sets; }
+                std::vector<set_entry>& get_sets() { return m_sets; }
+
+                void add(set_entry entry) { m_sets.push_back(std::move(entry)); m_bModified = true; }
+                void clear_sets() { m_sets.clear(); m_bModified = true; }
+                bool empty() const { return m_sets.empty(); }
+                std::size_t size() const { return m_sets.size(); }
+
+                /// Returns true if the profile has sets recorded for **device**
+                bool matches(const std::string& device) const { return !m_sets.empty() && m_device == device; }
+
+                /// Returns true if the profile has sets recorded for **device** and **options**
+                bool matches(const std::string& device, const std::string& options) const
+                {
+                    return matches(device) && m_options == options;
+                }
+
+                /// Returns true if the sets were changed since the profile was loaded or saved
+                bool is_modified() const { return m_bModified; }
+
+                /// Reads the profile from **file**.  Returns false, and leaves the profile empty, if the file cannot be read.
+                bool load(const std::string& file);
+
+                /// Writes the profile to **file**
+                bool save(const std::string& file);
+        };
+    }
+}
+#endif
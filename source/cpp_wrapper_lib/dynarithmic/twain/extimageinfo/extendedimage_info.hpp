@@ -30,6 +30,7 @@ OF THIRD PARTY RIGHTS.
 #else
 #include <dtwain.h>
 #endif
+#include <dynarithmic/twain/types/twain_constant_names.hpp>
 namespace dynarithmic
 {
     namespace twain
@@ -93,6 +94,8 @@ namespace dynarithmic
 
                     std::string get_typename() const
                     {
+                        if (const char* name = twain_constant_names::find(twain_constant_category::TWBT, static_cast<int32_t>(get_type())))
+                            return name;
                         char sz[100] = {};
                         API_INSTANCE DTWAIN_GetTwainNameFromConstantA(DTWAIN_CONSTANT_TWBT, get_type(), sz, 100);
                         return sz;
@@ -31,6 +31,7 @@ OF THIRD PARTY RIGHTS.
 #endif
 
 #include <dynarithmic/twain/dtwain_twain.hpp>
+#include <dynarithmic/twain/utilities/memory_tracker.hpp>
 
 namespace dynarithmic
 {
@@ -61,6 +62,21 @@ namespace dynarithmic
             std::vector<HANDLE> dummy;
             bool m_bAutoDestroy;
 
+            // Removes the bytes of the stored images from the memory_tracker's image store
+            void release_tracked_memory() const
+            {
+                auto& memory = memory_tracker::instance();
+                if (!memory.is_enabled() || !vect_image_handle_ptr)
+                    return;
+                uint64_t bytes = 0;
+                for (auto& vImages : *vect_image_handle_ptr)
+                {
+                    for (auto h : vImages)
+                        bytes += static_cast<uint64_t>(::GlobalSize(h));
+                }
+                memory.release(memory_tracker::pool::image_store, bytes);
+            }
+
         public:
             image_handler(bool containsImages=true) : vect_image_handle_ptr(containsImages ? new images_vector : nullptr),
                                                                        m_bAutoDestroy(false)
@@ -95,7 +111,10 @@ namespace dynarithmic
                 if (!bSet)
                 {
                     if ( vect_image_handle_ptr )
+                    {
+                        release_tracked_memory();
                         vect_image_handle_ptr->clear();
+                    }
                 }
                 return *this;
             }
@@ -203,13 +222,19 @@ namespace dynarithmic
             void push_back_image(HANDLE h)
             {
                 if (vect_image_handle_ptr)
+                {
                     vect_image_handle_ptr->back().push_back(h);
+                    // The DIB now belongs to this handler, so it is no longer counted as a page buffer
+                    memory_tracker::instance().move(memory_tracker::pool::page_buffer, memory_tracker::pool::image_store,
+                                                    h ? static_cast<uint64_t>(::GlobalSize(h)) : 0);
+                }
             }
 
             void destroy_image_handles()
             {
                 if (vect_image_handle_ptr)
                 {
+                    release_tracked_memory();
                     auto iter = vect_image_handle_ptr->begin();
                     while (iter != vect_image_handle_ptr->end())
                     {
@@ -52,6 +52,8 @@ namespace dynarithmic
                 DWORD m_nMinSize, m_nMaxSize, m_nPrefSize;
                 std::unordered_set<compression_value::value_type> all_compression_types;
                 DTWAIN_SOURCE m_twain_source;
+
+                void free_strip();
             
             public:
                 buffered_transfer_info() : m_hStrip(nullptr),
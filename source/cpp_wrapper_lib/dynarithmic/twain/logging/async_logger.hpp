@@ -0,0 +1,362 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_ASYNC_LOGGER_HPP
+#define DTWAIN_ASYNC_LOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dynarithmic/twain/logging/twain_logger.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Logger that moves the cost of writing log messages off of the TWAIN thread.
+        ///
+        /// Messages passed to log() are copied into a fixed-size, lock-free ring buffer (messages longer than
+        /// max_message_size are copied to the heap, and the ring buffer holds the pointer).  A background thread
+        /// drains the ring buffer and hands the messages in batches to write_batch(), which derived classes override
+        /// to send the text to a file, console, etc.  Memory use is bounded by the ring buffer size: if the writer
+        /// falls behind and the ring buffer is full, new messages are dropped and counted (see get_dropped_count()).
+        ///
+        /// @note Derived classes must call stop() in their destructor, so that the remaining messages are written
+        /// while the derived sink (the file stream, etc.) still exists.
+        class async_logger : public twain_logger
+        {
+            public:
+                /// Maximum number of characters stored in the ring buffer for a single message.  Longer messages (for example,
+                /// the capability and TWMEMREF dumps written at the highest diagnostic level) are copied to the heap.
+                static constexpr std::size_t max_message_size = 1024;
+                static constexpr std::size_t default_capacity = 4096;
+
+            private:
+                struct log_slot
+                {
+                    std::atomic<std::size_t> m_sequence;
+                    uint64_t m_timestamp;
+                    uint32_t m_thread_id;
+                    uint32_t m_length;
+                    char* m_long_text;      // heap copy of a message longer than max_message_size, otherwise null
+                    char m_text[max_message_size];
+                };
+
+                std::unique_ptr<log_slot[]> m_slots;
+                std::size_t m_mask;
+                alignas(64) std::atomic<std::size_t> m_enqueue_pos;
+                alignas(64) std::atomic<std::size_t> m_dequeue_pos;
+                std::atomic<uint64_t> m_dropped;
+                std::atomic<uint64_t> m_truncated;
+                uint64_t m_dropped_reported;
+                uint64_t m_truncated_reported;
+                std::atomic<bool> m_bRunning;
+                std::atomic<bool> m_bWakeupPending;
+                std::chrono::milliseconds m_flush_interval;
+                std::mutex m_wait_mutex;
+                std::condition_variable m_wait_cv;
+                std::thread m_writer;
+                std::string m_batch;
+                mutable std::mutex m_history_mutex;
+                std::deque<std::string> m_history;
+                std::atomic<std::size_t> m_history_size{ 0 };   // changed under m_history_mutex, read without it by drain()
+
+                static std::size_t round_to_power_of_two(std::size_t n)
+                {
+                    std::size_t val = 2;
+                    while (val < n)
+                        val <<= 1;
+                    return val;
+                }
+
+                std::size_t queued_count() const
+                {
+                    return m_enqueue_pos.load(std::memory_order_relaxed) - m_dequeue_pos.load(std::memory_order_relaxed);
+                }
+
+                // Only called by the writer thread (or by stop() after the writer thread has ended)
+                std::size_t drain()
+                {
+                    std::size_t total = 0;
+                    m_batch.clear();
+                    std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+                    while (true)
+                    {
+                        log_slot& slot = m_slots[pos & m_mask];
+                        const std::size_t seq = slot.m_sequence.load(std::memory_order_acquire);
+                        if (seq != pos + 1)
+                            break;
+                        const char* text = slot.m_long_text ? slot.m_long_text : slot.m_text;
+                        format_entry(m_batch, { slot.m_timestamp, slot.m_thread_id, text, slot.m_length });
+                        if (m_history_size.load(std::memory_order_relaxed) > 0)
+                            add_to_history(text, slot.m_length);
+                        delete[] slot.m_long_text;
+                        slot.m_long_text = nullptr;
+                        slot.m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+                        ++pos;
+                        ++total;
+                    }
+                    m_dequeue_pos.store(pos, std::memory_order_relaxed);
+
+                    const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+                    if (dropped != m_dropped_reported)
+                    {
+                        const std::string notice = "*** " + std::to_string(dropped - m_dropped_reported) + " log message(s) dropped ***";
+                        format_entry(m_batch, { get_timestamp(), get_thread_id(), notice.c_str(), notice.size() });
+                        m_dropped_reported = dropped;
+                    }
+
+                    const uint64_t truncated = m_truncated.load(std::memory_order_relaxed);
+                    if (truncated != m_truncated_reported)
+                    {
+                        const std::string notice = "*** " + std::to_string(truncated - m_truncated_reported) + " log message(s) truncated to " +
+                                                   std::to_string(max_message_size) + " characters (out of memory) ***";
+                        format_entry(m_batch, { get_timestamp(), get_thread_id(), notice.c_str(), notice.size() });
+                        m_truncated_reported = truncated;
+                    }
+
+                    if (!m_batch.empty())
+                    {
+                        write_batch(m_batch);
+                        flush_sink();
+                    }
+                    return total;
+                }
+
+                void add_to_history(const char* text, std::size_t length)
+                {
+                    std::lock_guard<std::mutex> lock(m_history_mutex);
+                    const std::size_t historySize = m_history_size.load(std::memory_order_relaxed);
+                    if (historySize == 0)
+                        return;
+                    if (m_history.size() >= historySize)
+                        m_history.pop_front();
+                    m_history.emplace_back(text, length);
+                }
+
+                void writer_proc()
+                {
+                    while (m_bRunning.load(std::memory_order_acquire))
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(m_wait_mutex);
+                            m_wait_cv.wait_for(lock, m_flush_interval, [&]
+                                { return m_bWakeupPending.load(std::memory_order_acquire) || !m_bRunning.load(std::memory_order_acquire); });
+                            m_bWakeupPending.store(false, std::memory_order_release);
+                        }
+                        drain();
+                    }
+                }
+
+            protected:
+                /// A queued log message, as handed to format_entry()
+                struct log_entry
+                {
+                    uint64_t timestamp;     // microseconds since the epoch, taken when log() was called
+                    uint32_t thread_id;     // thread that called log()
+                    const char* text;       // not null-terminated
+                    std::size_t length;
+                };
+
+                /// Adds one message to the batch that will be passed to write_batch().
+                ///
+                /// The default appends the message text and a newline.  Override this to change the format of the output.
+                virtual void format_entry(std::string& batch, const log_entry& entry)
+                {
+                    batch.append(entry.text, entry.length);
+                    batch.push_back('\n');
+                }
+
+                /// Writes a batch of log messages (as built by format_entry()) to the destination.
+                ///
+                /// This function is always called from the background writer thread (or from stop()), never from the thread that called log().
+                virtual void write_batch(const std::string& /*batch*/) {}
+
+                /// Called after each batch is written, so that the destination can be flushed.
+                virtual void flush_sink() {}
+
+                static uint64_t get_timestamp()
+                {
+                    using namespace std::chrono;
+                    return static_cast<uint64_t>(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+                }
+
+                static uint32_t get_thread_id()
+                {
+                    #ifdef _WIN32
+                    return static_cast<uint32_t>(GetCurrentThreadId());
+                    #else
+                    return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+                    #endif
+                }
+
+            public:
+                /// Constructs the asynchronous logger.
+                ///
+                /// @param[in] capacity Number of messages that can be queued before messages are dropped.  Rounded up to a power of 2.
+                /// @param[in] flush_interval Maximum time a message waits in the queue before being written.
+                explicit async_logger(std::size_t capacity = default_capacity,
+                                      std::chrono::milliseconds flush_interval = std::chrono::milliseconds(100)) :
+                                        m_mask(round_to_power_of_two(capacity) - 1),
+                                        m_enqueue_pos(0),
+                                        m_dequeue_pos(0),
+                                        m_dropped(0),
+                                        m_truncated(0),
+                                        m_dropped_reported(0),
+                                        m_truncated_reported(0),
+                                        m_bRunning(false),
+                                        m_bWakeupPending(false),
+                                        m_flush_interval(flush_interval)
+                {
+                    m_slots = std::make_unique<log_slot[]>(m_mask + 1);
+                    for (std::size_t i = 0; i <= m_mask; ++i)
+                    {
+                        m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+                        m_slots[i].m_long_text = nullptr;
+                    }
+                }
+
+                async_logger(const async_logger&) = delete;
+                async_logger& operator=(const async_logger&) = delete;
+
+                ~async_logger() override
+                {
+                    stop();
+
+                    // Messages logged after stop() are never written
+                    for (std::size_t i = 0; i <= m_mask; ++i)
+                        delete[] m_slots[i].m_long_text;
+                }
+
+                /// Starts the background writer thread.  Messages logged before start() is called are queued.
+                void start()
+                {
+                    if (m_bRunning.exchange(true))
+                        return;
+                    m_writer = std::thread(&async_logger::writer_proc, this);
+                }
+
+                /// Stops the background writer thread, and writes any messages remaining in the queue.
+                void stop()
+                {
+                    if (m_bRunning.exchange(false))
+                    {
+                        m_wait_cv.notify_one();
+                        if (m_writer.joinable())
+                            m_writer.join();
+                    }
+                    if (m_slots)
+                        drain();
+                }
+
+                /// Queues the message to be written by the background thread.  Never blocks.
+                void log(const char* msg) override
+                {
+                    std::size_t len = msg ? strlen(msg) : 0;
+                    char* longText = nullptr;
+                    if (len > max_message_size)
+                    {
+                        longText = new (std::nothrow) char[len];
+                        if (longText)
+                            memcpy(longText, msg, len);
+                        else
+                        {
+                            len = max_message_size;
+                            m_truncated.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+
+                    std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                    log_slot* slot = nullptr;
+                    while (true)
+                    {
+                        slot = &m_slots[pos & m_mask];
+                        const std::size_t seq = slot->m_sequence.load(std::memory_order_acquire);
+                        const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                        if (diff == 0)
+                        {
+                            if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                                break;
+                        }
+                        else
+                        if (diff < 0)
+                        {
+                            m_dropped.fetch_add(1, std::memory_order_relaxed);
+                            delete[] longText;
+                            return;
+                        }
+                        else
+                            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                    }
+
+                    if (!longText && len > 0)
+                        memcpy(slot->m_text, msg, len);
+                    slot->m_long_text = longText;
+                    slot->m_length = static_cast<uint32_t>(len);
+                    slot->m_timestamp = get_timestamp();
+                    slot->m_thread_id = get_thread_id();
+                    slot->m_sequence.store(pos + 1, std::memory_order_release);
+
+                    // Wake the writer early if the queue is getting full
+                    if (queued_count() > (m_mask + 1) / 2 && !m_bWakeupPending.exchange(true, std::memory_order_acq_rel))
+                        m_wait_cv.notify_one();
+                }
+
+                /// Returns the number of messages that were discarded because the queue was full.
+                uint64_t get_dropped_count() const { return m_dropped.load(std::memory_order_relaxed); }
+
+                /// Returns the number of long messages that were truncated to max_message_size characters, because there was
+                /// not enough memory to copy them.
+                uint64_t get_truncated_count() const { return m_truncated.load(std::memory_order_relaxed); }
+
+                /// Returns the number of messages the queue can hold.
+                std::size_t get_capacity() const { return m_mask + 1; }
+
+                /// Keeps a copy of the last **count** messages written, so that they can be retrieved with
+                /// get_recent_messages() (for example, to report what happened before a failure).  0 turns this off.
+                /// Call this before start().
+                void set_history_size(std::size_t count)
+                {
+                    std::lock_guard<std::mutex> lock(m_history_mutex);
+                    m_history_size.store(count, std::memory_order_relaxed);
+                    while (m_history.size() > count)
+                        m_history.pop_front();
+                }
+
+                /// Returns the most recent messages that were written, oldest first.  Safe to call from any thread.
+                std::vector<std::string> get_recent_messages() const
+                {
+                    std::lock_guard<std::mutex> lock(m_history_mutex);
+                    return std::vector<std::string>(m_history.begin(), m_history.end());
+                }
+        };
+    }
+}
+#endif
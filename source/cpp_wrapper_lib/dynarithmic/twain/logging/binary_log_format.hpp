@@ -0,0 +1,370 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_BINARY_LOG_FORMAT_HPP
+#define DTWAIN_BINARY_LOG_FORMAT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*  Binary diagnostic log format.
+
+    The file is a sequence of 64-byte records.  Each distinct log message "shape" is stored once as a
+    template, where the numbers in the message are replaced by placeholders.  Every log message is then
+    stored as a fixed-size event record holding the timestamp, thread id, template id and the numbers
+    taken out of the message.
+
+    header_record:   args[0] = file_magic, args[1] = file_version, timestamp = time the log was started.
+    template_record: event_id = template id, arg_count = length of the template text.  The text follows
+                     the record, padded with zeros to a multiple of the record size.
+    event_record:    event_id = template id, arg_count = number of values in args.
+
+    Template placeholders:  {d} = decimal number, {hPCW} = hex number with a prefix of "0P", digits in
+    upper (C == 'u') or lower (C == 'l') case, zero-padded to W digits.  A literal '{' is written as "{{".
+*/
+namespace dynarithmic
+{
+    namespace twain
+    {
+        namespace binary_log
+        {
+            static constexpr uint64_t file_magic = 0x31474F4C4E575444ULL; // "DTWNLOG1"
+            static constexpr uint64_t file_version = 1;
+            static constexpr std::size_t max_args = 5;
+
+            enum record_type : uint32_t
+            {
+                header_record = 0,
+                template_record = 1,
+                event_record = 2
+            };
+
+            struct record
+            {
+                uint32_t type;
+                uint32_t thread_id;
+                uint64_t timestamp;  // microseconds since the epoch
+                uint32_t event_id;
+                uint32_t arg_count;
+                uint64_t args[max_args];
+            };
+            static_assert(sizeof(record) == 64, "binary log record must be 64 bytes");
+
+            /// Converts log message text to binary log records.
+            class encoder
+            {
+                std::unordered_map<std::string, uint32_t> m_templates;
+                std::string m_template;
+
+                static bool is_ident_char(char c)
+                {
+                    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+                }
+
+                static int hex_value(char c)
+                {
+                    if (c >= '0' && c <= '9')
+                        return c - '0';
+                    if (c >= 'a' && c <= 'f')
+                        return c - 'a' + 10;
+                    if (c >= 'A' && c <= 'F')
+                        return c - 'A' + 10;
+                    return -1;
+                }
+
+                static void append_record(std::string& out, const record& r)
+                {
+                    out.append(reinterpret_cast<const char*>(&r), sizeof(r));
+                }
+
+                // Tries to take a hex number (0x....) starting at text[i].  Returns the number of characters used, or 0.
+                std::size_t take_hex(const char* text, std::size_t len, std::size_t i, uint64_t& value)
+                {
+                    if (i + 2 >= len || text[i] != '0' || (text[i + 1] != 'x' && text[i + 1] != 'X'))
+                        return 0;
+                    std::size_t j = i + 2;
+                    int upper = 0, lower = 0;
+                    value = 0;
+                    while (j < len && hex_value(text[j]) >= 0)
+                    {
+                        if (text[j] >= 'a' && text[j] <= 'f')
+                            ++lower;
+                        else
+                        if (text[j] >= 'A' && text[j] <= 'F')
+                            ++upper;
+                        value = (value << 4) | static_cast<uint64_t>(hex_value(text[j]));
+                        ++j;
+                    }
+                    const std::size_t width = j - i - 2;
+                    if (width == 0 || width > 16 || (upper && lower) || (j < len && is_ident_char(text[j])))
+                        return 0;
+                    m_template += "{h";
+                    m_template += text[i + 1];
+                    m_template += upper ? 'u' : 'l';
+                    m_template += std::to_string(width);
+                    m_template += '}';
+                    return j - i;
+                }
+
+                // Tries to take a decimal number starting at text[i].  Returns the number of characters used, or 0.
+                std::size_t take_decimal(const char* text, std::size_t len, std::size_t i, uint64_t& value)
+                {
+                    std::size_t j = i;
+                    value = 0;
+                    while (j < len && text[j] >= '0' && text[j] <= '9')
+                    {
+                        value = value * 10 + static_cast<uint64_t>(text[j] - '0');
+                        ++j;
+                    }
+                    const std::size_t width = j - i;
+                    if (width == 0 || width > 19 || (text[i] == '0' && width > 1) || (j < len && is_ident_char(text[j])))
+                        return 0;
+                    m_template += "{d}";
+                    return width;
+                }
+
+            public:
+                /// Returns the header record that starts every binary log
+                static std::string get_header(uint64_t timestamp)
+                {
+                    record r = {};
+                    r.type = header_record;
+                    r.timestamp = timestamp;
+                    r.args[0] = file_magic;
+                    r.args[1] = file_version;
+                    std::string out;
+                    append_record(out, r);
+                    return out;
+                }
+
+                /// Appends the record(s) for one log message to **out**
+                void encode(std::string& out, uint64_t timestamp, uint32_t thread_id, const char* text, std::size_t len)
+                {
+                    record r = {};
+                    r.type = event_record;
+                    r.thread_id = thread_id;
+                    r.timestamp = timestamp;
+
+                    m_template.clear();
+                    for (std::size_t i = 0; i < len; )
+                    {
+                        const char c = text[i];
+                        if (c == '{')
+                        {
+                            m_template += "{{";
+                            ++i;
+                            continue;
+                        }
+                        if (c >= '0' && c <= '9' && r.arg_count < max_args && (i == 0 || !is_ident_char(text[i - 1])))
+                        {
+                            uint64_t value = 0;
+                            std::size_t used = take_hex(text, len, i, value);
+                            if (used == 0)
+                                used = take_decimal(text, len, i, value);
+                            if (used > 0)
+                            {
+                                r.args[r.arg_count++] = value;
+                                i += used;
+                                continue;
+                            }
+                        }
+                        m_template += c;
+                        ++i;
+                    }
+
+                    auto iter = m_templates.find(m_template);
+                    if (iter == m_templates.end())
+                    {
+                        const auto id = static_cast<uint32_t>(m_templates.size());
+                        iter = m_templates.insert({ m_template, id }).first;
+                        record t = {};
+                        t.type = template_record;
+                        t.thread_id = thread_id;
+                        t.timestamp = timestamp;
+                        t.event_id = id;
+                        t.arg_count = static_cast<uint32_t>(m_template.size());
+                        append_record(out, t);
+                        out += m_template;
+                        out.append((sizeof(record) - m_template.size() % sizeof(record)) % sizeof(record), '\0');
+                    }
+                    r.event_id = iter->second;
+                    append_record(out, r);
+                }
+
+                /// Returns the number of distinct message templates written so far
+                std::size_t get_template_count() const { return m_templates.size(); }
+            };
+
+            /// Converts binary log records back to text or JSON
+            class decoder
+            {
+                std::vector<std::string> m_templates;
+                uint64_t m_event_count = 0;
+
+                static void append_json_string(std::ostream& out, const std::string& s)
+                {
+                    out << '"';
+                    for (unsigned char c : s)
+                    {
+                        switch (c)
+                        {
+                            case '"': out << "\\\""; break;
+                            case '\\': out << "\\\\"; break;
+                            case '\n': out << "\\n"; break;
+                            case '\r': out << "\\r"; break;
+                            case '\t': out << "\\t"; break;
+                            default:
+                                if (c < 0x20)
+                                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+                                else
+                                    out << c;
+                        }
+                    }
+                    out << '"';
+                }
+
+            public:
+                enum class output_format
+                {
+                    text,
+                    json
+                };
+
+                /// Rebuilds the original log message from an event record
+                std::string render_message(const record& r) const
+                {
+                    if (r.event_id >= m_templates.size())
+                        return "<unknown event " + std::to_string(r.event_id) + ">";
+                    const std::string& tmpl = m_templates[r.event_id];
+                    std::ostringstream strm;
+                    std::size_t curArg = 0;
+                    for (std::size_t i = 0; i < tmpl.size(); ++i)
+                    {
+                        if (tmpl[i] != '{')
+                        {
+                            strm << tmpl[i];
+                            continue;
+                        }
+                        const auto endPos = tmpl.find('}', i);
+                        if (i + 1 < tmpl.size() && tmpl[i + 1] == '{')
+                        {
+                            strm << '{';
+                            ++i;
+                            continue;
+                        }
+                        if (endPos == std::string::npos)
+                        {
+                            strm << tmpl.substr(i);
+                            break;
+                        }
+                        const uint64_t value = curArg < r.arg_count && curArg < max_args ? r.args[curArg] : 0;
+                        ++curArg;
+                        if (tmpl[i + 1] == 'h' && endPos > i + 4)
+                        {
+                            strm << '0' << tmpl[i + 2] << std::hex << (tmpl[i + 3] == 'u' ? std::uppercase : std::nouppercase)
+                                 << std::setw(std::stoi(tmpl.substr(i + 4, endPos - i - 4))) << std::setfill('0') << value
+                                 << std::dec << std::nouppercase << std::setfill(' ');
+                        }
+                        else
+                            strm << value;
+                        i = endPos;
+                    }
+                    return strm.str();
+                }
+
+                /// Formats a record's timestamp as "YYYY-MM-DD HH:MM:SS.uuuuuu" (UTC)
+                static std::string render_timestamp(uint64_t timestamp)
+                {
+                    const auto secs = static_cast<std::time_t>(timestamp / 1000000);
+                    std::tm tmVal = {};
+                    #ifdef _WIN32
+                    gmtime_s(&tmVal, &secs);
+                    #else
+                    gmtime_r(&secs, &tmVal);
+                    #endif
+                    std::ostringstream strm;
+                    strm << std::put_time(&tmVal, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(6) << std::setfill('0') << (timestamp % 1000000);
+                    return strm.str();
+                }
+
+                /// Decodes the binary log in **in** and writes it to **out**.
+                ///
+                /// @returns **true** if the whole log was decoded, **false** if **in** is not a binary log or is truncated.
+                bool decode(std::istream& in, std::ostream& out, output_format fmt)
+                {
+                    record r;
+                    if (!in.read(reinterpret_cast<char*>(&r), sizeof(r)) || r.type != header_record || r.args[0] != file_magic)
+                        return false;
+                    if (fmt == output_format::json)
+                        out << "[";
+                    bool bFirst = true;
+                    while (in.read(reinterpret_cast<char*>(&r), sizeof(r)))
+                    {
+                        if (r.type == template_record)
+                        {
+                            const std::size_t padded = (r.arg_count + sizeof(record) - 1) / sizeof(record) * sizeof(record);
+                            std::string tmpl(padded, '\0');
+                            if (padded > 0 && !in.read(&tmpl[0], static_cast<std::streamsize>(padded)))
+                                break;
+                            tmpl.resize(r.arg_count);
+                            if (m_templates.size() <= r.event_id)
+                                m_templates.resize(r.event_id + 1);
+                            m_templates[r.event_id] = std::move(tmpl);
+                            continue;
+                        }
+                        if (r.type != event_record)
+                            continue;
+                        ++m_event_count;
+                        if (fmt == output_format::text)
+                        {
+                            out << render_timestamp(r.timestamp) << " [" << r.thread_id << "] " << render_message(r) << "\n";
+                        }
+                        else
+                        {
+                            out << (bFirst ? "\n" : ",\n") << "{\"timestamp\":" << r.timestamp << ",\"time\":\"" << render_timestamp(r.timestamp)
+                                << "\",\"thread\":" << r.thread_id << ",\"event\":" << r.event_id << ",\"args\":[";
+                            for (uint32_t i = 0; i < r.arg_count && i < max_args; ++i)
+                                out << (i ? "," : "") << r.args[i];
+                            out << "],\"message\":";
+                            append_json_string(out, render_message(r));
+                            out << "}";
+                        }
+                        bFirst = false;
+                    }
+                    if (fmt == output_format::json)
+                        out << "\n]\n";
+                    return in.eof() && in.gcount() == 0;
+                }
+
+                uint64_t get_event_count() const { return m_event_count; }
+                std::size_t get_template_count() const { return m_templates.size(); }
+            };
+        }
+    }
+}
+#endif
@@ -0,0 +1,90 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_BINARY_LOGGER_HPP
+#define DTWAIN_BINARY_LOGGER_HPP
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <dynarithmic/twain/logging/async_logger.hpp>
+#include <dynarithmic/twain/logging/binary_log_format.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Logger that writes the log messages to a file in the compact binary format described in binary_log_format.hpp.
+        ///
+        /// Messages are encoded on the logger's writer thread, so the thread calling log() only pays for the copy into the queue.
+        /// Use binary_log::decoder (or the twainlog-decode tool) to turn the file back into text or JSON.
+        class binary_file_logger : public async_logger
+        {
+            std::string m_filename;
+            std::unique_ptr<std::ofstream> m_file;
+            binary_log::encoder m_encoder;
+
+            protected:
+                void format_entry(std::string& batch, const log_entry& entry) override
+                {
+                    m_encoder.encode(batch, entry.timestamp, entry.thread_id, entry.text, entry.length);
+                }
+
+                void write_batch(const std::string& batch) override
+                {
+                    if (m_file)
+                        m_file->write(batch.data(), batch.size());
+                }
+
+                void flush_sink() override
+                {
+                    if (m_file)
+                        m_file->flush();
+                }
+
+            public:
+                binary_file_logger() = default;
+                explicit binary_file_logger(std::string filename) : m_filename(std::move(filename)) {}
+                ~binary_file_logger() override { stop(); }
+
+                binary_file_logger& set_filename(std::string filename) { m_filename = std::move(filename); return *this; }
+                std::string get_filename() const { return m_filename; }
+
+                /// Creates the log file and starts logging.
+                ///
+                /// @returns **true** if the log file was created, **false** otherwise.
+                bool enable()
+                {
+                    m_file = std::make_unique<std::ofstream>(m_filename, std::ios::binary | std::ios::trunc);
+                    if (!*m_file)
+                    {
+                        m_file.reset();
+                        return false;
+                    }
+                    const std::string header = binary_log::encoder::get_header(get_timestamp());
+                    m_file->write(header.data(), header.size());
+                    twain_logger::enable();
+                    start();
+                    return true;
+                }
+        };
+    }
+}
+#endif
@@ -0,0 +1,288 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_TRACE_RECORDER_HPP
+#define DTWAIN_TRACE_RECORDER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Records a timeline of TWAIN activity that can be saved in the Chrome trace-event JSON format.
+        ///
+        /// The events are kept in a fixed-size ring buffer, so only the most recent events are kept if the buffer fills up
+        /// (see get_overwritten_count()).  Recording an event does not allocate or lock.  The saved file can be loaded into
+        /// chrome://tracing or https://ui.perfetto.dev.
+        ///
+        /// When enabled, the following are recorded:  TWAIN triplets (twain_session::enable_triplets_notification(true) must
+        /// be set), DTWAIN notifications, page transfers and file saves, capability gets and sets that go to the device, and
+        /// the session and acquisition stages timed by twain_statistics.
+        class trace_recorder
+        {
+            public:
+                static constexpr std::size_t max_name_size = 64;
+                static constexpr std::size_t default_capacity = 65536;
+
+                /// Event categories, written as the "cat" field of each event
+                enum class category : uint8_t
+                {
+                    triplet,
+                    notification,
+                    transfer,
+                    capability,
+                    stage
+                };
+
+            private:
+                struct trace_event
+                {
+                    std::atomic<uint64_t> m_sequence{ 0 };   // 0 = being written, otherwise index + 1
+                    std::atomic<bool> m_bWriting{ false };
+                    uint64_t m_timestamp = 0;
+                    uint64_t m_duration = 0;
+                    uint32_t m_thread_id = 0;
+                    char m_phase = 'i';
+                    category m_category = category::stage;
+                    int64_t m_arg = 0;
+                    bool m_bHasArg = false;
+                    char m_name[max_name_size] = {};
+                };
+
+                std::atomic<bool> m_bEnabled{ false };
+                std::unique_ptr<trace_event[]> m_events;
+                std::size_t m_capacity = 0;
+                std::atomic<uint64_t> m_next{ 0 };
+                std::atomic<uint64_t> m_dropped{ 0 };
+                std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+
+                trace_recorder() = default;
+
+                static uint32_t get_thread_id()
+                {
+                    #ifdef _WIN32
+                    return static_cast<uint32_t>(GetCurrentThreadId());
+                    #else
+                    return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+                    #endif
+                }
+
+                static const char* get_category_name(category cat)
+                {
+                    switch (cat)
+                    {
+                        case category::triplet: return "triplet";
+                        case category::notification: return "notification";
+                        case category::transfer: return "transfer";
+                        case category::capability: return "capability";
+                        case category::stage: return "stage";
+                    }
+                    return "";
+                }
+
+                static void write_json_string(std::ostream& out, const char* s)
+                {
+                    out << '"';
+                    for (; *s; ++s)
+                    {
+                        const unsigned char c = static_cast<unsigned char>(*s);
+                        if (c == '"' || c == '\\')
+                            out << '\\' << *s;
+                        else
+                        if (c >= 0x20)
+                            out << *s;
+                    }
+                    out << '"';
+                }
+
+                void add_event(char phase, category cat, const char* name, uint64_t timestamp, uint64_t duration, const int64_t* arg)
+                {
+                    const uint64_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+                    trace_event& ev = m_events[static_cast<std::size_t>(index % m_capacity)];
+
+                    // Another thread that wrapped around the buffer is still writing to this slot
+                    if (ev.m_bWriting.exchange(true, std::memory_order_acquire))
+                    {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    ev.m_sequence.store(0, std::memory_order_relaxed);
+                    ev.m_timestamp = timestamp;
+                    ev.m_duration = duration;
+                    ev.m_thread_id = get_thread_id();
+                    ev.m_phase = phase;
+                    ev.m_category = cat;
+                    ev.m_bHasArg = arg != nullptr;
+                    ev.m_arg = arg ? *arg : 0;
+                    const std::size_t len = (std::min)(strlen(name), max_name_size - 1);
+                    memcpy(ev.m_name, name, len);
+                    ev.m_name[len] = '\0';
+                    ev.m_sequence.store(index + 1, std::memory_order_release);
+                    ev.m_bWriting.store(false, std::memory_order_release);
+                }
+
+            public:
+                /// Records the time between construction and destruction as a complete ("X") event
+                class scope
+                {
+                    trace_recorder* m_recorder;
+                    category m_category;
+                    const char* m_name;
+                    uint64_t m_start;
+                    public:
+                        scope(category cat, const char* name) :
+                            m_recorder(instance().is_enabled() ? &instance() : nullptr), m_category(cat), m_name(name),
+                            m_start(m_recorder ? m_recorder->now() : 0) {}
+                        scope(const scope&) = delete;
+                        scope& operator=(const scope&) = delete;
+                        ~scope()
+                        {
+                            if (m_recorder)
+                                m_recorder->complete(m_category, m_name, m_start, m_recorder->now() - m_start);
+                        }
+                };
+
+                static trace_recorder& instance()
+                {
+                    static trace_recorder recorder;
+                    return recorder;
+                }
+
+                trace_recorder(const trace_recorder&) = delete;
+                trace_recorder& operator=(const trace_recorder&) = delete;
+
+                /// Starts recording.  Any previously recorded events are discarded.
+                ///
+                /// @param[in] capacity Number of events kept.  When more events are recorded, the oldest events are overwritten.
+                /// @note Do not call enable() while other threads may be recording events.
+                trace_recorder& enable(std::size_t capacity = default_capacity)
+                {
+                    m_bEnabled.store(false, std::memory_order_relaxed);
+                    m_capacity = capacity ? capacity : 1;
+                    m_events = std::make_unique<trace_event[]>(m_capacity);
+                    m_next.store(0, std::memory_order_relaxed);
+                    m_dropped.store(0, std::memory_order_relaxed);
+                    m_start = std::chrono::steady_clock::now();
+                    m_bEnabled.store(true, std::memory_order_release);
+                    return *this;
+                }
+
+                /// Stops recording.  The events that were recorded are kept, and can still be saved.
+                trace_recorder& disable() { m_bEnabled.store(false, std::memory_order_relaxed); return *this; }
+                bool is_enabled() const { return m_bEnabled.load(std::memory_order_acquire); }
+
+                /// Returns the current time, in microseconds since enable() was called
+                uint64_t now() const
+                {
+                    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count());
+                }
+
+                /// Returns the number of events that were lost because the ring buffer was full
+                uint64_t get_overwritten_count() const
+                {
+                    const uint64_t total = m_next.load(std::memory_order_relaxed);
+                    return (total > m_capacity ? total - m_capacity : 0) + m_dropped.load(std::memory_order_relaxed);
+                }
+
+                void begin(category cat, const char* name)
+                {
+                    if (is_enabled())
+                        add_event('B', cat, name, now(), 0, nullptr);
+                }
+
+                void end(category cat, const char* name)
+                {
+                    if (is_enabled())
+                        add_event('E', cat, name, now(), 0, nullptr);
+                }
+
+                void instant(category cat, const char* name)
+                {
+                    if (is_enabled())
+                        add_event('i', cat, name, now(), 0, nullptr);
+                }
+
+                void instant(category cat, const char* name, int64_t arg)
+                {
+                    if (is_enabled())
+                        add_event('i', cat, name, now(), 0, &arg);
+                }
+
+                /// Records an event that started at **start** (a value returned by now()) and lasted **duration** microseconds
+                void complete(category cat, const char* name, uint64_t start, uint64_t duration)
+                {
+                    if (is_enabled())
+                        add_event('X', cat, name, start, duration, nullptr);
+                }
+
+                /// Writes the recorded events in Chrome trace-event JSON format
+                ///
+                /// @note Call disable() first, so that events are not being recorded while they are being written.
+                void write_json(std::ostream& out) const
+                {
+                    std::vector<const trace_event*> vEvents;
+                    if (m_events)
+                    {
+                        const uint64_t total = m_next.load(std::memory_order_acquire);
+                        const uint64_t first = total > m_capacity ? total - m_capacity : 0;
+                        for (uint64_t i = first; i < total; ++i)
+                        {
+                            const trace_event& ev = m_events[static_cast<std::size_t>(i % m_capacity)];
+                            if (ev.m_sequence.load(std::memory_order_acquire) == i + 1)
+                                vEvents.push_back(&ev);
+                        }
+                    }
+                    std::stable_sort(vEvents.begin(), vEvents.end(), [](const trace_event* l, const trace_event* r)
+                        { return l->m_timestamp < r->m_timestamp; });
+
+                    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+                    bool bFirst = true;
+                    for (auto* ev : vEvents)
+                    {
+                        out << (bFirst ? "\n" : ",\n") << "{\"name\":";
+                        write_json_string(out, ev->m_name);
+                        out << ",\"cat\":\"" << get_category_name(ev->m_category) << "\",\"ph\":\"" << ev->m_phase
+                            << "\",\"ts\":" << ev->m_timestamp << ",\"pid\":1,\"tid\":" << ev->m_thread_id;
+                        if (ev->m_phase == 'X')
+                            out << ",\"dur\":" << ev->m_duration;
+                        if (ev->m_phase == 'i')
+                            out << ",\"s\":\"t\"";
+                        if (ev->m_bHasArg)
+                            out << ",\"args\":{\"value\":" << ev->m_arg << "}";
+                        out << "}";
+                        bFirst = false;
+                    }
+                    out << "\n]}\n";
+                }
+        };
+    }
+}
+#endif
@@ -25,6 +25,7 @@ OF THIRD PARTY RIGHTS.
 #include <array>
 #include <algorithm>
 #include <climits>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -131,6 +132,8 @@ namespace dynarithmic
                     static std::array<uint16_t, 2> affected_caps = { CAP_ALARMS, CAP_ALARMVOLUME };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept { return std::tie(m_vAlarms, m_AlarmVolume); }
         };
     }
 }
@@ -23,6 +23,7 @@ OF THIRD PARTY RIGHTS.
 
 #include <vector>
 #include <climits>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -154,6 +155,13 @@ namespace dynarithmic
                                                                     ICAP_IMAGEMERGEHEIGHTTHRESHOLD };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_bSenseMedium, m_bDiscardBlankPages, m_bBorderDetection, m_bColorEnabled,
+                                    m_ColorNonColorPixelType, m_bDeskew, m_bLengthDetection, m_bRotate, m_AutoSize,
+                                    m_FlipRotation, m_ImageMerge, m_ImageMergeHeightThreshold);
+                }
         };
     }
 }   
@@ -23,6 +23,7 @@ OF THIRD PARTY RIGHTS.
 #define DTWAIN_AUTOCAPTURE_OPTIONS_HPP
 
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -58,6 +59,7 @@ namespace dynarithmic
                     return affected_caps;
                 }
 
+                auto as_tuple() const noexcept { return std::tie(m_NumImages, m_TimeBefore, m_TimeBetween); }
         };
     }
 }   
@@ -23,6 +23,7 @@ OF THIRD PARTY RIGHTS.
 #define DTWAIN_AUTOSCANNING_OPTIONS_HPP
 
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/types/twain_types.hpp>
 #include <dynarithmic/twain/twain_values.hpp>
 #include <dynarithmic/twain/types/twain_capbasics.hpp>
@@ -81,6 +82,11 @@ namespace dynarithmic
                     std::copy(c.begin(), c.end(), std::back_inserter(m_vCameraOrder));
                     return *this;
                 }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_bAutoScan, m_bCameraEnabled, m_vCameraOrder, m_CameraSide, m_MaxBatchBuffers);
+                }
         };
     }
 }
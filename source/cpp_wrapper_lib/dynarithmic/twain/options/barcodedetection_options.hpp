@@ -24,6 +24,7 @@ OF THIRD PARTY RIGHTS.
 #include <vector>
 #include <array>
 #include <iterator>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -89,6 +90,11 @@ namespace dynarithmic
                     return affected_caps;
                 }
 
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_bDetectionEnabled, m_MaxRetries, m_MaxSearchPriorities, m_SearchMode, m_vSearchPriority,
+                                    m_TimeOut);
+                }
         };
     }
 }
@@ -25,6 +25,7 @@ OF THIRD PARTY RIGHTS.
 #include <iterator>
 #include <algorithm>
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -72,6 +73,8 @@ namespace dynarithmic
                  double get_threshold() const { return m_threshold; }
                  blankpage_discard_option get_discard_option() const { return discard_option; }
                  blankpage_detection_option get_detection_option() const { return detection_option; }
+
+                 auto as_tuple() const noexcept { return std::tie(m_bEnabled, m_threshold, discard_option, detection_option); }
          };
     }
 }
@@ -22,6 +22,8 @@ OF THIRD PARTY RIGHTS.
 #ifndef DTWAIN_BUFFERED_TRANSFER_OPTIONS
 #define DTWAIN_BUFFERED_TRANSFER_OPTIONS
 
+#include <tuple>
+
 namespace dynarithmic
 {
     namespace twain
@@ -33,6 +35,8 @@ namespace dynarithmic
                 buffered_transfer_options() : m_bEnable(false) {}
                 buffered_transfer_options& enable(bool bEnable = true) { m_bEnable = bEnable; return *this; }
                 bool is_enabled() const { return m_bEnable; }
+
+                auto as_tuple() const noexcept { return std::tie(m_bEnable); }
         };
     }
 }
@@ -26,6 +26,7 @@ OF THIRD PARTY RIGHTS.
 #include <algorithm>
 #include <iterator>
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -60,6 +61,7 @@ namespace dynarithmic
                     return affected_caps;
                 }
 
+                auto as_tuple() const noexcept { return std::tie(m_vExtendedCaps, m_bSetExtendedCaps); }
         };
     }
 }
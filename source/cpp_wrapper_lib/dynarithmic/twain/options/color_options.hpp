@@ -26,6 +26,7 @@ OF THIRD PARTY RIGHTS.
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -87,6 +88,11 @@ namespace dynarithmic
                                                                     ICAP_PLANARCHUNKY };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_bColorManagementEnabled, m_vFilterValue, m_Gamma, m_ICCProfileValue, m_PlanarChunkyValue);
+                }
         };
     }
 }
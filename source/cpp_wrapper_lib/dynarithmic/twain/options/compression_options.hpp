@@ -22,6 +22,7 @@ OF THIRD PARTY RIGHTS.
 #define DTWAIN_COMPRESSION_OPTIONS_HPP
 
 #include <array>
+#include <tuple>
 
 #include <dynarithmic/twain/twain_values.hpp>
 #include <dynarithmic/twain/capability_interface.hpp>
@@ -97,6 +98,12 @@ namespace dynarithmic
                                                                     ICAP_TIMEFILL};
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_BitOrderValue, m_CCITKFactor, m_CompressionValue, m_JpegPixelType, m_JpegQuality,
+                                    m_JpegSubSampleValue, m_PixelFlavor, m_TimeFill);
+                }
         };
     }
 }
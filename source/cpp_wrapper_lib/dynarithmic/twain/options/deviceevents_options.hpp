@@ -24,6 +24,7 @@ OF THIRD PARTY RIGHTS.
 #include <vector>
 #include <iterator>
 #include <algorithm>
+#include <tuple>
 
 #include <dynarithmic/twain/twain_values.hpp>
 
@@ -55,6 +56,8 @@ namespace dynarithmic
                     static std::array<uint16_t, 1> affected_caps = { CAP_DEVICEEVENT };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept { return std::tie(m_vDeviceEvents, m_bEnable); }
         };
     }
 }
@@ -22,6 +22,7 @@ OF THIRD PARTY RIGHTS.
 #define DTWAIN_DEVICEPARAMS_OPTIONS_HPP
 
 #include <array>
+#include <tuple>
 
 #include <dynarithmic/twain/twain_values.hpp>
 #include <dynarithmic/twain/types/twain_capbasics.hpp>
@@ -113,6 +114,12 @@ namespace dynarithmic
                                                                         ICAP_ZOOMFACTOR };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_ExposureTime, m_FlashUsed, m_ImageFilter, m_lightpath, m_filmType, m_lightsource,
+                                    m_noisefilter, m_overscan, m_unitvalue, m_zoomFactor);
+                }
         };
     }
 }
@@ -26,6 +26,7 @@ OF THIRD PARTY RIGHTS.
 #include <iterator>
 #include <algorithm>
 #include <limits>
+#include <tuple>
 
 #include <dynarithmic/twain/twain_values.hpp>
 
@@ -90,6 +91,8 @@ namespace dynarithmic
                                                                      CAP_DOUBLEFEEDDETECTIONSENSITIVITY, CAP_DOUBLEFEEDDETECTIONRESPONSE };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept { return std::tie(m_bEnable, m_detection, m_length, m_sensitivity, m_vResponses); }
         };
     }
 }
@@ -23,6 +23,7 @@ OF THIRD PARTY RIGHTS.
 
 #include <string>
 #include <unordered_set>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 // Class that controls the naming of image files when generated
@@ -49,6 +50,8 @@ namespace dynarithmic
                 bool is_enabled() const { return m_bEnable; }
                 int get_increment() const { return increment_value; }
                 bool is_reset_count_used() const { return m_resetOnStartup; }
+
+                auto as_tuple() const noexcept { return std::tie(m_bEnable, increment_value, m_resetOnStartup); }
         };
 
         class file_transfer_options
@@ -77,7 +80,9 @@ namespace dynarithmic
                 { m_filename = name; return *this; }
 
                 filename_increment_options& get_filename_increment_options() { return m_filename_increment_options; }
+                const filename_increment_options& get_filename_increment_options() const noexcept { return m_filename_increment_options; }
                 multipage_save_options& get_multipage_save_options() { return m_multipage_save_options; }
+                const multipage_save_options& get_multipage_save_options() const noexcept { return m_multipage_save_options; }
 
                 filetype_value::value_type get_type() const { return m_file_type; }
                 std::string get_name() const { return m_filename; }
@@ -96,6 +101,12 @@ namespace dynarithmic
                 { m_bAutoCreateDirectory = bEnable; return *this; }
 
                 bool is_autocreate_directory() const { return m_bAutoCreateDirectory; }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_filename, m_file_type, m_transferFlags, m_bMultiPage, m_bAutoCreateDirectory,
+                                    m_filename_increment_options, m_multipage_save_options);
+                }
         };
 
         class file_transfer_options_ex
@@ -24,6 +24,7 @@ OF THIRD PARTY RIGHTS.
 
 #include <limits>
 #include <cstdint>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 #include <dynarithmic/twain/types/twain_types.hpp>
 
@@ -82,6 +83,11 @@ namespace dynarithmic
 
                 sourceaction_type get_source_action() const
                 { return m_SourceAction; }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_transfer_type, m_nMaxPageCount, m_nMaxAcquisitions, m_SourceAction, m_pixelType);
+                }
         };
     }
 }
@@ -25,6 +25,7 @@ OF THIRD PARTY RIGHTS.
 #include <string>
 #include <vector>
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -69,6 +70,7 @@ namespace dynarithmic
                     return affected_caps;
                 }
 
+                auto as_tuple() const noexcept { return std::tie(m_sAuthor, m_sCaption, m_bExtImageInfo); }
         };
     }
 }
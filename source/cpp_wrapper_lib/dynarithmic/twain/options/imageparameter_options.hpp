@@ -24,6 +24,7 @@ OF THIRD PARTY RIGHTS.
 
 #include <vector>
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -123,6 +124,13 @@ namespace dynarithmic
                                                                         ICAP_YSCALING };
                         return affected_caps;
                  }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_bThumbnailsEnabled, m_bForceScaling, m_bAutoBright, m_Brightness, m_Contrast, m_Highlight,
+                                    m_vImageDataSets, m_MirrorValue, m_OrientationValue, m_RotationValue, m_ShadowValue,
+                                    m_xScaling, m_yScaling);
+                }
         };
     }
 }
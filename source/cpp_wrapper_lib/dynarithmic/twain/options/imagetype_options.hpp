@@ -25,6 +25,7 @@ OF THIRD PARTY RIGHTS.
 #include <string>
 #include <array>
 #include <algorithm>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 #include <dynarithmic/twain/types/twain_types.hpp>
 
@@ -117,6 +118,12 @@ namespace dynarithmic
                                                                     ICAP_THRESHOLD };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_BitDepth, m_PixelType, m_BitDepthReduction, m_BitOrderValue, m_vCustHalfTone, m_sHalftone,
+                                    m_PixelFlavor, m_Threshold, m_bNegateImage, m_bCustomHalfToneEnabled, m_nJPegQuality);
+                }
         };
     }
 }
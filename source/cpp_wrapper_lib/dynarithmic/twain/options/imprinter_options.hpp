@@ -26,6 +26,7 @@ OF THIRD PARTY RIGHTS.
 #include <iterator>
 #include <algorithm>
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -155,6 +156,12 @@ namespace dynarithmic
                     return affected_caps;
                 }
 
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_bEnable, m_vPrinterToUse, m_fontStyles, m_printerStrings, m_indexTriggers, m_suffixString,
+                                    m_printerIndex, m_printerMaxValue, m_charRotation, m_printerNumDigits, m_printerIndexStep,
+                                    m_printerLeadChar, m_stringMode, m_vertical_offset);
+                }
         };
     }
 }
@@ -22,6 +22,8 @@ OF THIRD PARTY RIGHTS.
 #ifndef DTWAIN_JOBCONTROL_OPTIONS_HPP
 #define DTWAIN_JOBCONTROL_OPTIONS_HPP
 
+#include <tuple>
+
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -36,6 +38,8 @@ namespace dynarithmic
                 jobcontrol_options() : m_option(jobcontrol_value::none) {}
                 jobcontrol_options& set_option(jobcontrol_value::value_type jm) { m_option = jm; return *this; }
                 jobcontrol_value::value_type get_option() const { return m_option; }
+
+                auto as_tuple() const noexcept { return std::tie(m_option); }
         };
     }
 }
@@ -24,6 +24,7 @@ OF THIRD PARTY RIGHTS.
 
 #include <vector>
 #include <array>
+#include <tuple>
 
 #include <dynarithmic/twain/twain_values.hpp>
 
@@ -47,6 +48,7 @@ namespace dynarithmic
                     return affected_caps;
                 }
 
+                auto as_tuple() const noexcept { return std::tie(m_Language); }
         };
     }
 }
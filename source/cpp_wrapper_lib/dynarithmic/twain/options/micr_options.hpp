@@ -24,6 +24,7 @@ OF THIRD PARTY RIGHTS.
 
 #include <vector>
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -46,6 +47,8 @@ namespace dynarithmic
                     static std::array<uint16_t, 1> affected_caps = { CAP_MICRENABLED };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept { return std::tie(m_bMicrEnabled); }
         };
     }
 }
@@ -55,31 +55,31 @@ namespace dynarithmic
         class options_base
         {
             public:
-                static void apply(twain_source& ts, pages_options& po);
-                static void apply(twain_source& ts, jobcontrol_options& jc);
-                static void apply(twain_source& ts, paperhandling_options& po);
-                static void apply(twain_source& ts, imagetype_options& io);
+                static void apply(twain_source& ts, const pages_options& po);
+                static void apply(twain_source& ts, const jobcontrol_options& jc);
+                static void apply(twain_source& ts, const paperhandling_options& po);
+                static void apply(twain_source& ts, const imagetype_options& io);
                 static void apply(twain_source& ts, file_transfer_options_ex& fo);
-                static void apply(twain_source& ts, compression_options& co);
-                static void apply(twain_source& ts, userinterface_options& ui);
-                static void apply(twain_source& ts, language_options& lo);
-                static void apply(twain_source& ts, deviceparams_options& dp);
-                static void apply(twain_source& ts, powermonitor_options& po);
-                static void apply(twain_source& ts, doublefeed_options& df);
-                static void apply(twain_source& ts, autoadjust_options& ao);
-                static void apply(twain_source& ts, barcodedetection_options& bo);
-                static void apply(twain_source& ts, patchcode_options& pc);
-                static void apply(twain_source& ts, autocapture_options& ac);
-                static void apply(twain_source& ts, imageinformation_options& io);
-                static void apply(twain_source& ts, imageparameter_options& io);
-                static void apply(twain_source& ts, audiblealarms_options& aa);
-                static void apply(twain_source& ts, deviceevent_options& dopt);
-                static void apply(twain_source& ts, resolution_options& ro);
-                static void apply(twain_source& ts, color_options& co);
-                static void apply(twain_source& ts, capnegotiation_options& co);
-                static void apply(twain_source& ts, micr_options& mo);
-                static void apply(twain_source& ts, imprinter_options& io);
-                static void apply(twain_source& ts, autoscanning_options& ao);
+                static void apply(twain_source& ts, const compression_options& co);
+                static void apply(twain_source& ts, const userinterface_options& ui);
+                static void apply(twain_source& ts, const language_options& lo);
+                static void apply(twain_source& ts, const deviceparams_options& dp);
+                static void apply(twain_source& ts, const powermonitor_options& po);
+                static void apply(twain_source& ts, const doublefeed_options& df);
+                static void apply(twain_source& ts, const autoadjust_options& ao);
+                static void apply(twain_source& ts, const barcodedetection_options& bo);
+                static void apply(twain_source& ts, const patchcode_options& pc);
+                static void apply(twain_source& ts, const autocapture_options& ac);
+                static void apply(twain_source& ts, const imageinformation_options& io);
+                static void apply(twain_source& ts, const imageparameter_options& io);
+                static void apply(twain_source& ts, const audiblealarms_options& aa);
+                static void apply(twain_source& ts, const deviceevent_options& dopt);
+                static void apply(twain_source& ts, const resolution_options& ro);
+                static void apply(twain_source& ts, const color_options& co);
+                static void apply(twain_source& ts, const capnegotiation_options& co);
+                static void apply(twain_source& ts, const micr_options& mo);
+                static void apply(twain_source& ts, const imprinter_options& io);
+                static void apply(twain_source& ts, const autoscanning_options& ao);
         };
     }
 }
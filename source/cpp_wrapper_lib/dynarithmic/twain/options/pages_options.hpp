@@ -22,6 +22,7 @@ OF THIRD PARTY RIGHTS.
 #define DTWAIN_PAGES_OPTIONS_HPP
 
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/types/twain_frame.hpp>
 #include <dynarithmic/twain/twain_values.hpp>
 
@@ -69,6 +70,7 @@ namespace dynarithmic
                     return affected_caps;
                 }
 
+                auto as_tuple() const noexcept { return std::tie(m_SegmentedValue, m_Frame, m_MaxFrames, m_SupportedSize); }
         };
     }
 }
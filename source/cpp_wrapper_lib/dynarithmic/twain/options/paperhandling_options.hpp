@@ -25,6 +25,7 @@ OF THIRD PARTY RIGHTS.
 #include <iterator>
 #include <algorithm>
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/types/twain_types.hpp>
 #include <dynarithmic/twain/twain_values.hpp>
 
@@ -143,6 +144,13 @@ namespace dynarithmic
                     std::copy(c.begin(), c.end(), std::back_inserter(m_vFeederPocket));
                     return *this;
                 }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_bAutoFeed, m_bDuplexEnabled, m_FeederAlignment, m_bFeederEnabled, m_FeederOrder,
+                                    m_vFeederPocket, m_bFeederPrep, m_vPaperHandling, m_FeederType, m_feeder_waittime,
+                                    m_FeederMode, m_DuplexModeValue);
+                }
         };
     }
 }
@@ -26,6 +26,7 @@ OF THIRD PARTY RIGHTS.
 #include <array>
 #include <iterator>
 #include <algorithm>
+#include <tuple>
 
 #include <dynarithmic/twain/twain_values.hpp>
 
@@ -94,6 +95,11 @@ namespace dynarithmic
                     return affected_caps;
                 }
 
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_bDetectionEnabled, m_MaxRetries, m_MaxSearchPriorities, m_SearchMode, m_vSearchPriority,
+                                    m_TimeOut);
+                }
         };
     }
 }
@@ -26,6 +26,7 @@ OF THIRD PARTY RIGHTS.
 #include <string>
 #include <random>
 #include <utility>
+#include <tuple>
 
 #include <dynarithmic/twain/twain_values.hpp>
 #include <dynarithmic/twain/types/twain_capbasics.hpp>
@@ -182,6 +183,12 @@ namespace dynarithmic
 
                        int32_t get_permissions_int() const { return m_permissions; }
                        bool is_permission_set(pdf_permission perm) const { return (m_permissions & static_cast<int32_t>(perm)) ? true : false; }
+
+                       auto as_tuple() const noexcept
+                       {
+                           return std::tie(m_user_password, m_owner_password, m_useStrong, m_useEncryption, m_useAES128Encryption,
+                                           m_useAES256Encryption, m_bAutoGenPassword, m_permissions);
+                       }
                 };
 
                 pdf_encryption_options m_encryptOptions;
@@ -210,6 +217,8 @@ namespace dynarithmic
                         pdf_paper_size_custom get_custom_option() const { return m_size_opt; }
                         custom_size_type get_custom_size() const { return m_pagesize_custom; }
                         bool is_custom_size_used() const { return m_pagesize_custom.first != default_size && m_pagesize_custom.second != default_size; }
+
+                        auto as_tuple() const noexcept { return std::tie(m_pagesize, m_pagesize_custom, m_size_opt); }
                 };
 
                 pdf_page_size_options m_size_options;
@@ -234,6 +243,8 @@ namespace dynarithmic
                         pdf_page_scale get_page_scale() const { return m_pagescale; }
                         custom_scale_type get_custom_scale() const { return m_pagescale_custom; }
                         bool is_custom_scale_used() const { return m_pagescale_custom.first != default_scale && m_pagescale_custom.second != default_scale; }
+
+                        auto as_tuple() const noexcept { return std::tie(m_pagescale, m_pagescale_custom); }
                 };
 
                 pdf_page_scale_options m_scale_options;
@@ -250,8 +261,11 @@ namespace dynarithmic
                 pdf_options& set_orientation(pdf_orientation orient) { m_orientation = orient; return *this; }
 
                 pdf_encryption_options& get_encryption_options() { return m_encryptOptions; }
+                const pdf_encryption_options& get_encryption_options() const noexcept { return m_encryptOptions; }
                 pdf_page_size_options& get_page_size_options() { return m_size_options; }
+                const pdf_page_size_options& get_page_size_options() const noexcept { return m_size_options; }
                 pdf_page_scale_options& get_page_scale_options() { return m_scale_options; }
+                const pdf_page_scale_options& get_page_scale_options() const noexcept { return m_scale_options; }
 
                 std::string get_author() const { return m_author; }
                 std::string get_creator() const { return m_creator; }
@@ -262,6 +276,12 @@ namespace dynarithmic
                 bool is_use_ASCII() const { return m_useASCII; }
                 int get_jpeg_quality() const { return m_jpegQuality; }
                 pdf_orientation get_orientation() const { return m_orientation; }
+
+                auto as_tuple() const noexcept
+                {
+                    return std::tie(m_author, m_creator, m_producer, m_keywords, m_subject, m_title, m_useASCII, m_jpegQuality,
+                                    m_orientation, m_encryptOptions, m_size_options, m_scale_options);
+                }
         };
     }
 }
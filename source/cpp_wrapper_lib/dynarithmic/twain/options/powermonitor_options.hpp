@@ -22,6 +22,7 @@ OF THIRD PARTY RIGHTS.
 #define DTWAIN_POWERMONITOR_OPTIONS_HPP
 
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -46,6 +47,8 @@ namespace dynarithmic
                                                                     CAP_POWERSUPPLY };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept { return std::tie(m_powersavetime); }
         };
     }
 }
@@ -24,6 +24,7 @@ OF THIRD PARTY RIGHTS.
 
 #include <vector>
 #include <array>
+#include <tuple>
 #include <dynarithmic/twain/twain_values.hpp>
 
 namespace dynarithmic
@@ -55,6 +56,8 @@ namespace dynarithmic
                     static std::array<uint16_t, 2> affected_caps = { ICAP_XRESOLUTION, ICAP_YRESOLUTION };
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept { return std::tie(m_xResolution, m_yResolution); }
         };
     }
 }
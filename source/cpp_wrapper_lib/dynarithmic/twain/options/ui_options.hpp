@@ -26,6 +26,7 @@ OF THIRD PARTY RIGHTS.
 #include <iterator>
 #include <algorithm>
 #include <array>
+#include <tuple>
 
 #include <dynarithmic/twain/twain_values.hpp>
 
@@ -72,6 +73,8 @@ namespace dynarithmic
                                                                     CAP_UICONTROLLABLE};
                     return affected_caps;
                 }
+
+                auto as_tuple() const noexcept { return std::tie(m_bShowUI, m_bShowUI_Only, m_bShowIndicators, m_vIndicatorMode); }
         };
     }
 }
@@ -0,0 +1,99 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_SOURCE_DETAILS_CACHE_HPP
+#define DTWAIN_SOURCE_DETAILS_CACHE_HPP
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Keeps the details (see twain_session::get_source_details()) of each TWAIN device across runs.
+        ///
+        /// Getting the details of a device loads the driver and queries each of its capabilities, which can take several
+        /// seconds for some devices.  The details are stored by the device key (see capability_failure_store::make_device_key()),
+        /// so a driver update is not served from the cache.
+        class source_details_cache
+        {
+            mutable std::mutex m_mutex;
+            std::string m_strFile;
+            std::map<std::string, std::string> m_details;
+            bool m_bModified = false;
+
+            public:
+                source_details_cache& set_file(std::string file)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_strFile = std::move(file);
+                    return *this;
+                }
+
+                std::string get_file() const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_strFile;
+                }
+
+                /// Reads the details from the file.  A missing file is not an error.
+                bool load();
+
+                /// Writes the details to the file if any were added since the file was loaded
+                bool save();
+
+                /// Returns true if the details of **device** are in the cache, and sets **details**
+                bool find(const std::string& device, std::string& details) const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto iter = m_details.find(device);
+                    if (iter == m_details.end())
+                        return false;
+                    details = iter->second;
+                    return true;
+                }
+
+                void add(const std::string& device, std::string details)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_details[device] = std::move(details);
+                    m_bModified = true;
+                }
+
+                void clear()
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_bModified = m_bModified || !m_details.empty();
+                    m_details.clear();
+                }
+
+                std::size_t size() const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_details.size();
+                }
+        };
+    }
+}
+#endif
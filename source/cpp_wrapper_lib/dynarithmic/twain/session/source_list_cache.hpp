@@ -0,0 +1,86 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_SOURCE_LIST_CACHE_HPP
+#define DTWAIN_SOURCE_LIST_CACHE_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <dynarithmic/twain/identity/twain_identity.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Keeps the list of installed TWAIN devices across runs.
+        ///
+        /// Listing the devices (see twain_session::get_all_source_info()) makes the Data Source Manager load every
+        /// installed driver.  The list is saved with a fingerprint of the TWAIN driver directories (the name, size and
+        /// modification time of each .ds file, and the modification time of each directory), so a later run can use the
+        /// saved list if no driver was added, removed or updated, by only reading the directories.
+        class source_list_cache
+        {
+            std::string m_strFile;
+            std::string m_fingerprint;
+            std::vector<twain_identity> m_sources;
+
+            public:
+                source_list_cache& set_file(std::string file) { m_strFile = std::move(file); return *this; }
+                const std::string& get_file() const noexcept { return m_strFile; }
+
+                /// Returns the fingerprint of the directories that the TWAIN Data Source Manager loads drivers from
+                /// (%WINDIR%\twain_32 or %WINDIR%\twain_64, depending on the build).
+                static std::string get_directory_fingerprint();
+
+                /// Reads the list from the file.  Returns false if the file is missing or damaged.
+                bool load();
+
+                /// Writes the list to the file
+                bool save() const;
+
+                /// Returns true if the list was loaded and the driver directories did not change since it was saved
+                bool is_current() const { return !m_fingerprint.empty() && m_fingerprint == get_directory_fingerprint(); }
+
+                /// Sets the list.  **fingerprint** should be obtained (by get_directory_fingerprint()) before the
+                /// devices are listed, so that a driver installed while listing makes the list out of date.
+                source_list_cache& set_sources(std::vector<twain_identity> vSources, std::string fingerprint)
+                {
+                    m_sources = std::move(vSources);
+                    m_fingerprint = std::move(fingerprint);
+                    return *this;
+                }
+
+                const std::vector<twain_identity>& get_sources() const noexcept { return m_sources; }
+
+                /// Returns true if a device with the product name **productName** is in the list
+                bool contains(const std::string& productName) const
+                {
+                    for (auto& source : m_sources)
+                    {
+                        if (source.get_product_name() == productName)
+                            return true;
+                    }
+                    return false;
+                }
+        };
+    }
+}
+#endif
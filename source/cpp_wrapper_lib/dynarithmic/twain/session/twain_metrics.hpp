@@ -0,0 +1,124 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_TWAIN_METRICS_HPP
+#define DTWAIN_TWAIN_METRICS_HPP
+
+#include <chrono>
+#include <string>
+#include <dtwain.h>
+#include <dynarithmic/twain/utilities/metrics_registry.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// The operational metrics of the TWAIN sessions in this process, kept in the metrics_registry.
+        ///
+        /// The metrics are always updated (each update is one relaxed atomic operation), and can be exported with a
+        /// metrics_exporter:
+        ///  - twain_pages_scanned_total, twain_pages_per_minute, twain_pages_in_flight (transferred or being transferred, and
+        ///    not yet saved)
+        ///  - twain_acquisitions_total, twain_feeder_wait_seconds_total
+        ///  - twain_capability_failures_total (capability gets and sets the device failed)
+        ///  - twain_errors_total, with a "code" label for each DTWAIN_ERR_xxx error reported by DTWAIN
+        class twain_metrics
+        {
+            metrics_registry::metric& m_pages;
+            metrics_registry::metric& m_pages_in_flight;
+            metrics_registry::metric& m_acquisitions;
+            metrics_registry::metric& m_feeder_wait;
+            metrics_registry::metric& m_cap_failures;
+
+            twain_metrics() :
+                m_pages(metrics_registry::instance().get_counter("twain_pages_scanned_total", "Pages transferred from the device")),
+                m_pages_in_flight(metrics_registry::instance().get_gauge("twain_pages_in_flight", "Pages being transferred or not yet saved")),
+                m_acquisitions(metrics_registry::instance().get_counter("twain_acquisitions_total", "Acquisitions started")),
+                m_feeder_wait(metrics_registry::instance().get_counter("twain_feeder_wait_seconds_total", "Time spent waiting for the feeder to be loaded", "", 1e-6)),
+                m_cap_failures(metrics_registry::instance().get_counter("twain_capability_failures_total", "Capability gets and sets that failed"))
+            {
+                metrics_registry::instance().add_rate("twain_pages_per_minute", "Pages transferred per minute since the last export", m_pages, 60.0);
+            }
+
+            public:
+                static twain_metrics& instance()
+                {
+                    static twain_metrics metrics;
+                    return metrics;
+                }
+
+                twain_metrics(const twain_metrics&) = delete;
+                twain_metrics& operator=(const twain_metrics&) = delete;
+
+                /// Called for each DTWAIN notification sent to the session's callback
+                void on_notification(LONG notification)
+                {
+                    switch (notification)
+                    {
+                        case DTWAIN_TN_ACQUIRESTARTED:
+                            m_acquisitions.increment();
+                        break;
+
+                        case DTWAIN_TN_TRANSFERREADY:
+                            m_pages_in_flight.increment();
+                        break;
+
+                        case DTWAIN_TN_TRANSFERDONE:
+                            m_pages.increment();
+                        break;
+
+                        case DTWAIN_TN_TRANSFERCANCELLED:
+                        case DTWAIN_TN_TRANSFERSTRIPFAILED:
+                        case DTWAIN_TN_FILEPAGESAVEOK:
+                        case DTWAIN_TN_FILEPAGESAVEERROR:
+                        case DTWAIN_TN_FILESAVEOK:
+                        case DTWAIN_TN_FILESAVEERROR:
+                        case DTWAIN_TN_FILESAVECANCELLED:
+                            if (m_pages_in_flight.get() > 0)
+                                m_pages_in_flight.decrement();
+                        break;
+
+                        case DTWAIN_TN_ACQUIREDONE:
+                        case DTWAIN_TN_ACQUIREFAILED:
+                        case DTWAIN_TN_ACQUIRECANCELLED:
+                        case DTWAIN_TN_ACQUIRETERMINATED:
+                            m_pages_in_flight.set(0);
+                        break;
+                    }
+                }
+
+                /// Called for each error reported by DTWAIN.  Errors are rare, so the labelled counter is looked up here.
+                void on_error(LONG error)
+                {
+                    metrics_registry::instance().get_counter("twain_errors_total", "Errors reported by DTWAIN, by DTWAIN_ERR_xxx code",
+                                                             "code=\"" + std::to_string(error) + "\"").increment();
+                }
+
+                void on_capability_failure() { m_cap_failures.increment(); }
+
+                template <typename Rep, typename Period>
+                void on_feeder_wait(std::chrono::duration<Rep, Period> elapsed)
+                {
+                    m_feeder_wait.increment(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+                }
+        };
+    }
+}
+#endif
@@ -45,6 +45,7 @@ OF THIRD PARTY RIGHTS.
 #include <dynarithmic/twain/characteristics/twain_select_dialog.hpp>
 #include <dynarithmic/twain/logging/error_logger.hpp>
 #include <dynarithmic/twain/logging/twain_logger.hpp>
+#include <dynarithmic/twain/session/twain_statistics.hpp>
 #include <dynarithmic/twain/dtwain_twain.hpp>
 #include <dynarithmic/twain/twain_values.hpp>
 #include <dynarithmic/twain/types/twain_callback.hpp>
@@ -303,12 +304,14 @@ namespace dynarithmic
             twain_characteristics m_twain_characteristics;
             bool m_bStarted = false;
             bool m_bOCRStarted = false;
+            bool m_bOCRInitialized = false;
             bool m_bTripletsNotify = false;
-            std::string m_dsm_path;
-            std::string m_long_name;
-            std::string m_short_name;
-            std::string m_dtwain_path;
-            std::string m_version_copyright;
+            mutable optional_type_<std::string> m_dsm_path;
+            mutable optional_type_<std::string> m_long_name;
+            mutable optional_type_<std::string> m_short_name;
+            mutable optional_type_<std::string> m_dtwain_path;
+            mutable optional_type_<std::string> m_version_copyright;
+            std::string m_loaded_language;
             DTWAIN_HANDLE m_Handle = nullptr;
             logger_type m_logger;
             callback_map_type m_mapcallback;
@@ -339,6 +342,7 @@ namespace dynarithmic
                 friend twain_source;
                 error_logger m_error_logger;
                 twain_logger m_dummy_logger;
+                twain_statistics m_statistics;
                 mutable std::vector<supported_filetype_info> m_singlepage_filetype_cache;
                 mutable std::vector<supported_filetype_info> m_multipage_filetype_cache;
 
@@ -349,6 +353,11 @@ namespace dynarithmic
                 static LRESULT CALLBACK error_callback_proc(LONG error, LONG64 UserData);
 
                 bool start(bool bCleanStart);
+                bool start_ocr();
+                bool load_language_resources(const std::string& language);
+                void clear_session_info();
+                const std::string& get_session_info(optional_type_<std::string>& value, bool bAvailable,
+                                                    const std::function<std::string()>& getFn) const;
                 void update_source_status(const twain_source& ts);
 
                 template <typename SourceSelector>
@@ -528,37 +537,47 @@ namespace dynarithmic
                 /// will return "TWPT_BW", since the TWAIN names that start with TWPT,
                 /// such as TWPT_BW has the value of 0 (see twain.h for verification).
                 ///
+                /// The names are looked up in the tables generated from twain.h (see twain_constant_names::find(), which does
+                /// not allocate), and the DTWAIN library is only called for constants that are not in twain.h.
+                ///
                 /// @returns A string version of the TWAIN constant name
                 static std::string get_twain_name(twain_constant_category twain_category, int32_t twain_constant);
 
                 error_logger& get_error_logger() noexcept { return m_error_logger; }
 
+                /// Returns the timing statistics for this session
+                ///
+                /// The statistics are not gathered unless enabled by calling get_statistics().enable() before the TWAIN session is started.
+                /// @returns reference to the twain_statistics object for this session.
+                twain_statistics& get_statistics() noexcept { return m_statistics; }
+                const twain_statistics& get_statistics() const noexcept { return m_statistics; }
+
                 twain_characteristics& get_twain_characteristics() { return m_twain_characteristics; }
 
                 /// Returns a short string that identifies the name of the Dynarithmic TWAIN Library version
                 ///
                 /// @returns a string that identifies the version of the underlying DTWAIN library in use.
-                std::string get_short_version_name() const  noexcept { return m_short_name; }
+                std::string get_short_version_name() const noexcept;
 
                 /// Returns a int32_t version string that identifies the name of the Dynarithmic TWAIN Library version
                 ///
                 /// @returns a int32_t version string that identifies the version of the underlying DTWAIN library in use.
-                std::string get_long_version_name() const noexcept { return m_long_name; }
+                std::string get_long_version_name() const noexcept;
 
                 /// Returns a short string that identifies the version and copyright of the Dynarithmic TWAIN Library version
                 ///
                 /// @returns a string that identifies the version and copyright of the underlying DTWAIN library in use.
-                std::string get_version_copyright() const  noexcept { return m_version_copyright; }
+                std::string get_version_copyright() const noexcept;
 
                 /// Returns the full path of the TWAIN Data Source Manager in use.
                 ///
                 /// @returns string that identifies the path of the TWAIN Data Source Manager
-                std::string get_dsm_path() const noexcept { return m_dsm_path; }
+                std::string get_dsm_path() const noexcept;
 
                 /// Returns the full path of the DTWAIN shared library being utilized.
                 ///
                 /// @returns Full path of the DTWAIN shared library being utilized.
-                std::string get_dtwain_path() const noexcept { return m_dtwain_path; }
+                std::string get_dtwain_path() const noexcept;
 
                 /// Registers a twain_callback object with a TWAIN source for this TWAIN session.
                 ///
@@ -773,6 +792,8 @@ namespace dynarithmic
                         return source_select_info();
                     }
                 }
+                if (std::is_same<SourceFn, source_functions_ocr>::value && !start_ocr())
+                    return source_select_info();
                 bool isCanceled = false;
                 typename SourceFn::value_type ret = nullptr;
                 if (static_cast<int>(selector.value) == static_cast<int>(select_type::use_dialog))
@@ -882,6 +903,10 @@ namespace dynarithmic
 
             std::string get_details(const std::vector<std::string>& container, details_info info = { true, 2 });
             std::string get_details(details_info info = { true, 2 });
+
+            /// Returns the details (in JSON format) of the TWAIN device named **productName**.  The device does not have
+            /// to be selected or opened.  Unlike get_details(), the result is not kept by the session.
+            std::string get_source_details(const std::string& productName, details_info info = { true, 2 });
             source_status get_source_status(const twain_source& ts);
             source_status get_source_status(std::string prodName);
             int get_twain_constant(std::string twainName);
@@ -896,7 +921,8 @@ namespace dynarithmic
             }
             logger_type& get_logger_type() noexcept { return m_logger; }
 
-            bool is_ocr_available() { return m_bOCRStarted; }
+            /// Returns **true** if OCR engines can be used.  The OCR interface is started on the first call.
+            bool is_ocr_available() { return start_ocr(); }
         };
     }
 }
@@ -0,0 +1,382 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_TWAIN_STATISTICS_HPP
+#define DTWAIN_TWAIN_STATISTICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dtwain.h>
+#include <dynarithmic/twain/logging/trace_recorder.hpp>
+#include <dynarithmic/twain/types/latency_histogram.hpp>
+#include <dynarithmic/twain/utilities/memory_tracker.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Timing statistics for a TWAIN session.
+        ///
+        /// When enabled, the twain_session and twain_source classes record how long each stage of the session and of each
+        /// acquisition takes.  Per-page timings are taken from the DTWAIN transfer and file save notifications.  Use
+        /// twain_session::get_statistics() to access the statistics.
+        ///
+        /// Enabling the statistics also enables the memory_tracker, so that the memory high-water marks of each stage and
+        /// each acquisition are available from get_memory_usage() and get_job_memory_usage().
+        ///
+        /// @note The per-page tracking state is only updated on the thread that runs the acquisition.  Read the statistics
+        /// after the acquisition has completed.
+        class twain_statistics
+        {
+            public:
+                enum class stage
+                {
+                    session_start,      // twain_session::start()
+                    ocr_start,          // starting the OCR interface, the first time OCR is used
+                    source_open,        // twain_source::open(), including the capability query
+                    fill_caps,          // querying the supported capabilities when a source is attached
+                    start_apply,        // applying the acquire_characteristics to the device
+                    acquire_prepare,    // all preparation done in twain_source::acquire() (includes start_apply)
+                    feeder_wait,        // waiting for the feeder to be loaded
+                    device_start,       // from the start of the acquisition to the first page being ready
+                    page_transfer,      // from "transfer ready" to "transfer done" for each page
+                    page_save,          // saving each page to the file
+                    page_interval,      // time between consecutive pages being transferred
+                    first_page,         // from twain_source::acquire() being called to the first page being transferred
+                    acquire_total,      // the whole of twain_source::acquire()
+                    source_close,       // twain_source::close()
+                    session_stop,       // twain_session::stop()
+                    stage_count
+                };
+
+                static constexpr std::size_t stage_count = static_cast<std::size_t>(stage::stage_count);
+
+                /// Breakdown of the time it took to transfer and save the first page of the last acquisition, in microseconds
+                struct first_page_breakdown
+                {
+                    uint64_t prepare = 0;
+                    uint64_t feeder_wait = 0;
+                    uint64_t device_start = 0;
+                    uint64_t transfer = 0;
+                    uint64_t save = 0;
+                    uint64_t total = 0;
+                };
+
+                /// Records the time taken from construction to destruction as one sample of a stage, and tracks the memory
+                /// high-water mark of the stage.
+                ///
+                /// If the trace_recorder is enabled, the stage is also added to the trace.
+                class scoped_timer
+                {
+                    twain_statistics* m_stats;
+                    stage m_stage;
+                    std::chrono::steady_clock::time_point m_start;
+                    bool m_bTrace;
+                    uint64_t m_trace_start;
+                    public:
+                        scoped_timer(twain_statistics& stats, stage st) : scoped_timer(&stats, st) {}
+
+                        /// Constructs a timer that only traces (if tracing is enabled) if **stats** is null
+                        scoped_timer(twain_statistics* stats, stage st) :
+                            m_stats(stats && stats->is_enabled() ? stats : nullptr), m_stage(st), m_start(std::chrono::steady_clock::now()),
+                            m_bTrace(trace_recorder::instance().is_enabled()),
+                            m_trace_start(m_bTrace ? trace_recorder::instance().now() : 0)
+                        {
+                            if (m_stats)
+                                memory_tracker::instance().stage_begin(static_cast<std::size_t>(m_stage));
+                        }
+                        scoped_timer(const scoped_timer&) = delete;
+                        scoped_timer& operator=(const scoped_timer&) = delete;
+                        ~scoped_timer()
+                        {
+                            if (m_stats)
+                            {
+                                m_stats->record(m_stage, std::chrono::steady_clock::now() - m_start);
+                                memory_tracker::instance().stage_end(static_cast<std::size_t>(m_stage));
+                            }
+                            if (m_bTrace)
+                            {
+                                auto& recorder = trace_recorder::instance();
+                                recorder.complete(trace_recorder::category::stage, get_stage_name(m_stage), m_trace_start, recorder.now() - m_trace_start);
+                            }
+                        }
+                };
+
+            private:
+                using clock_type = std::chrono::steady_clock;
+                std::atomic<bool> m_bEnabled{ false };
+                std::array<latency_histogram, stage_count> m_histograms;
+
+                clock_type::time_point m_acquire_begin;
+                clock_type::time_point m_transfer_begin;
+                clock_type::time_point m_transfer_ready;
+                clock_type::time_point m_last_page_done;
+                clock_type::time_point m_save_begin;
+                uint64_t m_pages_this_acquire = 0;
+                uint64_t m_total_pages = 0;
+                uint64_t m_total_acquire_time = 0;
+                bool m_bInAcquire = false;
+                bool m_bSavePending = false;
+                bool m_bFirstSaveDone = false;
+                first_page_breakdown m_current_first_page;
+                first_page_breakdown m_first_page;
+
+                static uint64_t to_micro(clock_type::duration d)
+                {
+                    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+                }
+
+            public:
+                static const char* get_stage_name(stage st)
+                {
+                    static constexpr std::array<const char*, stage_count> names = {
+                        "session start", "ocr start", "source open", "fill caps", "start apply", "acquire prepare", "feeder wait",
+                        "device start", "page transfer", "page save", "page interval", "time to first page", "acquire total",
+                        "source close", "session stop" };
+                    return names[static_cast<std::size_t>(st)];
+                }
+
+                twain_statistics& enable(bool bEnable = true)
+                {
+                    m_bEnabled.store(bEnable, std::memory_order_relaxed);
+                    memory_tracker::instance().enable(bEnable);
+                    return *this;
+                }
+                bool is_enabled() const { return m_bEnabled.load(std::memory_order_relaxed); }
+
+                template <typename Rep, typename Period>
+                void record(stage st, std::chrono::duration<Rep, Period> elapsed)
+                {
+                    if (is_enabled())
+                        m_histograms[static_cast<std::size_t>(st)].record(elapsed);
+                }
+
+                const latency_histogram& get_histogram(stage st) const { return m_histograms[static_cast<std::size_t>(st)]; }
+
+                /// Returns the total number of pages transferred in all acquisitions
+                uint64_t get_page_count() const { return m_total_pages; }
+
+                /// Returns the number of pages transferred per second, measured over the time spent in twain_source::acquire()
+                double get_pages_per_second() const
+                {
+                    return m_total_acquire_time ? static_cast<double>(m_total_pages) * 1000000.0 / static_cast<double>(m_total_acquire_time) : 0.0;
+                }
+
+                /// Returns the time-to-first-page breakdown of the most recent acquisition that transferred a page
+                const first_page_breakdown& get_first_page_breakdown() const { return m_first_page; }
+
+                /// Returns the memory high-water marks while **st** was running
+                memory_tracker::usage get_memory_usage(stage st) const
+                {
+                    return memory_tracker::instance().get_stage_usage(static_cast<std::size_t>(st));
+                }
+
+                /// Returns the memory high-water marks of each acquisition
+                std::vector<memory_tracker::usage> get_job_memory_usage() const { return memory_tracker::instance().get_job_usage(); }
+
+                void reset()
+                {
+                    for (auto& h : m_histograms)
+                        h.reset();
+                    m_pages_this_acquire = m_total_pages = m_total_acquire_time = 0;
+                    m_bInAcquire = m_bSavePending = m_bFirstSaveDone = false;
+                    m_current_first_page = m_first_page = {};
+                    memory_tracker::instance().reset();
+                }
+
+                /// Called when twain_source::acquire() starts
+                void acquire_begin()
+                {
+                    if (!is_enabled())
+                        return;
+                    m_acquire_begin = m_last_page_done = m_transfer_begin = clock_type::now();
+                    m_pages_this_acquire = 0;
+                    m_current_first_page = {};
+                    m_bInAcquire = true;
+                    m_bSavePending = m_bFirstSaveDone = false;
+                    auto& memory = memory_tracker::instance();
+                    memory.job_begin();
+                    memory.stage_begin(static_cast<std::size_t>(stage::acquire_total));
+                }
+
+                /// Called when the preparation (including any feeder wait) is done, and the device is about to be started
+                void acquire_transfer_begin(uint64_t prepare_time, uint64_t feeder_time)
+                {
+                    if (!is_enabled() || !m_bInAcquire)
+                        return;
+                    m_transfer_begin = m_last_page_done = clock_type::now();
+                    m_current_first_page.prepare = prepare_time;
+                    m_current_first_page.feeder_wait = feeder_time;
+                }
+
+                /// Called when twain_source::acquire() ends
+                void acquire_end()
+                {
+                    if (!is_enabled() || !m_bInAcquire)
+                        return;
+                    const auto elapsed = clock_type::now() - m_acquire_begin;
+                    record(stage::acquire_total, elapsed);
+                    m_total_acquire_time += to_micro(elapsed);
+                    m_total_pages += m_pages_this_acquire;
+                    if (m_pages_this_acquire > 0)
+                        m_first_page = m_current_first_page;
+                    m_bInAcquire = false;
+                    auto& memory = memory_tracker::instance();
+                    memory.stage_end(static_cast<std::size_t>(stage::page_transfer));
+                    memory.stage_end(static_cast<std::size_t>(stage::page_save));
+                    memory.stage_end(static_cast<std::size_t>(stage::acquire_total));
+                    memory.job_end();
+                }
+
+                /// Called for each DTWAIN notification sent to the session's callback
+                void on_notification(LONG notification)
+                {
+                    if (!is_enabled() || !m_bInAcquire)
+                        return;
+                    const auto now = clock_type::now();
+                    auto& memory = memory_tracker::instance();
+                    switch (notification)
+                    {
+                        case DTWAIN_TN_TRANSFERREADY:
+                            m_transfer_ready = now;
+                            // pages that are not saved to a file are in the page_save stage until the next page
+                            memory.stage_end(static_cast<std::size_t>(stage::page_save));
+                            memory.stage_begin(static_cast<std::size_t>(stage::page_transfer));
+                            if (m_pages_this_acquire == 0)
+                            {
+                                m_current_first_page.device_start = to_micro(now - m_transfer_begin);
+                                record(stage::device_start, now - m_transfer_begin);
+                            }
+                        break;
+
+                        case DTWAIN_TN_TRANSFERDONE:
+                            record(stage::page_transfer, now - m_transfer_ready);
+                            memory.stage_end(static_cast<std::size_t>(stage::page_transfer));
+                            memory.stage_begin(static_cast<std::size_t>(stage::page_save));
+                            record(stage::page_interval, now - m_last_page_done);
+                            if (m_pages_this_acquire == 0)
+                            {
+                                m_current_first_page.transfer = to_micro(now - m_transfer_ready);
+                                m_current_first_page.total = to_micro(now - m_acquire_begin);
+                                record(stage::first_page, now - m_acquire_begin);
+                            }
+                            ++m_pages_this_acquire;
+                            m_last_page_done = m_save_begin = now;
+                            m_bSavePending = true;
+                        break;
+
+                        case DTWAIN_TN_FILEPAGESAVING:
+                            m_save_begin = now;
+                            m_bSavePending = true;
+                            memory.stage_begin(static_cast<std::size_t>(stage::page_save));
+                        break;
+
+                        case DTWAIN_TN_FILEPAGESAVEOK:
+                        case DTWAIN_TN_FILESAVEOK:
+                        case DTWAIN_TN_FILEPAGESAVEERROR:
+                        case DTWAIN_TN_FILESAVEERROR:
+                            if (m_bSavePending)
+                            {
+                                record(stage::page_save, now - m_save_begin);
+                                if (!m_bFirstSaveDone)
+                                {
+                                    m_current_first_page.save = to_micro(now - m_save_begin);
+                                    m_bFirstSaveDone = true;
+                                }
+                                m_bSavePending = false;
+                            }
+                            memory.stage_end(static_cast<std::size_t>(stage::page_save));
+                        break;
+                    }
+                }
+
+                /// Returns a text report of the statistics, with all times in milliseconds
+                std::string get_report() const
+                {
+                    const auto ms = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+                    std::ostringstream strm;
+                    strm << std::fixed << std::setprecision(3);
+                    strm << std::left << std::setw(20) << "Stage" << std::right << std::setw(8) << "Count" << std::setw(14) << "Total(ms)"
+                         << std::setw(12) << "Mean(ms)" << std::setw(12) << "p50(ms)" << std::setw(12) << "p99(ms)" << std::setw(12) << "Max(ms)" << "\n";
+                    for (std::size_t i = 0; i < stage_count; ++i)
+                    {
+                        const auto& h = m_histograms[i];
+                        if (h.get_count() == 0)
+                            continue;
+                        strm << std::left << std::setw(20) << get_stage_name(static_cast<stage>(i)) << std::right << std::setw(8) << h.get_count()
+                             << std::setw(14) << ms(h.get_total()) << std::setw(12) << h.get_mean() / 1000.0
+                             << std::setw(12) << ms(h.get_percentile(50.0)) << std::setw(12) << ms(h.get_percentile(99.0))
+                             << std::setw(12) << ms(h.get_max()) << "\n";
+                    }
+                    strm << "\nPages transferred: " << m_total_pages << "\n";
+                    strm << "Pages per second: " << get_pages_per_second() << "\n";
+                    const auto& pt = m_histograms[static_cast<std::size_t>(stage::page_transfer)];
+                    if (pt.get_count() > 0)
+                        strm << "Per-page transfer latency: p50 = " << ms(pt.get_percentile(50.0)) << " ms, p99 = " << ms(pt.get_percentile(99.0)) << " ms\n";
+                    if (m_first_page.total > 0)
+                    {
+                        strm << "Time to first page: " << ms(m_first_page.total) << " ms"
+                             << " (prepare " << ms(m_first_page.prepare)
+                             << ", feeder wait " << ms(m_first_page.feeder_wait)
+                             << ", device start " << ms(m_first_page.device_start)
+                             << ", transfer " << ms(m_first_page.transfer)
+                             << ", save " << ms(m_first_page.save) << ")\n";
+                    }
+                    strm << get_memory_report();
+                    return strm.str();
+                }
+
+                /// Returns a text report of the memory high-water marks, in megabytes
+                std::string get_memory_report() const
+                {
+                    const auto mb = [](uint64_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+                    const auto& memory = memory_tracker::instance();
+                    std::ostringstream strm;
+                    strm << std::fixed << std::setprecision(2);
+                    const auto peak = memory.get_peak_usage();
+                    strm << "\nMemory high-water marks (MB): buffers " << mb(peak.tracked) << " (pages " << mb(memory.get_peak(memory_tracker::pool::page_buffer))
+                         << ", strips " << mb(memory.get_peak(memory_tracker::pool::strip_buffer))
+                         << ", image store " << mb(memory.get_peak(memory_tracker::pool::image_store)) << ")";
+                    if (peak.process > 0)
+                        strm << ", process " << mb(peak.process);
+                    strm << "\n";
+                    strm << std::left << std::setw(20) << "Stage" << std::right << std::setw(14) << "Buffers(MB)" << std::setw(14) << "Process(MB)" << "\n";
+                    for (std::size_t i = 0; i < stage_count; ++i)
+                    {
+                        const auto usage = memory.get_stage_usage(i);
+                        if (m_histograms[i].get_count() == 0 || (usage.tracked == 0 && usage.process == 0))
+                            continue;
+                        strm << std::left << std::setw(20) << get_stage_name(static_cast<stage>(i)) << std::right
+                             << std::setw(14) << mb(usage.tracked) << std::setw(14) << mb(usage.process) << "\n";
+                    }
+                    const auto jobs = memory.get_job_usage();
+                    for (std::size_t i = 0; i < jobs.size(); ++i)
+                        strm << "Acquisition " << i + 1 << ": buffers " << mb(jobs[i].tracked) << " MB, process " << mb(jobs[i].process) << " MB\n";
+                    return strm.str();
+                }
+        };
+    }
+}
+#endif
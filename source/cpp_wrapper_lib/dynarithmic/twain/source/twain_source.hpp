@@ -50,6 +50,8 @@ namespace dynarithmic
         class acquire_characteristics;
         class buffered_transfer_info;
         class file_transfer_info;
+        class capability_failure_store;
+        class device_profile;
         class capability_interface;
         class capability_listener;
         class twain_session;
@@ -108,10 +110,12 @@ namespace dynarithmic
                 std::vector<xfermech_value::value_type> m_vAllXferMechs;
                 extendedimage_info m_extImageInfo;
                 void create_interfaces();
+                void attach_cap_listener();
                 void get_source_info_internal();
                 void start_apply();
                 void prepare_acquisition();
                 void set_pdf_options();
+                void forget_acquisition_sets();
                 void swap(twain_source& left, twain_source& right) noexcept;
                 acquire_return_type acquire_to_file(transfer_type transtype);
                 acquire_return_type acquire_to_image_handles(transfer_type transtype);
@@ -126,8 +130,23 @@ namespace dynarithmic
                 twain_source& make_weak(bool isWeak = true);
                 void detach();
 
-                template <typename T>
-                void set_cap_listener(T& val);
+                /// Sets the listener that is informed of each capability get and set done through get_capability_interface()
+                twain_source& set_cap_listener(std::unique_ptr<capability_listener> listener);
+                capability_listener& get_cap_listener();
+
+                /// Sets the store of capability sets that the device has rejected.  Sets in the store are not sent to the
+                /// device, and sets the device rejects are added to it.  The store is not owned by the twain_source.
+                twain_source& set_cap_failure_store(capability_failure_store* store);
+
+                /// Sets the profile used by start_apply().  If the profile has sets for this device, they are sent instead of
+                /// the option groups of the acquire_characteristics.  Otherwise, the sets that start_apply() sends are recorded
+                /// into the profile.  The profile is not owned by the twain_source.
+                twain_source& set_device_profile(device_profile* profile);
+
+                /// If **bSkip** is true (the default), acquire() only sends the capability settings that changed since the
+                /// last acquisition of the open source.  Settings that the acquisition itself changes are always sent again,
+                /// and all settings are sent again after an acquisition that showed the device's user interface.
+                twain_source& set_skip_unchanged_settings(bool bSkip);
 
                 twain_identity get_source_info() const noexcept;
                 HANDLE get_current_image();
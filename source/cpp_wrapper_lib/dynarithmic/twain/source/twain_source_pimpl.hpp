@@ -39,6 +39,9 @@ namespace dynarithmic
                 std::unique_ptr<file_transfer_info>           m_filetransfer_info;
                 std::unique_ptr<capability_listener>          m_capability_listener;
                 mutable std::unique_ptr<capability_interface> m_capability_info;
+                capability_failure_store*                     m_capability_failure_store = nullptr;
+                device_profile*                               m_device_profile = nullptr;
+                bool                                          m_bSkipUnchangedSettings = true;
         };
     }
 }
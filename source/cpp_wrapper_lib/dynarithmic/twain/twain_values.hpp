@@ -34,6 +34,7 @@ OF THIRD PARTY RIGHTS.
 #include <vector>
 #include <string>
 #include <limits>
+#include <tuple>
 #include <dynarithmic/twain/tostring/tostring.hpp>
 #include <dynarithmic/twain/types/constexpr_utils.hpp>
 #include <dynarithmic/twain/types/eternal_map/include/mapbox/eternal.hpp>
@@ -1676,6 +1677,8 @@ namespace dynarithmic
                 multipage_save_options& set_save_incomplete(bool bSet = true) { m_save_incomplete = bSet; return *this; }
                 multipage_save_mode  get_save_mode() const { return m_save_mode; }
                 bool is_save_incomplete() const { return m_save_incomplete; }
+
+                auto as_tuple() const noexcept { return std::tie(m_save_mode, m_save_incomplete); }
         };
 
         // Information on various file types
@@ -0,0 +1,207 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_COW_PTR_HPP
+#define DTWAIN_COW_PTR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Hashes and compares the values held by a cow_ptr.
+        ///
+        /// By default, std::hash and operator== are used.  A class without these can instead provide a public
+        /// as_tuple() const function that returns std::tie() of all of its members, and the members are then hashed and
+        /// compared one by one (the option classes held by acquire_characteristics do this).  A member that is left out
+        /// of as_tuple() is not compared, so a class must list every member that is part of its value.  std::vector,
+        /// std::pair and std::tuple members are handled element by element, and members that are classes are handled
+        /// through their own cow_value_traits.
+        template <typename T, typename = void>
+        struct cow_value_traits
+        {
+            static std::size_t hash(const T& value) { return std::hash<T>()(value); }
+            static bool equal(const T& lhs, const T& rhs) { return lhs == rhs; }
+        };
+
+        inline void cow_hash_combine(std::size_t& seed, std::size_t value) noexcept
+        {
+            seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+
+        template <typename... Ts>
+        struct cow_value_traits<std::tuple<Ts...>>
+        {
+            static std::size_t hash(const std::tuple<Ts...>& value)
+            {
+                return hash_elements(value, std::index_sequence_for<Ts...>());
+            }
+
+            static bool equal(const std::tuple<Ts...>& lhs, const std::tuple<Ts...>& rhs)
+            {
+                return equal_elements(lhs, rhs, std::index_sequence_for<Ts...>());
+            }
+
+            private:
+                template <std::size_t... I>
+                static std::size_t hash_elements(const std::tuple<Ts...>& value, std::index_sequence<I...>)
+                {
+                    std::size_t result = 0;
+                    (cow_hash_combine(result, cow_value_traits<std::decay_t<Ts>>::hash(std::get<I>(value))), ...);
+                    return result;
+                }
+
+                template <std::size_t... I>
+                static bool equal_elements(const std::tuple<Ts...>& lhs, const std::tuple<Ts...>& rhs, std::index_sequence<I...>)
+                {
+                    return (cow_value_traits<std::decay_t<Ts>>::equal(std::get<I>(lhs), std::get<I>(rhs)) && ...);
+                }
+        };
+
+        template <typename T1, typename T2>
+        struct cow_value_traits<std::pair<T1, T2>>
+        {
+            static std::size_t hash(const std::pair<T1, T2>& value)
+            {
+                std::size_t result = cow_value_traits<T1>::hash(value.first);
+                cow_hash_combine(result, cow_value_traits<T2>::hash(value.second));
+                return result;
+            }
+
+            static bool equal(const std::pair<T1, T2>& lhs, const std::pair<T1, T2>& rhs)
+            {
+                return cow_value_traits<T1>::equal(lhs.first, rhs.first) && cow_value_traits<T2>::equal(lhs.second, rhs.second);
+            }
+        };
+
+        template <typename T, typename Alloc>
+        struct cow_value_traits<std::vector<T, Alloc>>
+        {
+            static std::size_t hash(const std::vector<T, Alloc>& value)
+            {
+                std::size_t result = value.size();
+                for (auto& element : value)
+                    cow_hash_combine(result, cow_value_traits<T>::hash(element));
+                return result;
+            }
+
+            static bool equal(const std::vector<T, Alloc>& lhs, const std::vector<T, Alloc>& rhs)
+            {
+                if (lhs.size() != rhs.size())
+                    return false;
+                for (std::size_t i = 0; i < lhs.size(); ++i)
+                {
+                    if (!cow_value_traits<T>::equal(lhs[i], rhs[i]))
+                        return false;
+                }
+                return true;
+            }
+        };
+
+        template <typename T>
+        struct cow_value_traits<T, std::void_t<decltype(std::declval<const T&>().as_tuple())>>
+        {
+            using tuple_type = decltype(std::declval<const T&>().as_tuple());
+            static std::size_t hash(const T& value) { return cow_value_traits<tuple_type>::hash(value.as_tuple()); }
+            static bool equal(const T& lhs, const T& rhs) { return cow_value_traits<tuple_type>::equal(lhs.as_tuple(), rhs.as_tuple()); }
+        };
+
+        /// Holds a value that is shared between copies until one of the copies changes it (copy-on-write).
+        ///
+        /// Copying a cow_ptr only copies a reference to the value.  get() returns the shared value, and get_mutable()
+        /// first makes a private copy of the value if it is shared.
+        ///
+        /// Two cow_ptr objects are equal if they share a value, or if their values are equal (see cow_value_traits).  A
+        /// hash of the value is kept so that most unequal values are found without comparing them.  The hash is
+        /// recomputed, the next time it is needed, after each call to get_mutable().
+        ///
+        /// @note A reference returned by get_mutable() must only be used to make changes until the cow_ptr is next
+        /// copied, compared or hashed.  A change made through it after the cow_ptr is copied is seen by both copies, and a
+        /// change made after it is compared or hashed is not reflected in the hash.  Call get_mutable() again instead.
+        /// @note As with any object, a cow_ptr must not be changed on one thread while it is used on another.
+        template <typename T>
+        class cow_ptr
+        {
+            std::shared_ptr<T> m_ptr;
+            mutable std::atomic<std::size_t> m_hash;
+            mutable std::atomic<bool> m_bHashValid;
+
+            public:
+                cow_ptr() : m_ptr(std::make_shared<T>()), m_hash(0), m_bHashValid(false) {}
+                explicit cow_ptr(T value) : m_ptr(std::make_shared<T>(std::move(value))), m_hash(0), m_bHashValid(false) {}
+
+                cow_ptr(const cow_ptr& rhs) : m_ptr(rhs.m_ptr), m_hash(rhs.m_hash.load(std::memory_order_relaxed)),
+                                              m_bHashValid(rhs.m_bHashValid.load(std::memory_order_relaxed)) {}
+
+                cow_ptr& operator=(const cow_ptr& rhs)
+                {
+                    m_ptr = rhs.m_ptr;
+                    m_hash.store(rhs.m_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    m_bHashValid.store(rhs.m_bHashValid.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    return *this;
+                }
+
+                const T& get() const noexcept { return *m_ptr; }
+
+                /// Returns the value to change.  If the value is shared with another cow_ptr, a copy is made first.
+                T& get_mutable()
+                {
+                    if (m_ptr.use_count() > 1)
+                        m_ptr = std::make_shared<T>(*m_ptr);
+                    m_bHashValid.store(false, std::memory_order_relaxed);
+                    return *m_ptr;
+                }
+
+                bool is_shared() const noexcept { return m_ptr.use_count() > 1; }
+
+                /// Returns true if both hold the same shared value (not only equal values)
+                bool is_same(const cow_ptr& rhs) const noexcept { return m_ptr == rhs.m_ptr; }
+
+                /// Returns a hash of the value.  Equal cow_ptr objects have equal hashes.
+                std::size_t get_hash() const
+                {
+                    if (m_bHashValid.load(std::memory_order_acquire))
+                        return m_hash.load(std::memory_order_relaxed);
+                    const std::size_t hash = cow_value_traits<T>::hash(*m_ptr);
+                    m_hash.store(hash, std::memory_order_relaxed);
+                    m_bHashValid.store(true, std::memory_order_release);
+                    return hash;
+                }
+
+                bool operator==(const cow_ptr& rhs) const
+                {
+                    if (is_same(rhs))
+                        return true;
+                    return get_hash() == rhs.get_hash() && cow_value_traits<T>::equal(*m_ptr, *rhs.m_ptr);
+                }
+
+                bool operator!=(const cow_ptr& rhs) const { return !(*this == rhs); }
+        };
+    }
+}
+#endif
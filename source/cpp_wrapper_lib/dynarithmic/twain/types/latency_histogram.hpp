@@ -0,0 +1,157 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+// log-linear (HDR style) histogram of latencies, in microseconds
+#ifndef DTWAIN_LATENCY_HISTOGRAM_HPP
+#define DTWAIN_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Histogram of latency values with a fixed relative precision.
+        ///
+        /// Values are recorded in microseconds.  Values below 64 microseconds are exact, larger values are stored in
+        /// buckets that are at most 1/32 (about 3%) of the value wide, up to about 12 days.  Recording a value is a
+        /// few instructions and never allocates, so it is safe to call from TWAIN callbacks.
+        class latency_histogram
+        {
+            public:
+                static constexpr uint32_t sub_bucket_bits = 5;
+                static constexpr uint64_t max_trackable_value = (uint64_t(1) << 40) - 1;
+
+            private:
+                static constexpr uint64_t sub_bucket_half = uint64_t(1) << sub_bucket_bits;      // 32
+                static constexpr uint64_t sub_bucket_count = sub_bucket_half << 1;                 // 64
+                static constexpr std::size_t bucket_total = static_cast<std::size_t>(sub_bucket_count + (40 - sub_bucket_bits - 1) * sub_bucket_half);
+
+                std::array<std::atomic<uint64_t>, bucket_total> m_counts;
+                std::atomic<uint64_t> m_total_count;
+                std::atomic<uint64_t> m_sum;
+                std::atomic<uint64_t> m_min;
+                std::atomic<uint64_t> m_max;
+
+                static uint32_t most_significant_bit(uint64_t value)
+                {
+                    uint32_t bit = 0;
+                    while (value >>= 1)
+                        ++bit;
+                    return bit;
+                }
+
+                static std::size_t index_of(uint64_t value)
+                {
+                    if (value < sub_bucket_count)
+                        return static_cast<std::size_t>(value);
+                    const uint32_t shift = most_significant_bit(value) - sub_bucket_bits;
+                    const uint64_t sub = value >> shift;
+                    return static_cast<std::size_t>(sub_bucket_count + (shift - 1) * sub_bucket_half + (sub - sub_bucket_half));
+                }
+
+                // returns the highest value that is stored in the bucket at index idx
+                static uint64_t highest_value_at(std::size_t idx)
+                {
+                    if (idx < sub_bucket_count)
+                        return idx;
+                    const uint64_t shift = (idx - sub_bucket_count) / sub_bucket_half + 1;
+                    const uint64_t sub = (idx - sub_bucket_count) % sub_bucket_half + sub_bucket_half;
+                    return ((sub + 1) << shift) - 1;
+                }
+
+            public:
+                latency_histogram() { reset(); }
+                latency_histogram(const latency_histogram&) = delete;
+                latency_histogram& operator=(const latency_histogram&) = delete;
+
+                void reset()
+                {
+                    for (auto& count : m_counts)
+                        count.store(0, std::memory_order_relaxed);
+                    m_total_count.store(0, std::memory_order_relaxed);
+                    m_sum.store(0, std::memory_order_relaxed);
+                    m_min.store((std::numeric_limits<uint64_t>::max)(), std::memory_order_relaxed);
+                    m_max.store(0, std::memory_order_relaxed);
+                }
+
+                /// Records a latency, in microseconds
+                void record(uint64_t micro_seconds)
+                {
+                    if (micro_seconds > max_trackable_value)
+                        micro_seconds = max_trackable_value;
+                    m_counts[index_of(micro_seconds)].fetch_add(1, std::memory_order_relaxed);
+                    m_total_count.fetch_add(1, std::memory_order_relaxed);
+                    m_sum.fetch_add(micro_seconds, std::memory_order_relaxed);
+                    uint64_t cur = m_min.load(std::memory_order_relaxed);
+                    while (micro_seconds < cur && !m_min.compare_exchange_weak(cur, micro_seconds, std::memory_order_relaxed)) {}
+                    cur = m_max.load(std::memory_order_relaxed);
+                    while (micro_seconds > cur && !m_max.compare_exchange_weak(cur, micro_seconds, std::memory_order_relaxed)) {}
+                }
+
+                template <typename Rep, typename Period>
+                void record(std::chrono::duration<Rep, Period> elapsed)
+                {
+                    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+                    record(static_cast<uint64_t>(us < 0 ? 0 : us));
+                }
+
+                uint64_t get_count() const { return m_total_count.load(std::memory_order_relaxed); }
+                uint64_t get_total() const { return m_sum.load(std::memory_order_relaxed); }
+                uint64_t get_min() const { return get_count() ? m_min.load(std::memory_order_relaxed) : 0; }
+                uint64_t get_max() const { return m_max.load(std::memory_order_relaxed); }
+                double get_mean() const { const auto cnt = get_count(); return cnt ? static_cast<double>(get_total()) / cnt : 0.0; }
+
+                /// Returns the value (in microseconds) at the given percentile (0.0 to 100.0).
+                ///
+                /// The value returned is the upper bound of the bucket holding the percentile, clamped to the largest value recorded.
+                uint64_t get_percentile(double percentile) const
+                {
+                    const uint64_t total = get_count();
+                    if (total == 0)
+                        return 0;
+                    if (percentile < 0.0)
+                        percentile = 0.0;
+                    if (percentile > 100.0)
+                        percentile = 100.0;
+                    uint64_t target = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5);
+                    if (target == 0)
+                        target = 1;
+                    uint64_t running = 0;
+                    for (std::size_t i = 0; i < bucket_total; ++i)
+                    {
+                        running += m_counts[i].load(std::memory_order_relaxed);
+                        if (running >= target)
+                        {
+                            const uint64_t val = highest_value_at(i);
+                            const uint64_t maxVal = get_max();
+                            return val < maxVal ? val : maxVal;
+                        }
+                    }
+                    return get_max();
+                }
+        };
+    }
+}
+#endif
@@ -27,8 +27,10 @@ OF THIRD PARTY RIGHTS.
 #endif
 #include <array>
 #include <algorithm>
+#include <deque>
 #include <string>
 #include <stdexcept>
+#include <type_traits>
 #ifdef DTWAIN_CPP_NOIMPORTLIB
     #include <dtwainx2.h>
 #else
@@ -57,6 +59,29 @@ namespace dynarithmic
                 void clear() { std::fill(this->begin(), this->end(), T()); }
         };
 
+        /// A read-only view of the elements of a twain_array, over the buffer returned by DTWAIN_ArrayGetBuffer.  No
+        /// elements are copied.  The view is no longer valid once the array is resized or destroyed.
+        template <typename T>
+        class twain_array_view
+        {
+            const T* m_data = nullptr;
+            size_t m_size = 0;
+
+            public:
+                typedef T value_type;
+                typedef const T* const_iterator;
+
+                twain_array_view() = default;
+                twain_array_view(const T* data, size_t sz) : m_data(data), m_size(data ? sz : 0) {}
+
+                const T* begin() const { return m_data; }
+                const T* end() const { return m_data + m_size; }
+                const T* data() const { return m_data; }
+                size_t size() const { return m_size; }
+                bool empty() const { return m_size == 0; }
+                const T& operator[](size_t idx) const { return m_data[idx]; }
+        };
+
         // Class that is used for capability setting / getting, and other tasks that require
         // the client (us) to communicate with various DTWAIN functions.
         class twain_array
@@ -92,6 +117,17 @@ namespace dynarithmic
                     return nullptr;
                 }
 
+                /// Returns a view of the elements, which must be of type T (for example, LONG or double)
+                template <typename T>
+                twain_array_view<T> get_view() const
+                {
+                    if (!m_theArray)
+                        return {};
+                    if (!m_buffer)
+                        m_buffer = API_INSTANCE DTWAIN_ArrayGetBuffer(m_theArray, 0);
+                    return { reinterpret_cast<const T*>(m_buffer), static_cast<size_t>(API_INSTANCE DTWAIN_ArrayGetCount(m_theArray)) };
+                }
+
                 template <typename T>
                 T& operator[](size_t idx)
                 {
@@ -165,6 +201,7 @@ namespace dynarithmic
                 {
                     std::swap(t1.m_theArray, t2.m_theArray);
                     std::swap(t1.m_isRange, t2.m_isRange);
+                    std::swap(t1.m_buffer, t2.m_buffer);
                 }
 
                 void set_array(DTWAIN_ARRAY a) 
@@ -243,6 +280,43 @@ namespace dynarithmic
                 }
         };
 
+        /// Reusable DTWAIN arrays, one for each DTWAIN array type (DTWAIN_ARRAYLONG, DTWAIN_ARRAYFLOAT, etc.), so that
+        /// capability values can be passed to DTWAIN without creating and destroying an array each time.
+        ///
+        /// The arrays are owned by the pool, and must be released (by clear() or destroying the pool) before the DTWAIN
+        /// library is unloaded.
+        class twain_array_pool
+        {
+            struct pooled_array
+            {
+                LONG array_type;
+                twain_array array;
+            };
+            std::deque<pooled_array> m_arrays;
+
+            public:
+                /// Returns an array of type **arrayType** with **count** elements, or nullptr if the array cannot be
+                /// created.  The previous contents of the array are not kept.
+                twain_array* acquire(LONG arrayType, size_t count)
+                {
+                    for (auto& pooled : m_arrays)
+                    {
+                        if (pooled.array_type == arrayType)
+                        {
+                            pooled.array.resize(count);
+                            return &pooled.array;
+                        }
+                    }
+                    DTWAIN_ARRAY newArray = API_INSTANCE DTWAIN_ArrayCreate(arrayType, static_cast<LONG>(count));
+                    if (!newArray)
+                        return nullptr;
+                    m_arrays.push_back({ arrayType, twain_array(newArray) });
+                    return &m_arrays.back().array;
+                }
+
+                void clear() { m_arrays.clear(); }
+        };
+
         namespace underlying_type
         {
             template <typename T>
@@ -261,13 +335,28 @@ namespace dynarithmic
         // copying traits for the twain_array
         struct twain_array_copy_traits
         {
+            /// true if values of type T can be written to a pooled array (see fill_twain_array)
+            template <typename T>
+            struct is_poolable : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_same<T, std::string>::value> {};
+
+            template <typename Container>
+            static auto reserve(Container& C, size_t n, int) -> decltype(C.reserve(n), void())
+            {
+                C.reserve(C.size() + n);
+            }
+
+            template <typename Container>
+            static void reserve(Container&, size_t, long) {}
+
             template <typename Container, typename std::enable_if<
                             std::is_floating_point<typename Container::value_type>::value ||
                             std::is_integral<typename Container::value_type>::value, bool>::type = 1>
             static void copy_from_twain_array(twain_array& ta, size_t sz, Container& C)
             {
-                auto pBuffer = ta.get_buffer<typename dtwain_underlying_type<typename Container::value_type>::value_type>();
-                std::transform(pBuffer, pBuffer + sz, std::inserter(C, std::end(C)), []
+                auto view = ta.get_view<typename dtwain_underlying_type<typename Container::value_type>::value_type>();
+                sz = (std::min)(sz, view.size());
+                reserve(C, sz, 0);
+                std::transform(view.begin(), view.begin() + sz, std::inserter(C, std::end(C)), []
                                 (auto val) { return static_cast<typename Container::value_type>(val); });
             }
 
@@ -283,15 +372,11 @@ namespace dynarithmic
                             std::is_same<typename Container::value_type, std::string>::value, bool>::type = 1>
             static void copy_from_twain_array(twain_array& ta, size_t sz, Container& C)
             {
-                std::vector<std::string> vFrm(1);
-                std::vector<char> v_char(API_INSTANCE DTWAIN_ArrayGetMaxStringLength(ta.get_array()) + 1);
-                if (v_char.empty())
-                    return;
+                reserve(C, sz, 0);
                 for (size_t i = 0; i < sz; ++i)
                 {
-                    std::string vTemp = API_INSTANCE DTWAIN_ArrayGetAtANSIStringPtr(ta.get_array(), static_cast<LONG>(i));
-                    vFrm[0] = &vTemp[0];
-                    std::copy(vFrm.begin(), vFrm.end(), std::inserter(C, C.end()));
+                    const char* pStr = API_INSTANCE DTWAIN_ArrayGetAtANSIStringPtr(ta.get_array(), static_cast<LONG>(i));
+                    *std::inserter(C, C.end()) = std::string(pStr ? pStr : "");
                 }
             }
 
@@ -306,15 +391,16 @@ namespace dynarithmic
                             std::is_same<typename Container::value_type, twain_frame<>>::value, bool>::type = 1>
             static void copy_from_twain_array(const twain_array& ta, size_t sz, Container& C)
             {
-                std::vector<twain_frame<>> vFrm(1);
+                reserve(C, sz, 0);
+                twain_frame<> frm;
                 for (size_t i = 0; i < sz; ++i)
                 {
                     API_INSTANCE DTWAIN_ArrayGetAtFrame(ta.get_array(), static_cast<LONG>(i), 
-                                                        &(vFrm[0].left), 
-                                                        &(vFrm[0].top), 
-                                                        &(vFrm[0].right),
-                                                        &(vFrm[0].bottom));
-                    std::copy(vFrm.begin(), vFrm.end(), std::inserter(C, C.end()));
+                                                        &frm.left, 
+                                                        &frm.top, 
+                                                        &frm.right,
+                                                        &frm.bottom);
+                    *std::inserter(C, C.end()) = frm;
                 }
             }
 
@@ -379,6 +465,41 @@ namespace dynarithmic
             {
                 return copy_to_twain_array(theSource, ta, T::cap_value, C);
             }
+
+            // Writes the values to an existing array (for example, one from a twain_array_pool) that already has
+            // C.size() elements.  Returns false if the values cannot be written this way.
+            template <typename Container, typename std::enable_if<
+                            std::is_floating_point<typename Container::value_type>::value ||
+                            std::is_integral<typename Container::value_type>::value, bool>::type = 1>
+            static bool fill_twain_array(twain_array& ta, const Container& C)
+            {
+                auto pBuffer = ta.get_buffer<typename dtwain_underlying_type<typename Container::value_type>::value_type>();
+                if (!pBuffer)
+                    return false;
+                std::copy(C.begin(), C.end(), pBuffer);
+                return true;
+            }
+
+            template <typename Container, typename std::enable_if<
+                            std::is_same<typename Container::value_type, std::string>::value, bool>::type = 1>
+            static bool fill_twain_array(twain_array& ta, const Container& C)
+            {
+                LONG i = 0;
+                for (auto& s : C)
+                {
+                    if (!API_INSTANCE DTWAIN_ArraySetAtStringA(ta.get_array(), i, s.c_str()))
+                        return false;
+                    ++i;
+                }
+                return true;
+            }
+
+            template <typename Container, typename std::enable_if<
+                            std::is_same<typename Container::value_type, twain_frame<>>::value, bool>::type = 1>
+            static bool fill_twain_array(twain_array&, const Container&)
+            {
+                return false;
+            }
         };
 
     }
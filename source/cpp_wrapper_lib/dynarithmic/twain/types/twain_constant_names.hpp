@@ -0,0 +1,416 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+// Generated from twain.h.  Each table lists the TWAIN constants of one twain_constant_category, sorted by value.  When
+// twain.h defines more than one name for a value (for example, TWOR_ROT0 and TWOR_PORTRAIT), the first name is used.
+#ifndef DTWAIN_TWAIN_CONSTANT_NAMES_HPP
+#define DTWAIN_TWAIN_CONSTANT_NAMES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <dynarithmic/twain/twain_values.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        struct twain_constant_name
+        {
+            int32_t value;
+            const char* name;
+        };
+
+        namespace twain_constant_names
+        {
+            namespace details
+            {
+                inline constexpr twain_constant_name TWPT_names[] = {
+                    { 0, "TWPT_BW" }, { 1, "TWPT_GRAY" }, { 2, "TWPT_RGB" }, { 3, "TWPT_PALETTE" }, { 4, "TWPT_CMY" }, { 5, "TWPT_CMYK" },
+                    { 6, "TWPT_YUV" }, { 7, "TWPT_YUVK" }, { 8, "TWPT_CIEXYZ" }, { 9, "TWPT_LAB" }, { 10, "TWPT_SRGB" }, { 11, "TWPT_SCRGB" },
+                    { 12, "TWPT_BGR" }, { 13, "TWPT_CIELAB" }, { 14, "TWPT_CIELUV" }, { 15, "TWPT_YCBCR" }, { 16, "TWPT_INFRARED" }
+                };
+
+                inline constexpr twain_constant_name TWUN_names[] = {
+                    { 0, "TWUN_INCHES" }, { 1, "TWUN_CENTIMETERS" }, { 2, "TWUN_PICAS" }, { 3, "TWUN_POINTS" }, { 4, "TWUN_TWIPS" },
+                    { 5, "TWUN_PIXELS" }, { 6, "TWUN_MILLIMETERS" }
+                };
+
+                inline constexpr twain_constant_name TWCY_names[] = {
+                    { 1, "TWCY_USA" }, { 2, "TWCY_CANADA" }, { 3, "TWCY_MEXICO" }, { 5, "TWCY_CUBA" }, { 6, "TWCY_BRITAIN" }, { 7, "TWCY_USSR" },
+                    { 20, "TWCY_EGYPT" }, { 27, "TWCY_SOUTHAFRICA" }, { 30, "TWCY_GREECE" }, { 31, "TWCY_NETHERLANDS" }, { 32, "TWCY_BELGIUM" },
+                    { 33, "TWCY_ANDORRA" }, { 34, "TWCY_SPAIN" }, { 36, "TWCY_HUNGARY" }, { 38, "TWCY_YUGOSLAVIA" }, { 39, "TWCY_ITALY" },
+                    { 40, "TWCY_ROMANIA" }, { 41, "TWCY_LIECHTENSTEIN" }, { 42, "TWCY_CZECHOSLOVAKIA" }, { 43, "TWCY_AUSTRIA" },
+                    { 44, "TWCY_UNITEDKINGDOM" }, { 45, "TWCY_DENMARK" }, { 46, "TWCY_SWEDEN" }, { 47, "TWCY_NORWAY" }, { 48, "TWCY_POLAND" },
+                    { 49, "TWCY_GERMANY" }, { 51, "TWCY_PERU" }, { 54, "TWCY_ARGENTINA" }, { 55, "TWCY_BRAZIL" }, { 56, "TWCY_CHILE" },
+                    { 57, "TWCY_COLOMBIA" }, { 58, "TWCY_VENEZUELA" }, { 60, "TWCY_MALAYSIA" }, { 61, "TWCY_AUSTRALIA" }, { 62, "TWCY_INDONESIA" },
+                    { 63, "TWCY_PHILLIPPINES" }, { 64, "TWCY_NEWZEALAND" }, { 65, "TWCY_SINGAPORE" }, { 66, "TWCY_THAILAND" }, { 81, "TWCY_JAPAN" },
+                    { 82, "TWCY_KOREA" }, { 84, "TWCY_VIETNAM" }, { 86, "TWCY_CHINA" }, { 90, "TWCY_TURKEY" }, { 91, "TWCY_INDIA" },
+                    { 92, "TWCY_PAKISTAN" }, { 94, "TWCY_SRILANKA" }, { 95, "TWCY_MYANMAR" }, { 98, "TWCY_IRAN" }, { 212, "TWCY_MOROCCO" },
+                    { 213, "TWCY_ALGERIA" }, { 216, "TWCY_TUNISIA" }, { 218, "TWCY_LIBYA" }, { 220, "TWCY_GAMBIA" }, { 221, "TWCY_SENEGAL" },
+                    { 224, "TWCY_GUINEA" }, { 225, "TWCY_IVORYCOAST" }, { 227, "TWCY_NIGER" }, { 228, "TWCY_TOGO" }, { 229, "TWCY_BENIN" },
+                    { 230, "TWCY_MAURITIUS" }, { 231, "TWCY_LIBERIA" }, { 233, "TWCY_GHANA" }, { 234, "TWCY_NIGERIA" }, { 237, "TWCY_CAMAROON" },
+                    { 238, "TWCY_CAPEVERDEIS" }, { 241, "TWCY_GABON" }, { 243, "TWCY_ZAIRE" }, { 246, "TWCY_DIEGOGARCIA" }, { 247, "TWCY_ASCENSIONI" },
+                    { 250, "TWCY_RWANDA" }, { 251, "TWCY_ETHIOPIA" }, { 254, "TWCY_KENYA" }, { 255, "TWCY_TANZANIA" }, { 256, "TWCY_UGANDA" },
+                    { 260, "TWCY_ZAMBIA" }, { 263, "TWCY_ZIMBABWE" }, { 264, "TWCY_NAMIBIA" }, { 265, "TWCY_MALAWI" }, { 266, "TWCY_LESOTHO" },
+                    { 267, "TWCY_BOTSWANA" }, { 268, "TWCY_SWAZILAND" }, { 269, "TWCY_MAYOTTEIS" }, { 291, "TWCY_ERITREA" }, { 297, "TWCY_ARUBA" },
+                    { 298, "TWCY_FAEROEIS" }, { 299, "TWCY_GREENLAND" }, { 340, "TWCY_USVIRGINIS" }, { 350, "TWCY_GIBRALTER" },
+                    { 351, "TWCY_PORTUGAL" }, { 352, "TWCY_LUXENBOURG" }, { 353, "TWCY_IRELAND" }, { 354, "TWCY_ICELAND" }, { 355, "TWCY_ALBANIA" },
+                    { 356, "TWCY_MALTA" }, { 357, "TWCY_CYPRUS" }, { 358, "TWCY_FINLAND" }, { 359, "TWCY_BULGARIA" }, { 370, "TWCY_LITHUANIA" },
+                    { 371, "TWCY_LATVIA" }, { 372, "TWCY_ESTONIA" }, { 373, "TWCY_MOLDOVA" }, { 374, "TWCY_ARMENIA" }, { 375, "TWCY_BELARUS" },
+                    { 380, "TWCY_UKRAINE" }, { 381, "TWCY_SERBIA" }, { 385, "TWCY_CROATIA" }, { 386, "TWCY_SLOVENIA" }, { 387, "TWCY_BOSNIAHERZGO" },
+                    { 389, "TWCY_MACEDONIA" }, { 420, "TWCY_CZECHREPUBLIC" }, { 421, "TWCY_SLOVAKIA" }, { 501, "TWCY_BELIZE" },
+                    { 502, "TWCY_GUATEMALA" }, { 503, "TWCY_ELSALVADOR" }, { 504, "TWCY_HONDURAS" }, { 505, "TWCY_NICARAGUA" },
+                    { 506, "TWCY_COSTARICA" }, { 507, "TWCY_PANAMA" }, { 508, "TWCY_MIQUELON" }, { 509, "TWCY_HAITI" }, { 590, "TWCY_GUADELOUPE" },
+                    { 591, "TWCY_BOLIVIA" }, { 592, "TWCY_GUYANA" }, { 593, "TWCY_ECUADOR" }, { 594, "TWCY_FRGUIANA" }, { 595, "TWCY_PARAGUAY" },
+                    { 596, "TWCY_FRANTILLES" }, { 597, "TWCY_SURINAME" }, { 598, "TWCY_URUGUAY" }, { 599, "TWCY_NETHANTILLES" },
+                    { 670, "TWCY_SAIPAN" }, { 671, "TWCY_GUAM" }, { 673, "TWCY_BRUNEI" }, { 675, "TWCY_PNEWGUINEA" }, { 676, "TWCY_TONGAIS" },
+                    { 679, "TWCY_FIJIISLANDS" }, { 684, "TWCY_AMERICANSAMOA" }, { 687, "TWCY_NEWCALEDONIA" }, { 689, "TWCY_FRPOLYNEISA" },
+                    { 691, "TWCY_MICRONESIA" }, { 692, "TWCY_MARSHALLIS" }, { 787, "TWCY_PUERTORICO" }, { 850, "TWCY_NORTHKOREA" },
+                    { 852, "TWCY_HONGKONG" }, { 853, "TWCY_MACAO" }, { 855, "TWCY_CAMBODIA" }, { 880, "TWCY_BANGLADESH" }, { 886, "TWCY_TAIWAN" },
+                    { 960, "TWCY_MALDIVES" }, { 962, "TWCY_JORDAN" }, { 964, "TWCY_IRAQ" }, { 965, "TWCY_KUWAIT" }, { 966, "TWCY_SAUDIARABIA" },
+                    { 968, "TWCY_OMAN" }, { 971, "TWCY_UAEMIRATES" }, { 972, "TWCY_ISRAEL" }, { 973, "TWCY_BAHRAIN" }, { 974, "TWCY_QATAR" },
+                    { 977, "TWCY_NEPAL" }, { 994, "TWCY_AZERBAIJAN" }, { 995, "TWCY_GEORGIA" }, { 1001, "TWCY_AFGHANISTAN" }, { 1002, "TWCY_ANGOLA" },
+                    { 1003, "TWCY_BHUTAN" }, { 1004, "TWCY_BURKINAFASO" }, { 1005, "TWCY_BURMA" }, { 1006, "TWCY_BURUNDI" },
+                    { 1007, "TWCY_CENTRALAFREP" }, { 1008, "TWCY_CHAD" }, { 1009, "TWCY_CHRISTMASIS" }, { 1010, "TWCY_COMOROS" },
+                    { 1011, "TWCY_CONGO" }, { 1012, "TWCY_COOKIS" }, { 1013, "TWCY_DJIBOUTI" }, { 1014, "TWCY_EASTERIS" }, { 1015, "TWCY_EQGUINEA" },
+                    { 1016, "TWCY_FALKLANDIS" }, { 1017, "TWCY_GUINEABISSAU" }, { 1018, "TWCY_KIRIBATI" }, { 1019, "TWCY_LAOS" },
+                    { 1020, "TWCY_LEBANON" }, { 1021, "TWCY_MADAGASCAR" }, { 1022, "TWCY_MALI" }, { 1023, "TWCY_MAURITANIA" },
+                    { 1024, "TWCY_MONGOLIA" }, { 1025, "TWCY_MOZAMBIQUE" }, { 1026, "TWCY_NAURU" }, { 1027, "TWCY_NIUE" }, { 1028, "TWCY_NORFOLKI" },
+                    { 1029, "TWCY_PALAU" }, { 1030, "TWCY_PITCAIRNIS" }, { 1031, "TWCY_REUNIONI" }, { 1032, "TWCY_STHELENA" },
+                    { 1033, "TWCY_SAOTOME" }, { 1034, "TWCY_SEYCHELLESIS" }, { 1035, "TWCY_SIERRALEONE" }, { 1036, "TWCY_SOLOMONIS" },
+                    { 1037, "TWCY_SOMALI" }, { 1038, "TWCY_SUDAN" }, { 1039, "TWCY_SYRIA" }, { 1040, "TWCY_TUVALU" }, { 1041, "TWCY_VANUATU" },
+                    { 1042, "TWCY_WAKE" }, { 1043, "TWCY_FUTANAIS" }, { 1044, "TWCY_WESTERNSAHARA" }, { 1045, "TWCY_WESTERNSAMOA" },
+                    { 1046, "TWCY_YEMEN" }, { 5399, "TWCY_GUANTANAMOBAY" }, { 8010, "TWCY_JAMAICA" }, { 8011, "TWCY_MONTSERRAT" },
+                    { 8012, "TWCY_NEVIS" }, { 8013, "TWCY_STKITTS" }, { 8014, "TWCY_STLUCIA" }, { 8015, "TWCY_GRENEDINES" }, { 8016, "TWCY_TOBAGO" },
+                    { 8017, "TWCY_TURKSCAICOS" }, { 8090, "TWCY_ANGUILLA" }, { 8091, "TWCY_ANTIGUA" }, { 8092, "TWCY_BAHAMAS" },
+                    { 8093, "TWCY_BARBADOS" }, { 8094, "TWCY_BERMUDA" }, { 8095, "TWCY_BRITVIRGINIS" }, { 8096, "TWCY_CAYMANIS" },
+                    { 8097, "TWCY_DOMINICA" }, { 8098, "TWCY_DOMINCANREP" }, { 8099, "TWCY_GRENADA" }
+                };
+
+                inline constexpr twain_constant_name TWAL_names[] = {
+                    { 0, "TWAL_ALARM" }, { 1, "TWAL_FEEDERERROR" }, { 2, "TWAL_FEEDERWARNING" }, { 3, "TWAL_BARCODE" }, { 4, "TWAL_DOUBLEFEED" },
+                    { 5, "TWAL_JAM" }, { 6, "TWAL_PATCHCODE" }, { 7, "TWAL_POWER" }, { 8, "TWAL_SKEW" }
+                };
+
+                inline constexpr twain_constant_name TWAS_names[] = {
+                    { 0, "TWAS_NONE" }, { 1, "TWAS_AUTO" }, { 2, "TWAS_CURRENT" }
+                };
+
+                inline constexpr twain_constant_name TWBCOR_names[] = {
+                    { 0, "TWBCOR_ROT0" }, { 1, "TWBCOR_ROT90" }, { 2, "TWBCOR_ROT180" }, { 3, "TWBCOR_ROT270" }, { 4, "TWBCOR_ROTX" }
+                };
+
+                inline constexpr twain_constant_name TWBD_names[] = {
+                    { 0, "TWBD_HORZ" }, { 1, "TWBD_VERT" }, { 2, "TWBD_HORZVERT" }, { 3, "TWBD_VERTHORZ" }
+                };
+
+                inline constexpr twain_constant_name TWBO_names[] = {
+                    { 0, "TWBO_LSBFIRST" }, { 1, "TWBO_MSBFIRST" }
+                };
+
+                inline constexpr twain_constant_name TWBP_names[] = {
+                    { -2, "TWBP_DISABLE" }, { -1, "TWBP_AUTO" }
+                };
+
+                inline constexpr twain_constant_name TWBR_names[] = {
+                    { 0, "TWBR_THRESHOLD" }, { 1, "TWBR_HALFTONE" }, { 2, "TWBR_CUSTHALFTONE" }, { 3, "TWBR_DIFFUSION" },
+                    { 4, "TWBR_DYNAMICTHRESHOLD" }
+                };
+
+                inline constexpr twain_constant_name TWBT_names[] = {
+                    { 0, "TWBT_3OF9" }, { 1, "TWBT_2OF5INTERLEAVED" }, { 2, "TWBT_2OF5NONINTERLEAVED" }, { 3, "TWBT_CODE93" }, { 4, "TWBT_CODE128" },
+                    { 5, "TWBT_UCC128" }, { 6, "TWBT_CODABAR" }, { 7, "TWBT_UPCA" }, { 8, "TWBT_UPCE" }, { 9, "TWBT_EAN8" }, { 10, "TWBT_EAN13" },
+                    { 11, "TWBT_POSTNET" }, { 12, "TWBT_PDF417" }, { 13, "TWBT_2OF5INDUSTRIAL" }, { 14, "TWBT_2OF5MATRIX" },
+                    { 15, "TWBT_2OF5DATALOGIC" }, { 16, "TWBT_2OF5IATA" }, { 17, "TWBT_3OF9FULLASCII" }, { 18, "TWBT_CODABARWITHSTARTSTOP" },
+                    { 19, "TWBT_MAXICODE" }, { 20, "TWBT_QRCODE" }
+                };
+
+                inline constexpr twain_constant_name TWCP_names[] = {
+                    { 0, "TWCP_NONE" }, { 1, "TWCP_PACKBITS" }, { 2, "TWCP_GROUP31D" }, { 3, "TWCP_GROUP31DEOL" }, { 4, "TWCP_GROUP32D" },
+                    { 5, "TWCP_GROUP4" }, { 6, "TWCP_JPEG" }, { 7, "TWCP_LZW" }, { 8, "TWCP_JBIG" }, { 9, "TWCP_PNG" }, { 10, "TWCP_RLE4" },
+                    { 11, "TWCP_RLE8" }, { 12, "TWCP_BITFIELDS" }, { 13, "TWCP_ZIP" }, { 14, "TWCP_JPEG2000" }
+                };
+
+                inline constexpr twain_constant_name TWCS_names[] = {
+                    { 0, "TWCS_BOTH" }, { 1, "TWCS_TOP" }, { 2, "TWCS_BOTTOM" }
+                };
+
+                inline constexpr twain_constant_name TWDE_names[] = {
+                    { 0, "TWDE_CHECKAUTOMATICCAPTURE" }, { 1, "TWDE_CHECKBATTERY" }, { 2, "TWDE_CHECKDEVICEONLINE" }, { 3, "TWDE_CHECKFLASH" },
+                    { 4, "TWDE_CHECKPOWERSUPPLY" }, { 5, "TWDE_CHECKRESOLUTION" }, { 6, "TWDE_DEVICEADDED" }, { 7, "TWDE_DEVICEOFFLINE" },
+                    { 8, "TWDE_DEVICEREADY" }, { 9, "TWDE_DEVICEREMOVED" }, { 10, "TWDE_IMAGECAPTURED" }, { 11, "TWDE_IMAGEDELETED" },
+                    { 12, "TWDE_PAPERDOUBLEFEED" }, { 13, "TWDE_PAPERJAM" }, { 14, "TWDE_LAMPFAILURE" }, { 15, "TWDE_POWERSAVE" },
+                    { 16, "TWDE_POWERSAVENOTIFY" }, { 32768, "TWDE_CUSTOMEVENTS" }
+                };
+
+                inline constexpr twain_constant_name TWDR_names[] = {
+                    { 1, "TWDR_GET" }, { 2, "TWDR_SET" }
+                };
+
+                inline constexpr twain_constant_name TWDSK_names[] = {
+                    { 0, "TWDSK_SUCCESS" }, { 1, "TWDSK_REPORTONLY" }, { 2, "TWDSK_FAIL" }, { 3, "TWDSK_DISABLED" }
+                };
+
+                inline constexpr twain_constant_name TWDX_names[] = {
+                    { 0, "TWDX_NONE" }, { 1, "TWDX_1PASSDUPLEX" }, { 2, "TWDX_2PASSDUPLEX" }
+                };
+
+                inline constexpr twain_constant_name TWFA_names[] = {
+                    { 0, "TWFA_NONE" }, { 1, "TWFA_LEFT" }, { 2, "TWFA_CENTER" }, { 3, "TWFA_RIGHT" }
+                };
+
+                inline constexpr twain_constant_name TWFE_names[] = {
+                    { 0, "TWFE_GENERAL" }, { 1, "TWFE_PHOTO" }
+                };
+
+                inline constexpr twain_constant_name TWFF_names[] = {
+                    { 0, "TWFF_TIFF" }, { 1, "TWFF_PICT" }, { 2, "TWFF_BMP" }, { 3, "TWFF_XBM" }, { 4, "TWFF_JFIF" }, { 5, "TWFF_FPX" },
+                    { 6, "TWFF_TIFFMULTI" }, { 7, "TWFF_PNG" }, { 8, "TWFF_SPIFF" }, { 9, "TWFF_EXIF" }, { 10, "TWFF_PDF" }, { 11, "TWFF_JP2" },
+                    { 12, "TWFF_JPN" }, { 13, "TWFF_JPX" }, { 14, "TWFF_DEJAVU" }, { 15, "TWFF_PDFA" }, { 16, "TWFF_PDFA2" }, { 17, "TWFF_PDFRASTER" }
+                };
+
+                inline constexpr twain_constant_name TWFL_names[] = {
+                    { 0, "TWFL_NONE" }, { 1, "TWFL_OFF" }, { 2, "TWFL_ON" }, { 3, "TWFL_AUTO" }, { 4, "TWFL_REDEYE" }
+                };
+
+                inline constexpr twain_constant_name TWFO_names[] = {
+                    { 0, "TWFO_FIRSTPAGEFIRST" }, { 1, "TWFO_LASTPAGEFIRST" }
+                };
+
+                inline constexpr twain_constant_name TWFP_names[] = {
+                    { 0, "TWFP_POCKETERROR" }, { 1, "TWFP_POCKET1" }, { 2, "TWFP_POCKET2" }, { 3, "TWFP_POCKET3" }, { 4, "TWFP_POCKET4" },
+                    { 5, "TWFP_POCKET5" }, { 6, "TWFP_POCKET6" }, { 7, "TWFP_POCKET7" }, { 8, "TWFP_POCKET8" }, { 9, "TWFP_POCKET9" },
+                    { 10, "TWFP_POCKET10" }, { 11, "TWFP_POCKET11" }, { 12, "TWFP_POCKET12" }, { 13, "TWFP_POCKET13" }, { 14, "TWFP_POCKET14" },
+                    { 15, "TWFP_POCKET15" }, { 16, "TWFP_POCKET16" }
+                };
+
+                inline constexpr twain_constant_name TWFR_names[] = {
+                    { 0, "TWFR_BOOK" }, { 1, "TWFR_FANFOLD" }
+                };
+
+                inline constexpr twain_constant_name TWFT_names[] = {
+                    { 0, "TWFT_RED" }, { 1, "TWFT_GREEN" }, { 2, "TWFT_BLUE" }, { 3, "TWFT_NONE" }, { 4, "TWFT_WHITE" }, { 5, "TWFT_CYAN" },
+                    { 6, "TWFT_MAGENTA" }, { 7, "TWFT_YELLOW" }, { 8, "TWFT_BLACK" }
+                };
+
+                inline constexpr twain_constant_name TWFY_names[] = {
+                    { 0, "TWFY_CAMERA" }, { 1, "TWFY_CAMERATOP" }, { 2, "TWFY_CAMERABOTTOM" }, { 3, "TWFY_CAMERAPREVIEW" }, { 4, "TWFY_DOMAIN" },
+                    { 5, "TWFY_HOST" }, { 6, "TWFY_DIRECTORY" }, { 7, "TWFY_IMAGE" }, { 8, "TWFY_UNKNOWN" }
+                };
+
+                inline constexpr twain_constant_name TWIA_names[] = {
+                    { 0, "TWIA_UNUSED" }, { 1, "TWIA_FIXED" }, { 2, "TWIA_LEVEL1" }, { 3, "TWIA_LEVEL2" }, { 4, "TWIA_LEVEL3" }, { 5, "TWIA_LEVEL4" }
+                };
+
+                inline constexpr twain_constant_name TWIC_names[] = {
+                    { 0, "TWIC_NONE" }, { 1, "TWIC_LINK" }, { 2, "TWIC_EMBED" }
+                };
+
+                inline constexpr twain_constant_name TWIF_names[] = {
+                    { 0, "TWIF_NONE" }, { 1, "TWIF_AUTO" }, { 2, "TWIF_LOWPASS" }, { 3, "TWIF_BANDPASS" }, { 4, "TWIF_HIGHPASS" }
+                };
+
+                inline constexpr twain_constant_name TWIM_names[] = {
+                    { 0, "TWIM_NONE" }, { 1, "TWIM_FRONTONTOP" }, { 2, "TWIM_FRONTONBOTTOM" }, { 3, "TWIM_FRONTONLEFT" }, { 4, "TWIM_FRONTONRIGHT" }
+                };
+
+                inline constexpr twain_constant_name TWJC_names[] = {
+                    { 0, "TWJC_NONE" }, { 1, "TWJC_JSIC" }, { 2, "TWJC_JSIS" }, { 3, "TWJC_JSXC" }, { 4, "TWJC_JSXS" }
+                };
+
+                inline constexpr twain_constant_name TWJQ_names[] = {
+                    { -4, "TWJQ_UNKNOWN" }, { -3, "TWJQ_LOW" }, { -2, "TWJQ_MEDIUM" }, { -1, "TWJQ_HIGH" }
+                };
+
+                inline constexpr twain_constant_name TWLP_names[] = {
+                    { 0, "TWLP_REFLECTIVE" }, { 1, "TWLP_TRANSMISSIVE" }
+                };
+
+                inline constexpr twain_constant_name TWLS_names[] = {
+                    { 0, "TWLS_RED" }, { 1, "TWLS_GREEN" }, { 2, "TWLS_BLUE" }, { 3, "TWLS_NONE" }, { 4, "TWLS_WHITE" }, { 5, "TWLS_UV" },
+                    { 6, "TWLS_IR" }
+                };
+
+                inline constexpr twain_constant_name TWMD_names[] = {
+                    { 0, "TWMD_MICR" }, { 1, "TWMD_RAW" }, { 2, "TWMD_INVALID" }
+                };
+
+                inline constexpr twain_constant_name TWNF_names[] = {
+                    { 0, "TWNF_NONE" }, { 1, "TWNF_AUTO" }, { 2, "TWNF_LONEPIXEL" }, { 3, "TWNF_MAJORITYRULE" }
+                };
+
+                inline constexpr twain_constant_name TWOR_names[] = {
+                    { 0, "TWOR_ROT0" }, { 1, "TWOR_ROT90" }, { 2, "TWOR_ROT180" }, { 3, "TWOR_ROT270" }, { 4, "TWOR_AUTO" }, { 5, "TWOR_AUTOTEXT" },
+                    { 6, "TWOR_AUTOPICTURE" }
+                };
+
+                inline constexpr twain_constant_name TWOV_names[] = {
+                    { 0, "TWOV_NONE" }, { 1, "TWOV_AUTO" }, { 2, "TWOV_TOPBOTTOM" }, { 3, "TWOV_LEFTRIGHT" }, { 4, "TWOV_ALL" }
+                };
+
+                inline constexpr twain_constant_name TWPA_names[] = {
+                    { 0, "TWPA_RGB" }, { 1, "TWPA_GRAY" }, { 2, "TWPA_CMY" }
+                };
+
+                inline constexpr twain_constant_name TWPC_names[] = {
+                    { 0, "TWPC_CHUNKY" }, { 1, "TWPC_PLANAR" }
+                };
+
+                inline constexpr twain_constant_name TWPCH_names[] = {
+                    { 0, "TWPCH_PATCH1" }, { 1, "TWPCH_PATCH2" }, { 2, "TWPCH_PATCH3" }, { 3, "TWPCH_PATCH4" }, { 4, "TWPCH_PATCH6" },
+                    { 5, "TWPCH_PATCHT" }
+                };
+
+                inline constexpr twain_constant_name TWPF_names[] = {
+                    { 0, "TWPF_CHOCOLATE" }, { 1, "TWPF_VANILLA" }
+                };
+
+                inline constexpr twain_constant_name TWPM_names[] = {
+                    { 0, "TWPM_SINGLESTRING" }, { 1, "TWPM_MULTISTRING" }, { 2, "TWPM_COMPOUNDSTRING" }, { 3, "TWPM_IMAGEADDRESSSTRING" }
+                };
+
+                inline constexpr twain_constant_name TWPR_names[] = {
+                    { 0, "TWPR_IMPRINTERTOPBEFORE" }, { 1, "TWPR_IMPRINTERTOPAFTER" }, { 2, "TWPR_IMPRINTERBOTTOMBEFORE" },
+                    { 3, "TWPR_IMPRINTERBOTTOMAFTER" }, { 4, "TWPR_ENDORSERTOPBEFORE" }, { 5, "TWPR_ENDORSERTOPAFTER" },
+                    { 6, "TWPR_ENDORSERBOTTOMBEFORE" }, { 7, "TWPR_ENDORSERBOTTOMAFTER" }
+                };
+
+                inline constexpr twain_constant_name TWPF2_names[] = {
+                    { 0, "TWPF_NORMAL" }, { 1, "TWPF_BOLD" }, { 2, "TWPF_ITALIC" }, { 3, "TWPF_LARGESIZE" }, { 4, "TWPF_SMALLSIZE" }
+                };
+
+                inline constexpr twain_constant_name TWCT_names[] = {
+                    { 0, "TWCT_PAGE" }, { 1, "TWCT_PATCH1" }, { 2, "TWCT_PATCH2" }, { 3, "TWCT_PATCH3" }, { 4, "TWCT_PATCH4" }, { 5, "TWCT_PATCHT" },
+                    { 6, "TWCT_PATCH6" }
+                };
+
+                inline constexpr twain_constant_name TWPS_names[] = {
+                    { 0, "TWPS_EXTERNAL" }, { 1, "TWPS_BATTERY" }
+                };
+
+                inline constexpr twain_constant_name TWSS_names[] = {
+                    { 0, "TWSS_NONE" }, { 1, "TWSS_A4" }, { 2, "TWSS_JISB5" }, { 3, "TWSS_USLETTER" }, { 4, "TWSS_USLEGAL" }, { 5, "TWSS_A5" },
+                    { 6, "TWSS_ISOB4" }, { 7, "TWSS_ISOB6" }, { 8, "TWSS_B" }, { 9, "TWSS_USLEDGER" }, { 10, "TWSS_USEXECUTIVE" }, { 11, "TWSS_A3" },
+                    { 12, "TWSS_ISOB3" }, { 13, "TWSS_A6" }, { 14, "TWSS_C4" }, { 15, "TWSS_C5" }, { 16, "TWSS_C6" }, { 17, "TWSS_4A0" },
+                    { 18, "TWSS_2A0" }, { 19, "TWSS_A0" }, { 20, "TWSS_A1" }, { 21, "TWSS_A2" }, { 22, "TWSS_A7" }, { 23, "TWSS_A8" },
+                    { 24, "TWSS_A9" }, { 25, "TWSS_A10" }, { 26, "TWSS_ISOB0" }, { 27, "TWSS_ISOB1" }, { 28, "TWSS_ISOB2" }, { 29, "TWSS_ISOB5" },
+                    { 30, "TWSS_ISOB7" }, { 31, "TWSS_ISOB8" }, { 32, "TWSS_ISOB9" }, { 33, "TWSS_ISOB10" }, { 34, "TWSS_JISB0" },
+                    { 35, "TWSS_JISB1" }, { 36, "TWSS_JISB2" }, { 37, "TWSS_JISB3" }, { 38, "TWSS_JISB4" }, { 39, "TWSS_JISB6" }, { 40, "TWSS_JISB7" },
+                    { 41, "TWSS_JISB8" }, { 42, "TWSS_JISB9" }, { 43, "TWSS_JISB10" }, { 44, "TWSS_C0" }, { 45, "TWSS_C1" }, { 46, "TWSS_C2" },
+                    { 47, "TWSS_C3" }, { 48, "TWSS_C7" }, { 49, "TWSS_C8" }, { 50, "TWSS_C9" }, { 51, "TWSS_C10" }, { 52, "TWSS_USSTATEMENT" },
+                    { 53, "TWSS_BUSINESSCARD" }, { 54, "TWSS_MAXSIZE" }
+                };
+
+                inline constexpr twain_constant_name TWPH_names[] = {
+                    { 0, "TWPH_NORMAL" }, { 1, "TWPH_FRAGILE" }, { 2, "TWPH_THICK" }, { 3, "TWPH_TRIFOLD" }, { 4, "TWPH_PHOTOGRAPH" }
+                };
+
+                inline constexpr twain_constant_name TWCI_names[] = {
+                    { 0, "TWCI_INFO" }, { 1, "TWCI_WARNING" }, { 2, "TWCI_ERROR" }, { 3, "TWCI_WARMUP" }
+                };
+                struct table_info
+                {
+                    const twain_constant_name* names;
+                    std::size_t count;
+                };
+
+                // In the order of twain_constant_category
+                inline constexpr table_info tables[] = {
+                    { TWPT_names, std::size(TWPT_names) },
+                    { TWUN_names, std::size(TWUN_names) },
+                    { TWCY_names, std::size(TWCY_names) },
+                    { TWAL_names, std::size(TWAL_names) },
+                    { TWAS_names, std::size(TWAS_names) },
+                    { TWBCOR_names, std::size(TWBCOR_names) },
+                    { TWBD_names, std::size(TWBD_names) },
+                    { TWBO_names, std::size(TWBO_names) },
+                    { TWBP_names, std::size(TWBP_names) },
+                    { TWBR_names, std::size(TWBR_names) },
+                    { TWBT_names, std::size(TWBT_names) },
+                    { TWCP_names, std::size(TWCP_names) },
+                    { TWCS_names, std::size(TWCS_names) },
+                    { TWDE_names, std::size(TWDE_names) },
+                    { TWDR_names, std::size(TWDR_names) },
+                    { TWDSK_names, std::size(TWDSK_names) },
+                    { TWDX_names, std::size(TWDX_names) },
+                    { TWFA_names, std::size(TWFA_names) },
+                    { TWFE_names, std::size(TWFE_names) },
+                    { TWFF_names, std::size(TWFF_names) },
+                    { TWFL_names, std::size(TWFL_names) },
+                    { TWFO_names, std::size(TWFO_names) },
+                    { TWFP_names, std::size(TWFP_names) },
+                    { TWFR_names, std::size(TWFR_names) },
+                    { TWFT_names, std::size(TWFT_names) },
+                    { TWFY_names, std::size(TWFY_names) },
+                    { TWIA_names, std::size(TWIA_names) },
+                    { TWIC_names, std::size(TWIC_names) },
+                    { TWIF_names, std::size(TWIF_names) },
+                    { TWIM_names, std::size(TWIM_names) },
+                    { TWJC_names, std::size(TWJC_names) },
+                    { TWJQ_names, std::size(TWJQ_names) },
+                    { TWLP_names, std::size(TWLP_names) },
+                    { TWLS_names, std::size(TWLS_names) },
+                    { TWMD_names, std::size(TWMD_names) },
+                    { TWNF_names, std::size(TWNF_names) },
+                    { TWOR_names, std::size(TWOR_names) },
+                    { TWOV_names, std::size(TWOV_names) },
+                    { TWPA_names, std::size(TWPA_names) },
+                    { TWPC_names, std::size(TWPC_names) },
+                    { TWPCH_names, std::size(TWPCH_names) },
+                    { TWPF_names, std::size(TWPF_names) },
+                    { TWPM_names, std::size(TWPM_names) },
+                    { TWPR_names, std::size(TWPR_names) },
+                    { TWPF2_names, std::size(TWPF2_names) },
+                    { TWCT_names, std::size(TWCT_names) },
+                    { TWPS_names, std::size(TWPS_names) },
+                    { TWSS_names, std::size(TWSS_names) },
+                    { TWPH_names, std::size(TWPH_names) },
+                    { TWCI_names, std::size(TWCI_names) }
+                };
+                static_assert(std::size(tables) == static_cast<std::size_t>(twain_constant_category::TWCI) + 1,
+                              "A table is needed for each twain_constant_category");
+            }
+
+            /// Returns the name of the TWAIN constant **value** in **category**, or nullptr if there is no such constant.
+            ///
+            /// The tables are built at compile time, so this does not lock, allocate or call the DTWAIN library.
+            constexpr const char* find(twain_constant_category category, int32_t value) noexcept
+            {
+                const auto index = static_cast<std::size_t>(category);
+                if (index >= std::size(details::tables))
+                    return nullptr;
+                const auto& table = details::tables[index];
+                std::size_t lo = 0;
+                std::size_t hi = table.count;
+                while (lo < hi)
+                {
+                    const std::size_t mid = lo + (hi - lo) / 2;
+                    if (table.names[mid].value < value)
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+                return lo < table.count && table.names[lo].value == value ? table.names[lo].name : nullptr;
+            }
+        }
+    }
+}
+#endif
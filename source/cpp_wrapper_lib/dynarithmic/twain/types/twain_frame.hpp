@@ -24,6 +24,7 @@ OF THIRD PARTY RIGHTS.
 
 #include <limits>
 #include <functional>
+#include <tuple>
 
 namespace dynarithmic
 {
@@ -64,6 +65,8 @@ namespace dynarithmic
             {
                 return !(*this == tf);
             }
+
+            auto as_tuple() const noexcept { return std::tie(left, top, right, bottom); }
         };
     }
 }   
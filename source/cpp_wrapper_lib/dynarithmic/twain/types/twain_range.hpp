@@ -25,8 +25,12 @@ OF THIRD PARTY RIGHTS.
 #include <iterator>
 #include <array>
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <type_traits>
+#include <vector>
 #include <math.h>
 
 namespace dynarithmic
@@ -90,54 +94,62 @@ namespace dynarithmic
             return true;
         }
 
+        /// Iterates over the values of a twain_range without expanding the range.  Each value is computed as
+        /// minimum + index * step, so floating point ranges do not accumulate rounding errors.
         template <typename T=long>
         struct twainrange_iterator 
         {
             // iterator traits
-            using difference_type = T;
+            using difference_type = std::ptrdiff_t;
             using value_type = T;
             using pointer = const T*;
             using reference = const T&;
             using iterator_category = std::bidirectional_iterator_tag;
 
-            std::array<T,5> m_CurrentValue;
+            T m_Low;
+            T m_Step;
+            std::size_t m_Index;
             T m_CurrentDerefValue;
     
-            explicit twainrange_iterator() : m_CurrentDerefValue{} {}
-            explicit twainrange_iterator(const std::array<T,5>& start ) : m_CurrentValue(start), m_CurrentDerefValue(start[0]) {}
+            explicit twainrange_iterator() : m_Low{}, m_Step{}, m_Index(0), m_CurrentDerefValue{} {}
+            explicit twainrange_iterator(const std::array<T,5>& range, std::size_t index = 0) :
+                        m_Low(range[0]), m_Step(range[2]), m_Index(index), m_CurrentDerefValue(get_value()) {}
     
-            T& operator*() { return m_CurrentDerefValue; }
+            const T& operator*() const { return m_CurrentDerefValue; }
 
             twainrange_iterator& operator++()
             {
-                m_CurrentDerefValue += m_CurrentValue[2];
-                if ( m_CurrentDerefValue > m_CurrentValue[1])
-                    std::fill_n(m_CurrentValue.begin(), 5, (std::numeric_limits<T>::min)());
+                ++m_Index;
+                m_CurrentDerefValue = get_value();
                 return *this;
             }
 
             twainrange_iterator operator++(int)
             {
-                m_CurrentDerefValue += m_CurrentValue[2];
-                if ( m_CurrentDerefValue > m_CurrentValue[1])
-                    std::fill_n(m_CurrentValue.begin(), 5, (std::numeric_limits<T>::min)());
-                return *this;
+                twainrange_iterator temp(*this);
+                ++*this;
+                return temp;
             }
     
             twainrange_iterator& operator--()
             {
-                m_CurrentDerefValue -= m_CurrentValue[2];
+                --m_Index;
+                m_CurrentDerefValue = get_value();
                 return *this;
             }
 
             twainrange_iterator operator--(int)
             {
-                m_CurrentDerefValue -= m_CurrentValue[2];
-                return *this;
+                twainrange_iterator temp(*this);
+                --*this;
+                return temp;
             }
     
-            bool operator == ( const twainrange_iterator& that ) const { return m_CurrentValue == that.m_CurrentValue ; }
+            bool operator == ( const twainrange_iterator& that ) const { return m_Index == that.m_Index; }
             bool operator != ( const twainrange_iterator& that ) const { return !(*this == that); }
+
+            private:
+                T get_value() const { return static_cast<T>(m_Low + static_cast<T>(m_Index) * m_Step); }
         };
 
         template <typename T=long, typename std::enable_if<
@@ -145,84 +157,88 @@ namespace dynarithmic
                                 std::is_integral<T>::value, bool>::type = 1>
         class twain_range
         {
-            template<class T2, class = typename std::is_floating_point<T>::type>
-            struct Modulus : std::modulus<T2>
-            {};
-
-            template<class T2>
-            struct Modulus<T2, std::true_type> 
-         #if ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
-         #else
-            : std::binary_function<T2, T2, T2>
-         #endif
-            {
-                T2 operator()(T2 a, T2 b) const { return std::fmod(a, b); }
-            };
-
             std::array<T, 5> m_allValues;
-            std::array<T, 5> m_lastVal;
             bool m_isValid;
-            twainrange_iterator<T> m_EndIter;
+
+            // Returns the number of steps from the minimum value to the step nearest to value
+            static std::size_t get_nearest_step(T offset, T step, std::true_type /*is_floating_point*/)
+            {
+                return static_cast<std::size_t>(std::floor(offset / step + T(0.5)));
+            }
+
+            static std::size_t get_nearest_step(T offset, T step, std::false_type)
+            {
+                auto steps = offset / step;
+                if ((offset % step) * 2 >= step)
+                    ++steps;
+                return static_cast<std::size_t>(steps);
+            }
+
+            std::size_t get_nearest_step(T value) const
+            {
+                return get_nearest_step(static_cast<T>(value - m_allValues[0]), m_allValues[2], std::is_floating_point<T>());
+            }
+
+            bool is_in_bounds(T value, std::true_type /*is_floating_point*/) const
+            {
+                return (value > m_allValues[0] || is_close_to(value, m_allValues[0])) &&
+                       (value < m_allValues[1] || is_close_to(value, m_allValues[1]));
+            }
+
+            bool is_in_bounds(T value, std::false_type) const
+            {
+                return value >= m_allValues[0] && value <= m_allValues[1];
+            }
+
+            // Returns the number of steps from the minimum to the last value of the range.  The maximum may not be a
+            // multiple of the step, so a step past the maximum is not counted.
+            std::size_t get_last_step() const
+            {
+                if (m_allValues[2] == 0)
+                    return 0;
+                auto lastStep = get_nearest_step(m_allValues[1]);
+                if (lastStep > 0 && (*this)[lastStep] > m_allValues[1] && !is_close_to((*this)[lastStep], m_allValues[1]))
+                    --lastStep;
+                return lastStep;
+            }
+
+            void set_validity()
+            {
+                m_isValid = is_valid_range(m_allValues) && contains(get_current()) && contains(get_default());
+            }
+
             public:
                 typedef T value_type;
                 typedef twainrange_iterator<T> iterator;
                 typedef twainrange_iterator<T> const_iterator;
-                twain_range() : m_isValid(false), m_lastVal({(std::numeric_limits<T>::min)(), 
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)()}),
-                                                             m_EndIter(m_lastVal)
+                twain_range() : m_allValues{}, m_isValid(false)
                 {}
     
-                twain_range(T low, T high, T step, T current = T(), T defaultVal = T()) :
-                                                             m_lastVal({(std::numeric_limits<T>::min)(), 
-                                                                         (std::numeric_limits<T>::min)(),
-                                                                         (std::numeric_limits<T>::min)(),
-                                                                         (std::numeric_limits<T>::min)(),
-                                                                         (std::numeric_limits<T>::min)()}),
-                                                                         m_EndIter(m_lastVal)
+                twain_range(T low, T high, T step, T current = T(), T defaultVal = T())
                 {
                     m_allValues[0] = low;
                     m_allValues[1] = high;
                     m_allValues[2] = step;
                     m_allValues[3] = current;
                     m_allValues[4] = defaultVal;
-                    m_isValid = is_valid_range(m_allValues) &&
-                                value_exists(get_current()) &&
-                                value_exists(get_default());
+                    set_validity();
                 }
 
                 template <typename Iter>
-                twain_range(Iter it1, Iter it2) : m_allValues{}, 
-                                                 m_lastVal({(std::numeric_limits<T>::min)(), 
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)()}),
-                                                             m_EndIter(m_lastVal)
+                twain_range(Iter it1, Iter it2) : m_allValues{}
                 {
                     auto min_dist = (std::min)(m_allValues.size(), static_cast<size_t>(std::distance(it1, it2)));
                     std::copy(it1, it1 + min_dist, m_allValues.begin());
-                    m_isValid = is_valid_range(m_allValues) &&
-                                    value_exists(get_current()) &&
-                                    value_exists(get_default());
+                    set_validity();
                 }
 
                 template <typename Container,
                         typename std::enable_if<
                         std::is_same<typename Container::value_type, T>::value, bool>::type = 1>
-                twain_range(const Container& ct) : m_lastVal({(std::numeric_limits<T>::min)(), 
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)(),
-                                                             (std::numeric_limits<T>::min)()}),
-                                                             m_EndIter(m_lastVal)
+                twain_range(const Container& ct) : m_allValues{}
                 {
                     std::copy(ct.begin(), ct.begin() + (std::min)(m_allValues.size(), ct.size()), m_allValues.begin());
-                    m_isValid = is_valid_range(m_allValues) && 
-                                value_exists(get_current()) && 
-                                value_exists(get_default());
+                    set_validity();
                 }
 
                 T get_min() const { return m_allValues[0]; }
@@ -242,7 +258,7 @@ namespace dynarithmic
                 {
                     if (!m_isValid)
                             return 0;
-                    return static_cast<size_t>(std::abs(m_allValues[1] - m_allValues[0]) / m_allValues[2] + 1);
+                    return get_last_step() + 1;
                 }
 
                 template <typename Container=std::vector<T>, typename std::enable_if<
@@ -257,43 +273,49 @@ namespace dynarithmic
                     return ct;
                 }
 
-                T& operator[](size_t idx) 
-                { return m_allValues[0] + idx * m_allValues[2]; }
+                T operator[](size_t idx) const
+                { return static_cast<T>(m_allValues[0] + static_cast<T>(idx) * m_allValues[2]); }
 
-                const T& operator[](size_t idx) const
-                { return m_allValues[0] + idx * m_allValues[2]; }
-
-                template <typename T2>
-                bool value_exists(const T2& value_) const
+                /// Returns true if **value** is one of the values of the range.  This does not expand the range.
+                bool contains(T value) const
                 {
-                    T2 value = value_;
-                    // return immediately if step is 0
-                    if ( m_allValues[2] == 0 )
+                    if (m_allValues[2] == 0)
+                        return m_allValues[0] == m_allValues[1] && is_close_to(value, m_allValues[0]);
+                    if (!is_in_bounds(value, std::is_floating_point<T>()))
                         return false;
+                    return is_close_to((*this)[get_nearest_step((std::max)(value, m_allValues[0]))], value);
+                }
 
-                    // Check if value passed in is out of bounds
-                    if ( value < m_allValues[0] || value > m_allValues[1])
-                        return false;
+                /// Returns the value of the range that is nearest to **value**.  A value outside of the range is
+                /// moved to the minimum or the last value of the range.  If the range is not valid, **value** is
+                /// returned.
+                T nearest_valid(T value) const
+                {
+                    if (!is_valid_range(m_allValues))
+                        return value;
+                    if (m_allValues[2] == 0 || value <= m_allValues[0])
+                        return m_allValues[0];
+                    return (*this)[(std::min)(get_nearest_step((std::min)(value, m_allValues[1])), get_last_step())];
+                }
 
-                    // Get the nearest value to *pVariantIn;
-                    // First get the bias value from 0
-                    T lBias = 0;
-                    if ( m_allValues[0] != 0 )
-                        lBias = -m_allValues[0];
-
-                    value += lBias;
-                    Modulus<T2> fn;
-                    auto res = fn(value, m_allValues[2]);
-                    if ( res == 0 )
-                        return true;
-                    return false;
+                /// Returns true if **value** is one of the values of the range.  A floating point value is only a value of
+                /// an integral range if it has no fractional part and fits in **T**.
+                template <typename T2>
+                bool value_exists(const T2& value) const
+                {
+                    if constexpr (std::is_integral<T>::value && std::is_floating_point<T2>::value)
+                    {
+                        if (std::trunc(value) != value ||
+                            value < static_cast<T2>((std::numeric_limits<T>::min)()) ||
+                            value > static_cast<T2>((std::numeric_limits<T>::max)()))
+                            return false;
+                    }
+                    return contains(static_cast<T>(value));
                 }
 
                 // iterators
-                twainrange_iterator<T> begin() { return twainrange_iterator<T>(m_allValues);}
-                twainrange_iterator<T> end() { return m_EndIter;}
                 twainrange_iterator<T> begin() const { return twainrange_iterator<T>(m_allValues);}
-                twainrange_iterator<T> end() const { return m_EndIter;}
+                twainrange_iterator<T> end() const { return twainrange_iterator<T>(m_allValues, get_expand_count());}
         };
     }
 }
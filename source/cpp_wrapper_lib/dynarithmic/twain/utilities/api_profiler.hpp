@@ -0,0 +1,153 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_API_PROFILER_HPP
+#define DTWAIN_API_PROFILER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Call counts and timings of the DTWAIN functions called through the DYNDTWAIN_API function table.
+        ///
+        /// When dtwimpl.cpp is compiled with DTWAIN_API_PROFILE defined, and the profiler is enabled before the DTWAIN
+        /// library is loaded (i.e. before twain_session::start() is called), each DTWAIN function pointer is replaced with a
+        /// thunk that counts the calls and the time spent in the function.  If the profiler is not enabled, the function
+        /// pointers are not changed and there is no overhead.
+        ///
+        /// @note The times are inclusive.  For example, the time for DTWAIN_AcquireFileEx includes the time spent in
+        /// callbacks (and the DTWAIN functions they call) during the acquisition.
+        class api_profiler
+        {
+            public:
+                struct entry
+                {
+                    const char* name = nullptr;
+                    std::atomic<uint64_t> calls{ 0 };
+                    std::atomic<uint64_t> nanoseconds{ 0 };
+                };
+
+                /// Times one call to a DTWAIN function
+                class scope
+                {
+                    entry& m_entry;
+                    std::chrono::steady_clock::time_point m_start;
+                    public:
+                        explicit scope(entry& e) : m_entry(e), m_start(std::chrono::steady_clock::now()) {}
+                        scope(const scope&) = delete;
+                        scope& operator=(const scope&) = delete;
+                        ~scope()
+                        {
+                            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+                            m_entry.calls.fetch_add(1, std::memory_order_relaxed);
+                            m_entry.nanoseconds.fetch_add(static_cast<uint64_t>(elapsed), std::memory_order_relaxed);
+                        }
+                };
+
+            private:
+                std::atomic<bool> m_bEnabled{ false };
+                mutable std::mutex m_mutex;
+                std::vector<entry*> m_entries;
+
+                api_profiler() = default;
+
+            public:
+                static api_profiler& instance()
+                {
+                    static api_profiler profiler;
+                    return profiler;
+                }
+
+                api_profiler(const api_profiler&) = delete;
+                api_profiler& operator=(const api_profiler&) = delete;
+
+                /// Turns on profiling.  Must be called before the DTWAIN library is loaded.
+                api_profiler& enable(bool bEnable = true) { m_bEnabled.store(bEnable, std::memory_order_relaxed); return *this; }
+                bool is_enabled() const { return m_bEnabled.load(std::memory_order_relaxed); }
+
+                void register_entry(entry* e)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (std::find(m_entries.begin(), m_entries.end(), e) == m_entries.end())
+                        m_entries.push_back(e);
+                }
+
+                void reset()
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    for (auto* e : m_entries)
+                    {
+                        e->calls.store(0, std::memory_order_relaxed);
+                        e->nanoseconds.store(0, std::memory_order_relaxed);
+                    }
+                }
+
+                /// Returns a report of the DTWAIN functions that were called, sorted by total time (highest first)
+                ///
+                /// @param[in] maxLines If not 0, the maximum number of functions to list.
+                std::string get_report(std::size_t maxLines = 0) const
+                {
+                    struct line_info
+                    {
+                        const char* name;
+                        uint64_t calls;
+                        uint64_t nanoseconds;
+                    };
+                    std::vector<line_info> vLines;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        for (auto* e : m_entries)
+                        {
+                            const auto calls = e->calls.load(std::memory_order_relaxed);
+                            if (calls > 0)
+                                vLines.push_back({ e->name, calls, e->nanoseconds.load(std::memory_order_relaxed) });
+                        }
+                    }
+                    std::sort(vLines.begin(), vLines.end(), [](const line_info& l, const line_info& r)
+                        { return l.nanoseconds != r.nanoseconds ? l.nanoseconds > r.nanoseconds : l.calls > r.calls; });
+                    if (maxLines > 0 && vLines.size() > maxLines)
+                        vLines.resize(maxLines);
+
+                    std::ostringstream strm;
+                    strm << std::fixed << std::setprecision(3);
+                    strm << std::left << std::setw(40) << "Function" << std::right << std::setw(10) << "Calls"
+                         << std::setw(14) << "Total(ms)" << std::setw(14) << "Avg(us)" << "\n";
+                    for (auto& line : vLines)
+                    {
+                        strm << std::left << std::setw(40) << line.name << std::right << std::setw(10) << line.calls
+                             << std::setw(14) << static_cast<double>(line.nanoseconds) / 1000000.0
+                             << std::setw(14) << static_cast<double>(line.nanoseconds) / 1000.0 / static_cast<double>(line.calls) << "\n";
+                    }
+                    return strm.str();
+                }
+        };
+    }
+}
+#endif
@@ -0,0 +1,278 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_CALL_WATCHDOG_HPP
+#define DTWAIN_CALL_WATCHDOG_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Detects DTWAIN functions that do not return within a deadline.
+        ///
+        /// When dtwimpl.cpp is compiled with DTWAIN_API_PROFILE defined, and the watchdog is enabled before the DTWAIN
+        /// library is loaded (i.e. before twain_session::start() is called), each DTWAIN function called from the thread
+        /// that enabled the watchdog is tracked while it runs.  A monitor thread checks the calls in flight, and if one
+        /// runs longer than its deadline, the expiry handler is called (once) on the monitor thread.
+        ///
+        /// Since the thread that is stuck inside the TWAIN driver cannot be recovered, the handler would normally write
+        /// diagnostics and end the process.
+        class call_watchdog
+        {
+            public:
+                using duration_type = std::chrono::milliseconds;
+                static constexpr std::size_t max_call_depth = 32;
+
+                /// One DTWAIN function that is watched.  The deadline is 0 if the function has no deadline.
+                struct watched_function
+                {
+                    const char* name = nullptr;
+                    std::atomic<int64_t> deadline{ 0 };
+                };
+
+                struct call_info
+                {
+                    const char* name;
+                    duration_type elapsed;
+                    duration_type deadline;
+                };
+
+                /// Information given to the expiry handler.  **calls** lists all the DTWAIN calls in flight, outermost
+                /// first (for example, a function called from a DTWAIN callback while DTWAIN_AcquireFileEx is running).
+                struct expired_call
+                {
+                    call_info call;
+                    std::vector<call_info> calls;
+                };
+
+                using handler_type = std::function<void(const expired_call&)>;
+
+                /// Tracks one call to a DTWAIN function
+                class scope
+                {
+                    call_watchdog* m_watchdog = nullptr;
+                    std::size_t m_depth = 0;
+                    public:
+                        explicit scope(const watched_function& fn)
+                        {
+                            auto& wd = instance();
+                            if (wd.is_enabled() && std::this_thread::get_id() == wd.m_watched_thread)
+                            {
+                                m_depth = wd.m_depth.load(std::memory_order_relaxed);
+                                if (m_depth < max_call_depth)
+                                {
+                                    auto& frame = wd.m_frames[m_depth];
+                                    frame.start.store(now(), std::memory_order_relaxed);
+                                    frame.function.store(&fn, std::memory_order_release);
+                                    wd.m_depth.store(m_depth + 1, std::memory_order_release);
+                                    m_watchdog = &wd;
+                                }
+                            }
+                        }
+                        scope(const scope&) = delete;
+                        scope& operator=(const scope&) = delete;
+                        ~scope()
+                        {
+                            if (m_watchdog)
+                            {
+                                m_watchdog->m_depth.store(m_depth, std::memory_order_release);
+                                m_watchdog->m_frames[m_depth].function.store(nullptr, std::memory_order_release);
+                            }
+                        }
+                };
+
+            private:
+                struct call_frame
+                {
+                    std::atomic<const watched_function*> function{ nullptr };
+                    std::atomic<int64_t> start{ 0 };
+                };
+
+                std::atomic<bool> m_bEnabled{ false };
+                std::thread::id m_watched_thread;
+                std::array<call_frame, max_call_depth> m_frames;
+                std::atomic<std::size_t> m_depth{ 0 };
+
+                std::mutex m_mutex;
+                std::map<std::string, duration_type> m_deadlines;
+                duration_type m_default_deadline{ 0 };
+                std::vector<watched_function*> m_functions;
+
+                std::thread m_monitor;
+                std::condition_variable m_cv;
+                bool m_bStopMonitor = false;
+                bool m_bFired = false;
+                duration_type m_poll_interval{ 250 };
+                handler_type m_handler;
+
+                call_watchdog() = default;
+
+                static int64_t now()
+                {
+                    return std::chrono::duration_cast<duration_type>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                }
+
+                // m_mutex must be locked
+                duration_type get_deadline(const char* name) const
+                {
+                    auto iter = m_deadlines.find(name);
+                    return iter != m_deadlines.end() ? iter->second : m_default_deadline;
+                }
+
+                bool check()
+                {
+                    const std::size_t depth = m_depth.load(std::memory_order_acquire);
+                    const int64_t curTime = now();
+                    expired_call expired{};
+                    bool bExpired = false;
+                    for (std::size_t i = 0; i < depth && i < max_call_depth; ++i)
+                    {
+                        auto* fn = m_frames[i].function.load(std::memory_order_acquire);
+                        if (!fn)
+                            continue;
+                        const call_info info = { fn->name, duration_type(curTime - m_frames[i].start.load(std::memory_order_relaxed)),
+                                                 duration_type(fn->deadline.load(std::memory_order_relaxed)) };
+                        expired.calls.push_back(info);
+                        if (info.deadline.count() > 0 && info.elapsed > info.deadline)
+                        {
+                            // report the innermost call that has expired
+                            expired.call = info;
+                            bExpired = true;
+                        }
+                    }
+                    if (bExpired && m_handler)
+                        m_handler(expired);
+                    return bExpired;
+                }
+
+                void monitor_proc()
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    while (!m_bStopMonitor && !m_bFired)
+                    {
+                        m_cv.wait_for(lock, m_poll_interval);
+                        if (m_bStopMonitor)
+                            break;
+                        lock.unlock();
+                        const bool bFired = check();
+                        lock.lock();
+                        m_bFired = bFired;
+                    }
+                }
+
+            public:
+                static call_watchdog& instance()
+                {
+                    static call_watchdog watchdog;
+                    return watchdog;
+                }
+
+                call_watchdog(const call_watchdog&) = delete;
+                call_watchdog& operator=(const call_watchdog&) = delete;
+                ~call_watchdog() { stop(); }
+
+                /// Sets the deadline for the DTWAIN function **name** (for example, "DTWAIN_OpenSource").  A deadline of 0
+                /// means the function is not checked.
+                call_watchdog& set_deadline(const std::string& name, duration_type deadline)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_deadlines[name] = deadline;
+                    for (auto* fn : m_functions)
+                        fn->deadline.store(get_deadline(fn->name).count(), std::memory_order_relaxed);
+                    return *this;
+                }
+
+                /// Sets the deadline for the DTWAIN functions that do not have their own deadline
+                call_watchdog& set_default_deadline(duration_type deadline)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_default_deadline = deadline;
+                    for (auto* fn : m_functions)
+                        fn->deadline.store(get_deadline(fn->name).count(), std::memory_order_relaxed);
+                    return *this;
+                }
+
+                call_watchdog& set_poll_interval(duration_type interval) { m_poll_interval = interval; return *this; }
+
+                /// Sets the function called on the monitor thread when a call runs past its deadline
+                call_watchdog& set_handler(handler_type handler) { m_handler = std::move(handler); return *this; }
+
+                /// Turns on call tracking for the calling thread.  Must be called before the DTWAIN library is loaded.
+                call_watchdog& enable()
+                {
+                    m_watched_thread = std::this_thread::get_id();
+                    m_bEnabled.store(true, std::memory_order_release);
+                    return *this;
+                }
+
+                bool is_enabled() const { return m_bEnabled.load(std::memory_order_acquire); }
+
+                void register_function(watched_function* fn)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    fn->deadline.store(get_deadline(fn->name).count(), std::memory_order_relaxed);
+                    if (std::find(m_functions.begin(), m_functions.end(), fn) == m_functions.end())
+                        m_functions.push_back(fn);
+                }
+
+                /// Starts the monitor thread
+                void start()
+                {
+                    if (m_monitor.joinable())
+                        return;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_bStopMonitor = m_bFired = false;
+                    }
+                    m_monitor = std::thread(&call_watchdog::monitor_proc, this);
+                }
+
+                /// Stops the monitor thread
+                void stop()
+                {
+                    if (!m_monitor.joinable())
+                        return;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_bStopMonitor = true;
+                    }
+                    m_cv.notify_all();
+                    if (m_monitor.get_id() == std::this_thread::get_id())
+                        m_monitor.detach();
+                    else
+                        m_monitor.join();
+                }
+        };
+    }
+}
+#endif
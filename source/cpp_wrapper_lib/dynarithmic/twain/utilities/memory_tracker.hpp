@@ -0,0 +1,290 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_MEMORY_TRACKER_HPP
+#define DTWAIN_MEMORY_TRACKER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+#endif
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// Tracks the memory held by the image buffers of a TWAIN session, and the high-water marks of that memory for each
+        /// stage of the session and for each acquisition (job).
+        ///
+        /// The following pools are tracked:
+        ///  - page_buffer:  the DIBs of pages that have been transferred, and not yet saved to a file (or, for acquisitions
+        ///                  to memory, not yet handed to an image_handler, which moves them to the image store).
+        ///  - strip_buffer:  the strip allocated for buffered transfers.
+        ///  - image_store:  the DIBs held by image_handler objects.
+        ///
+        /// Memory that DTWAIN allocates internally (for example, the queues used by the file encoders) cannot be seen by
+        /// the tracker, so the process private bytes are also sampled at the start and end of each stage and at each page.
+        /// The process peak of a stage is the highest of these samples.
+        ///
+        /// Stages are identified by an index less than max_stages (twain_statistics uses its stage enumeration).  The
+        /// tracker does nothing until enabled, which is done by twain_statistics::enable().
+        class memory_tracker
+        {
+            public:
+                enum class pool
+                {
+                    page_buffer,
+                    strip_buffer,
+                    image_store,
+                    pool_count
+                };
+
+                static constexpr std::size_t pool_count = static_cast<std::size_t>(pool::pool_count);
+                static constexpr std::size_t max_stages = 32;
+
+                /// High-water marks, in bytes
+                struct usage
+                {
+                    uint64_t tracked = 0;   // all the tracked pools
+                    uint64_t process = 0;   // process private bytes (0 if not available)
+                };
+
+            private:
+                std::atomic<bool> m_bEnabled{ false };
+                std::array<std::atomic<int64_t>, pool_count> m_current{};
+                std::array<std::atomic<uint64_t>, pool_count> m_peak{};
+                std::atomic<int64_t> m_total{ 0 };
+                std::atomic<uint64_t> m_total_peak{ 0 };
+                std::atomic<uint64_t> m_process_peak{ 0 };
+                std::atomic<uint32_t> m_active_stages{ 0 };
+                std::array<std::atomic<uint64_t>, max_stages> m_stage_peak{};
+                std::array<std::atomic<uint64_t>, max_stages> m_stage_process_peak{};
+                std::atomic<bool> m_bInJob{ false };
+                std::atomic<uint64_t> m_job_peak{ 0 };
+                std::atomic<uint64_t> m_job_process_peak{ 0 };
+                mutable std::mutex m_job_mutex;
+                std::vector<usage> m_jobs;
+
+                memory_tracker() = default;
+
+                static void update_peak(std::atomic<uint64_t>& peak, uint64_t value)
+                {
+                    uint64_t current = peak.load(std::memory_order_relaxed);
+                    while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+                        ;
+                }
+
+                static uint64_t to_bytes(int64_t value) { return value > 0 ? static_cast<uint64_t>(value) : 0; }
+
+                // Adds the tracked total to the peaks of the job and the stages that are running
+                void update_total(int64_t delta)
+                {
+                    const uint64_t total = to_bytes(m_total.fetch_add(delta, std::memory_order_relaxed) + delta);
+                    update_peak(m_total_peak, total);
+                    if (m_bInJob.load(std::memory_order_relaxed))
+                        update_peak(m_job_peak, total);
+                    const uint32_t stages = m_active_stages.load(std::memory_order_relaxed);
+                    for (std::size_t i = 0; i < max_stages && (stages >> i); ++i)
+                    {
+                        if (stages & (1u << i))
+                            update_peak(m_stage_peak[i], total);
+                    }
+                }
+
+            public:
+                static memory_tracker& instance()
+                {
+                    static memory_tracker tracker;
+                    return tracker;
+                }
+
+                memory_tracker(const memory_tracker&) = delete;
+                memory_tracker& operator=(const memory_tracker&) = delete;
+
+                memory_tracker& enable(bool bEnable = true) { m_bEnabled.store(bEnable, std::memory_order_relaxed); return *this; }
+                bool is_enabled() const { return m_bEnabled.load(std::memory_order_relaxed); }
+
+                /// Returns the private bytes of the process, or 0 if this is not available
+                static uint64_t get_process_memory()
+                {
+                    #ifdef _WIN32
+                    PROCESS_MEMORY_COUNTERS_EX counters = {};
+                    if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof counters))
+                        return static_cast<uint64_t>(counters.PrivateUsage);
+                    #endif
+                    return 0;
+                }
+
+                void allocate(pool p, uint64_t bytes)
+                {
+                    if (!is_enabled() || bytes == 0)
+                        return;
+                    const auto index = static_cast<std::size_t>(p);
+                    const int64_t delta = static_cast<int64_t>(bytes);
+                    update_peak(m_peak[index], to_bytes(m_current[index].fetch_add(delta, std::memory_order_relaxed) + delta));
+                    update_total(delta);
+                }
+
+                void release(pool p, uint64_t bytes)
+                {
+                    if (!is_enabled() || bytes == 0)
+                        return;
+                    const int64_t delta = static_cast<int64_t>(bytes);
+                    m_current[static_cast<std::size_t>(p)].fetch_sub(delta, std::memory_order_relaxed);
+                    update_total(-delta);
+                }
+
+                /// Sets the number of bytes held in a pool
+                void set(pool p, uint64_t bytes)
+                {
+                    if (!is_enabled())
+                        return;
+                    const auto index = static_cast<std::size_t>(p);
+                    const int64_t value = static_cast<int64_t>(bytes);
+                    const int64_t old = m_current[index].exchange(value, std::memory_order_relaxed);
+                    update_peak(m_peak[index], bytes);
+                    update_total(value - old);
+                }
+
+                /// Moves **bytes** from one pool to another, for memory that changes owner without being copied.  Only the
+                /// bytes still held in **from** are taken out of it (the pool may have been cleared in the meantime), so the
+                /// total grows by the remainder.
+                void move(pool from, pool to, uint64_t bytes)
+                {
+                    if (!is_enabled() || bytes == 0)
+                        return;
+                    auto& source = m_current[static_cast<std::size_t>(from)];
+                    int64_t held = source.load(std::memory_order_relaxed);
+                    int64_t taken = 0;
+                    do
+                    {
+                        taken = static_cast<int64_t>((std::min)(to_bytes(held), bytes));
+                    } while (!source.compare_exchange_weak(held, held - taken, std::memory_order_relaxed));
+                    const auto index = static_cast<std::size_t>(to);
+                    const int64_t delta = static_cast<int64_t>(bytes);
+                    update_peak(m_peak[index], to_bytes(m_current[index].fetch_add(delta, std::memory_order_relaxed) + delta));
+                    update_total(delta - taken);
+                }
+
+                /// Samples the process private bytes, and adds it to the peaks of the job and the stages that are running
+                void sample()
+                {
+                    if (!is_enabled())
+                        return;
+                    const uint64_t process = get_process_memory();
+                    update_peak(m_process_peak, process);
+                    if (m_bInJob.load(std::memory_order_relaxed))
+                        update_peak(m_job_process_peak, process);
+                    const uint32_t stages = m_active_stages.load(std::memory_order_relaxed);
+                    for (std::size_t i = 0; i < max_stages && (stages >> i); ++i)
+                    {
+                        if (stages & (1u << i))
+                            update_peak(m_stage_process_peak[i], process);
+                    }
+                }
+
+                void stage_begin(std::size_t stage)
+                {
+                    if (!is_enabled() || stage >= max_stages)
+                        return;
+                    m_active_stages.fetch_or(1u << stage, std::memory_order_relaxed);
+                    update_peak(m_stage_peak[stage], to_bytes(m_total.load(std::memory_order_relaxed)));
+                    sample();
+                }
+
+                void stage_end(std::size_t stage)
+                {
+                    if (!is_enabled() || stage >= max_stages)
+                        return;
+                    sample();
+                    m_active_stages.fetch_and(~(1u << stage), std::memory_order_relaxed);
+                }
+
+                /// Called when an acquisition starts
+                void job_begin()
+                {
+                    if (!is_enabled())
+                        return;
+                    m_job_peak.store(to_bytes(m_total.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+                    m_job_process_peak.store(0, std::memory_order_relaxed);
+                    m_bInJob.store(true, std::memory_order_relaxed);
+                    sample();
+                }
+
+                /// Called when an acquisition ends.  The peaks of the acquisition are added to get_job_usage().
+                void job_end()
+                {
+                    if (!is_enabled() || !m_bInJob.load(std::memory_order_relaxed))
+                        return;
+                    sample();
+                    m_bInJob.store(false, std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock(m_job_mutex);
+                    m_jobs.push_back({ m_job_peak.load(std::memory_order_relaxed), m_job_process_peak.load(std::memory_order_relaxed) });
+                }
+
+                uint64_t get_current(pool p) const { return to_bytes(m_current[static_cast<std::size_t>(p)].load(std::memory_order_relaxed)); }
+                uint64_t get_peak(pool p) const { return m_peak[static_cast<std::size_t>(p)].load(std::memory_order_relaxed); }
+
+                /// Returns the peaks over the whole session
+                usage get_peak_usage() const
+                {
+                    return { m_total_peak.load(std::memory_order_relaxed), m_process_peak.load(std::memory_order_relaxed) };
+                }
+
+                /// Returns the peaks while **stage** was running
+                usage get_stage_usage(std::size_t stage) const
+                {
+                    if (stage >= max_stages)
+                        return {};
+                    return { m_stage_peak[stage].load(std::memory_order_relaxed), m_stage_process_peak[stage].load(std::memory_order_relaxed) };
+                }
+
+                /// Returns the peaks of each acquisition, in the order the acquisitions were done
+                std::vector<usage> get_job_usage() const
+                {
+                    std::lock_guard<std::mutex> lock(m_job_mutex);
+                    return m_jobs;
+                }
+
+                /// Clears the peaks.  The bytes currently held in each pool are kept.
+                void reset()
+                {
+                    for (std::size_t i = 0; i < pool_count; ++i)
+                        m_peak[i].store(to_bytes(m_current[i].load(std::memory_order_relaxed)), std::memory_order_relaxed);
+                    m_total_peak.store(to_bytes(m_total.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+                    m_process_peak.store(0, std::memory_order_relaxed);
+                    for (std::size_t i = 0; i < max_stages; ++i)
+                    {
+                        m_stage_peak[i].store(0, std::memory_order_relaxed);
+                        m_stage_process_peak[i].store(0, std::memory_order_relaxed);
+                    }
+                    std::lock_guard<std::mutex> lock(m_job_mutex);
+                    m_jobs.clear();
+                }
+        };
+    }
+}
+#endif
@@ -0,0 +1,254 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifndef DTWAIN_METRICS_REGISTRY_HPP
+#define DTWAIN_METRICS_REGISTRY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        /// A registry of counters and gauges that can be written in the Prometheus text exposition format.
+        ///
+        /// Metrics are created (or found) by name and labels, and the returned reference stays valid for the life of the
+        /// program.  Look a metric up once and keep the reference, since updating a metric is a single relaxed atomic
+        /// operation that does not lock.
+        class metrics_registry
+        {
+            public:
+                enum class metric_type
+                {
+                    counter,
+                    gauge
+                };
+
+                class metric
+                {
+                    std::atomic<int64_t> m_value{ 0 };
+                    public:
+                        void increment(int64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+                        void decrement(int64_t n = 1) { m_value.fetch_sub(n, std::memory_order_relaxed); }
+                        void set(int64_t n) { m_value.store(n, std::memory_order_relaxed); }
+                        int64_t get() const { return m_value.load(std::memory_order_relaxed); }
+                };
+
+            private:
+                struct entry
+                {
+                    metric_type type;
+                    std::string name;
+                    std::string help;
+                    std::string labels;     // for example:  code="-1001"
+                    double scale;           // the value is multiplied by this when written
+                    metric value;
+                    const metric* rate_source = nullptr;   // for rate gauges, the counter the rate is computed from
+                    double rate_period = 0;
+                    int64_t rate_last = 0;
+                    std::chrono::steady_clock::time_point rate_time;
+                };
+
+                mutable std::mutex m_mutex;
+                std::deque<entry> m_entries;
+
+                metrics_registry() = default;
+
+                // m_mutex must be locked
+                entry* find(const std::string& name, const std::string& labels)
+                {
+                    auto iter = std::find_if(m_entries.begin(), m_entries.end(), [&](const entry& e)
+                        { return e.name == name && e.labels == labels; });
+                    return iter != m_entries.end() ? &*iter : nullptr;
+                }
+
+                metric& get_metric(metric_type type, const std::string& name, const std::string& help, const std::string& labels, double scale)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (auto* e = find(name, labels))
+                        return e->value;
+                    m_entries.emplace_back();
+                    auto& e = m_entries.back();
+                    e.type = type;
+                    e.name = name;
+                    e.help = help;
+                    e.labels = labels;
+                    e.scale = scale;
+                    return e.value;
+                }
+
+            public:
+                static metrics_registry& instance()
+                {
+                    static metrics_registry registry;
+                    return registry;
+                }
+
+                metrics_registry(const metrics_registry&) = delete;
+                metrics_registry& operator=(const metrics_registry&) = delete;
+
+                /// Returns the counter **name**, creating it if it does not exist
+                ///
+                /// @param[in] labels Prometheus labels (for example, code="-1001"), or an empty string.
+                /// @param[in] scale The value written is the counter's value multiplied by **scale** (for example, 1e-6 for a
+                /// counter of microseconds written as seconds).
+                metric& get_counter(const std::string& name, const std::string& help, const std::string& labels = "", double scale = 1.0)
+                {
+                    return get_metric(metric_type::counter, name, help, labels, scale);
+                }
+
+                /// Returns the gauge **name**, creating it if it does not exist
+                metric& get_gauge(const std::string& name, const std::string& help, const std::string& labels = "", double scale = 1.0)
+                {
+                    return get_metric(metric_type::gauge, name, help, labels, scale);
+                }
+
+                /// Adds a gauge that is the rate of increase of **source** per **period_seconds** (for example, 60 for a rate per
+                /// minute), measured between successive calls to write_prometheus().
+                void add_rate(const std::string& name, const std::string& help, const metric& source, double period_seconds)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (find(name, ""))
+                        return;
+                    m_entries.emplace_back();
+                    auto& e = m_entries.back();
+                    e.type = metric_type::gauge;
+                    e.name = name;
+                    e.help = help;
+                    e.scale = 1.0;
+                    e.rate_source = &source;
+                    e.rate_period = period_seconds;
+                    e.rate_last = source.get();
+                    e.rate_time = std::chrono::steady_clock::now();
+                }
+
+                /// Writes all the metrics in the Prometheus text exposition format
+                void write_prometheus(std::ostream& out)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    const auto now = std::chrono::steady_clock::now();
+                    std::vector<entry*> vEntries;
+                    for (auto& e : m_entries)
+                        vEntries.push_back(&e);
+                    std::stable_sort(vEntries.begin(), vEntries.end(), [](const entry* l, const entry* r) { return l->name < r->name; });
+
+                    const std::string* lastName = nullptr;
+                    for (auto* e : vEntries)
+                    {
+                        if (!lastName || *lastName != e->name)
+                        {
+                            out << "# HELP " << e->name << " " << e->help << "\n";
+                            out << "# TYPE " << e->name << (e->type == metric_type::counter ? " counter\n" : " gauge\n");
+                            lastName = &e->name;
+                        }
+                        out << e->name;
+                        if (!e->labels.empty())
+                            out << "{" << e->labels << "}";
+                        if (e->rate_source)
+                        {
+                            const int64_t value = e->rate_source->get();
+                            const double seconds = std::chrono::duration<double>(now - e->rate_time).count();
+                            const double rate = seconds > 0 ? static_cast<double>(value - e->rate_last) * e->rate_period / seconds : 0.0;
+                            e->rate_last = value;
+                            e->rate_time = now;
+                            out << " " << rate << "\n";
+                        }
+                        else
+                        if (e->scale != 1.0)
+                            out << " " << static_cast<double>(e->value.get()) * e->scale << "\n";
+                        else
+                            out << " " << e->value.get() << "\n";
+                    }
+                }
+
+                std::string get_prometheus_text()
+                {
+                    std::ostringstream strm;
+                    write_prometheus(strm);
+                    return strm.str();
+                }
+        };
+
+        /// Exports the metrics_registry in the Prometheus text format, on background threads.
+        ///
+        /// The metrics can be written to a file at a regular interval (written to a temporary file and then renamed, so that
+        /// a reader such as the node_exporter textfile collector never sees a partly written file), and can be served over
+        /// HTTP at http://127.0.0.1:<port>/metrics, so that a Prometheus server can scrape them while the job runs.
+        class metrics_exporter
+        {
+            std::string m_strFile;
+            int m_nPort = 0;
+            std::chrono::milliseconds m_interval{ 15000 };
+            std::thread m_thread;
+            std::thread m_http_thread;
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            bool m_bStop = false;
+            std::atomic<bool> m_bStopHttp{ false };
+            std::intptr_t m_listen_socket = -1;
+            bool m_bSocketsStarted = false;
+
+            bool write_file(const std::string& text) const;
+            bool start_listening();
+            void thread_proc();
+            void http_proc();
+
+            public:
+                metrics_exporter() = default;
+                metrics_exporter(const metrics_exporter&) = delete;
+                metrics_exporter& operator=(const metrics_exporter&) = delete;
+                ~metrics_exporter() { stop(); }
+
+                /// Writes the metrics to **fileName** every interval
+                metrics_exporter& set_file(std::string fileName) { m_strFile = std::move(fileName); return *this; }
+
+                /// Serves the metrics over HTTP on port **port** of 127.0.0.1.  Requests for "/metrics" are answered with the
+                /// current values, in the Prometheus text format.
+                metrics_exporter& set_port(int port) { m_nPort = port; return *this; }
+
+                /// Sets the time between writes of the metrics file
+                metrics_exporter& set_interval(std::chrono::milliseconds interval) { m_interval = interval; return *this; }
+
+                /// Writes the metrics file now.  Returns false if the file could not be written.
+                bool export_now() const;
+
+                /// Starts writing the metrics file every interval, and starts the HTTP listener if a port was set
+                void start();
+
+                /// Returns true if the HTTP listener is running
+                bool is_listening() const { return m_http_thread.joinable(); }
+
+                /// Stops the background threads, and writes the metrics file one last time
+                void stop();
+        };
+    }
+}
+#endif
@@ -0,0 +1,259 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifdef _WIN32
+    // winsock2.h must come before windows.h
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #include <windows.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <sys/select.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+    #include <cstdio>
+#endif
+#include <cstring>
+#include <fstream>
+#include <dynarithmic/twain/utilities/metrics_registry.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        namespace
+        {
+            #ifdef _WIN32
+            using socket_type = SOCKET;
+            const socket_type invalid_socket_value = INVALID_SOCKET;
+            void close_socket(socket_type s) { closesocket(s); }
+            #else
+            using socket_type = int;
+            const socket_type invalid_socket_value = -1;
+            void close_socket(socket_type s) { close(s); }
+            #endif
+
+            constexpr std::size_t max_request_size = 8192;
+
+            bool send_all(socket_type s, const std::string& text)
+            {
+                std::size_t sent = 0;
+                while (sent < text.size())
+                {
+                    const auto n = send(s, text.data() + sent, static_cast<int>(text.size() - sent), 0);
+                    if (n <= 0)
+                        return false;
+                    sent += static_cast<std::size_t>(n);
+                }
+                return true;
+            }
+
+            // Reads the request line and headers of one HTTP request, and answers it.  Only "GET /metrics" (and HEAD) are
+            // served, and the connection is closed after the response.
+            void serve_request(socket_type client)
+            {
+                #ifdef _WIN32
+                DWORD timeout = 2000;
+                #else
+                timeval timeout = { 2, 0 };
+                #endif
+                setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof timeout);
+
+                std::string request;
+                char buffer[1024];
+                while (request.find("\r\n\r\n") == std::string::npos && request.size() < max_request_size)
+                {
+                    const auto n = recv(client, buffer, static_cast<int>(sizeof buffer), 0);
+                    if (n <= 0)
+                        break;
+                    request.append(buffer, static_cast<std::size_t>(n));
+                }
+
+                // Request line is "<method> <target> HTTP/1.x"
+                const auto lineEnd = request.find("\r\n");
+                const std::string requestLine = request.substr(0, lineEnd);
+                const auto methodEnd = requestLine.find(' ');
+                const auto targetEnd = methodEnd == std::string::npos ? std::string::npos : requestLine.find(' ', methodEnd + 1);
+                if (lineEnd == std::string::npos || targetEnd == std::string::npos)
+                {
+                    send_all(client, "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+                    return;
+                }
+                const std::string method = requestLine.substr(0, methodEnd);
+                std::string target = requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+                target = target.substr(0, target.find('?'));
+
+                if (method != "GET" && method != "HEAD")
+                {
+                    send_all(client, "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET, HEAD\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+                    return;
+                }
+                if (target != "/metrics")
+                {
+                    send_all(client, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+                    return;
+                }
+                const std::string text = metrics_registry::instance().get_prometheus_text();
+                std::string response = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                       "Content-Length: " + std::to_string(text.size()) + "\r\nConnection: close\r\n\r\n";
+                if (method == "GET")
+                    response += text;
+                send_all(client, response);
+            }
+        }
+
+        bool metrics_exporter::write_file(const std::string& text) const
+        {
+            const std::string tempName = m_strFile + ".tmp";
+            {
+                std::ofstream ofs(tempName, std::ios::binary | std::ios::trunc);
+                if (!ofs)
+                    return false;
+                ofs << text;
+                if (!ofs)
+                    return false;
+            }
+            #ifdef _WIN32
+            return MoveFileExA(tempName.c_str(), m_strFile.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+            #else
+            return std::rename(tempName.c_str(), m_strFile.c_str()) == 0;
+            #endif
+        }
+
+        bool metrics_exporter::start_listening()
+        {
+            #ifdef _WIN32
+            if (!m_bSocketsStarted)
+            {
+                WSADATA wsaData;
+                m_bSocketsStarted = WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+                if (!m_bSocketsStarted)
+                    return false;
+            }
+            #endif
+            socket_type s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (s == invalid_socket_value)
+                return false;
+            #ifndef _WIN32
+            int reuse = 1;
+            setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof reuse);
+            #endif
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<unsigned short>(m_nPort));
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (bind(s, reinterpret_cast<const sockaddr*>(&addr), sizeof addr) != 0 || listen(s, 8) != 0)
+            {
+                close_socket(s);
+                return false;
+            }
+            m_listen_socket = static_cast<std::intptr_t>(s);
+            return true;
+        }
+
+        void metrics_exporter::http_proc()
+        {
+            const auto listener = static_cast<socket_type>(m_listen_socket);
+            while (!m_bStopHttp.load(std::memory_order_acquire))
+            {
+                // Wake up regularly to check if the exporter is being stopped
+                fd_set readSet;
+                FD_ZERO(&readSet);
+                FD_SET(listener, &readSet);
+                timeval timeout = { 0, 250000 };
+                if (select(static_cast<int>(listener) + 1, &readSet, nullptr, nullptr, &timeout) <= 0)
+                    continue;
+                socket_type client = accept(listener, nullptr, nullptr);
+                if (client == invalid_socket_value)
+                    continue;
+                serve_request(client);
+                close_socket(client);
+            }
+        }
+
+        void metrics_exporter::thread_proc()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_bStop)
+            {
+                m_cv.wait_for(lock, m_interval);
+                if (m_bStop)
+                    break;
+                lock.unlock();
+                export_now();
+                lock.lock();
+            }
+        }
+
+        bool metrics_exporter::export_now() const
+        {
+            if (m_strFile.empty())
+                return true;
+            return write_file(metrics_registry::instance().get_prometheus_text());
+        }
+
+        void metrics_exporter::start()
+        {
+            if (m_nPort > 0 && !m_http_thread.joinable() && start_listening())
+            {
+                m_bStopHttp.store(false, std::memory_order_release);
+                m_http_thread = std::thread(&metrics_exporter::http_proc, this);
+            }
+            if (m_thread.joinable() || m_strFile.empty())
+                return;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_bStop = false;
+            }
+            m_thread = std::thread(&metrics_exporter::thread_proc, this);
+        }
+
+        void metrics_exporter::stop()
+        {
+            if (m_http_thread.joinable())
+            {
+                m_bStopHttp.store(true, std::memory_order_release);
+                m_http_thread.join();
+            }
+            if (m_listen_socket != -1)
+            {
+                close_socket(static_cast<socket_type>(m_listen_socket));
+                m_listen_socket = -1;
+            }
+            #ifdef _WIN32
+            if (m_bSocketsStarted)
+                WSACleanup();
+            #endif
+            m_bSocketsStarted = false;
+
+            if (!m_thread.joinable())
+                return;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_bStop = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+            export_now();
+        }
+    }
+}
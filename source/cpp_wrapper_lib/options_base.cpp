@@ -28,7 +28,7 @@ namespace dynarithmic
 {
     namespace twain
     {
-        void options_base::apply(twain_source& ts, pages_options& po)
+        void options_base::apply(twain_source& ts, const pages_options& po)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values<CAP_SEGMENTED_>({ static_cast<capability_type::segmented_type>(po.m_SegmentedValue) });
@@ -46,7 +46,7 @@ namespace dynarithmic
                 ci.set_cap_values<ICAP_SUPPORTEDSIZES_>({});
         }
 
-        void options_base::apply(twain_source& ts, jobcontrol_options& jc)
+        void options_base::apply(twain_source& ts, const jobcontrol_options& jc)
         {
             auto& ci = ts.get_capability_interface();
             if (ci.is_cap_supported(CAP_JOBCONTROL))
@@ -55,7 +55,7 @@ namespace dynarithmic
             }
         }
 
-        void options_base::apply(twain_source& ts, paperhandling_options& po)
+        void options_base::apply(twain_source& ts, const paperhandling_options& po)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_AUTOFEED_>({ po.m_bAutoFeed });
@@ -70,7 +70,7 @@ namespace dynarithmic
             ci.set_cap_values< CAP_PAPERHANDLING_>(po.m_vPaperHandling);
         }
 
-        void options_base::apply(twain_source& ts, imagetype_options& io)
+        void options_base::apply(twain_source& ts, const imagetype_options& io)
         {
             auto& ci = ts.get_capability_interface();
             if (io.m_PixelType != color_value::default_color)
@@ -122,7 +122,7 @@ namespace dynarithmic
             fo.m_twain_source = ts.get_source();
         }
 
-        void options_base::apply(twain_source& ts, compression_options& co)
+        void options_base::apply(twain_source& ts, const compression_options& co)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< ICAP_COMPRESSION_>({ co.m_CompressionValue });
@@ -137,14 +137,14 @@ namespace dynarithmic
             ci.set_cap_values< ICAP_TIMEFILL_>({ co.m_TimeFill });
         }
 
-        void options_base::apply(twain_source& ts, userinterface_options& ui)
+        void options_base::apply(twain_source& ts, const userinterface_options& ui)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_INDICATORS_>({ ui.m_bShowIndicators });
             ci.set_cap_values< CAP_INDICATORSMODE_>(ui.m_vIndicatorMode);
         }
 
-        void options_base::apply(twain_source& ts, language_options& lo)
+        void options_base::apply(twain_source& ts, const language_options& lo)
         {
             auto& ci = ts.get_capability_interface();
             if (lo.m_Language != language_value::default_val)
@@ -153,7 +153,7 @@ namespace dynarithmic
                 ci.set_cap_values< CAP_LANGUAGE_>({});
         }
 
-        void options_base::apply(twain_source& ts, deviceparams_options& dp)
+        void options_base::apply(twain_source& ts, const deviceparams_options& dp)
         {
             auto& ci = ts.get_capability_interface();
             if (dp.m_unitvalue != units_value::default_val)
@@ -180,7 +180,7 @@ namespace dynarithmic
                 ci.set_cap_values< ICAP_ZOOMFACTOR_>({ dp.m_zoomFactor });
         }
 
-        void options_base::apply(twain_source& ts, powermonitor_options& po)
+        void options_base::apply(twain_source& ts, const powermonitor_options& po)
         {
             if (po.m_powersavetime != powermonitor_options::default_val)
             {
@@ -189,7 +189,7 @@ namespace dynarithmic
             }
         }
 
-        void options_base::apply(twain_source& ts, doublefeed_options& df)
+        void options_base::apply(twain_source& ts, const doublefeed_options& df)
         {
             auto& ci = ts.get_capability_interface();
             if (df.m_detection != doublefeeddetection_value::default_val)
@@ -203,7 +203,7 @@ namespace dynarithmic
             ci.set_cap_values< CAP_DOUBLEFEEDDETECTIONRESPONSE_>(df.m_vResponses);
         };
 
-        void options_base::apply(twain_source& ts, autoadjust_options& ao)
+        void options_base::apply(twain_source& ts, const autoadjust_options& ao)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_AUTOMATICSENSEMEDIUM_>({ ao.m_bSenseMedium });
@@ -224,7 +224,7 @@ namespace dynarithmic
                 ci.set_cap_values< ICAP_IMAGEMERGEHEIGHTTHRESHOLD_>({ ao.m_ImageMergeHeightThreshold });
         }
 
-        void options_base::apply(twain_source& ts, barcodedetection_options& bo)
+        void options_base::apply(twain_source& ts, const barcodedetection_options& bo)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< ICAP_BARCODEDETECTIONENABLED_>({ bo.m_bDetectionEnabled });
@@ -239,7 +239,7 @@ namespace dynarithmic
             }
         }
 
-        void options_base::apply(twain_source& ts, patchcode_options& pc)
+        void options_base::apply(twain_source& ts, const patchcode_options& pc)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< ICAP_PATCHCODEDETECTIONENABLED_>({ pc.m_bDetectionEnabled });
@@ -254,7 +254,7 @@ namespace dynarithmic
             }
         }
 
-        void options_base::apply(twain_source& ts, autocapture_options& ac)
+        void options_base::apply(twain_source& ts, const autocapture_options& ac)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_AUTOMATICCAPTURE_>({ ac.m_NumImages });
@@ -262,7 +262,7 @@ namespace dynarithmic
             ci.set_cap_values< CAP_TIMEBETWEENCAPTURES_>({ ac.m_TimeBetween });
         }
 
-        void options_base::apply(twain_source& ts, imageinformation_options& io)
+        void options_base::apply(twain_source& ts, const imageinformation_options& io)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_AUTHOR_>({ io.m_sAuthor });
@@ -270,7 +270,7 @@ namespace dynarithmic
             ci.set_cap_values< ICAP_EXTIMAGEINFO_>({ io.m_bExtImageInfo });
         }
 
-        void options_base::apply(twain_source& ts, imageparameter_options& io)
+        void options_base::apply(twain_source& ts, const imageparameter_options& io)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_THUMBNAILSENABLED_>({ io.m_bThumbnailsEnabled });
@@ -287,7 +287,7 @@ namespace dynarithmic
             ci.set_cap_values< ICAP_IMAGEDATASET_>(io.m_vImageDataSets);
         }
 
-        void options_base::apply(twain_source& ts, audiblealarms_options& aa)
+        void options_base::apply(twain_source& ts, const audiblealarms_options& aa)
         {
             auto& ci = ts.get_capability_interface();
             if (aa.m_AlarmVolume != audiblealarms_options::disable_volume)
@@ -296,13 +296,13 @@ namespace dynarithmic
                 ci.set_cap_values< CAP_ALARMS_>({ a });
         }
 
-        void options_base::apply(twain_source& ts, deviceevent_options& dopt)
+        void options_base::apply(twain_source& ts, const deviceevent_options& dopt)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_DEVICEEVENT_>(dopt.m_vDeviceEvents);
         }
 
-        void options_base::apply(twain_source& ts, resolution_options& ro)
+        void options_base::apply(twain_source& ts, const resolution_options& ro)
         {
             auto& ci = ts.get_capability_interface();
             if (ro.m_xResolution != (std::numeric_limits<double>::min)())
@@ -311,7 +311,7 @@ namespace dynarithmic
                 ci.set_cap_values< ICAP_YRESOLUTION_>({ ro.m_yResolution });
         }
 
-        void options_base::apply(twain_source& ts, color_options& co)
+        void options_base::apply(twain_source& ts, const color_options& co)
         {
             auto& ci = ts.get_capability_interface();
             if (co.m_Gamma != color_options::disable_gamma)
@@ -324,7 +324,7 @@ namespace dynarithmic
             ci.set_cap_values< ICAP_PLANARCHUNKY_>({ co.m_PlanarChunkyValue });
         }
 
-        void options_base::apply(twain_source& ts, capnegotiation_options& co)
+        void options_base::apply(twain_source& ts, const capnegotiation_options& co)
         {
             if (co.m_bSetExtendedCaps)
             {
@@ -333,13 +333,13 @@ namespace dynarithmic
             }
         }
 
-        void options_base::apply(twain_source& ts, micr_options& mo)
+        void options_base::apply(twain_source& ts, const micr_options& mo)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_MICRENABLED_>({ mo.m_bMicrEnabled });
         }
 
-        void options_base::apply(twain_source& ts, imprinter_options& io)
+        void options_base::apply(twain_source& ts, const imprinter_options& io)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values< CAP_PRINTERENABLED_>({ io.m_bEnable });
@@ -360,7 +360,7 @@ namespace dynarithmic
             }
         }
 
-        void options_base::apply(twain_source& ts, autoscanning_options& ao)
+        void options_base::apply(twain_source& ts, const autoscanning_options& ao)
         {
             auto& ci = ts.get_capability_interface();
             ci.set_cap_values<CAP_AUTOSCAN_>({ ao.m_bAutoScan });
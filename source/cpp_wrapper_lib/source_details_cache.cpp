@@ -0,0 +1,102 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <dynarithmic/twain/session/source_details_cache.hpp>
+#include <dynarithmic/twain/capability_interface/capability_failure_store.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        // Each device is a line with the device key and the size of the details, followed by the details and a newline:
+        // device <tab> size
+        static constexpr const char* details_cache_header = "# TWAIN device details";
+
+        bool source_details_cache::load()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_details.clear();
+            m_bModified = false;
+            if (m_strFile.empty())
+                return true;
+            std::ifstream ifs(m_strFile, std::ios::binary);
+            if (!ifs)
+                return true;
+            std::string line;
+            while (std::getline(ifs, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (line.empty() || line.front() == '#')
+                    continue;
+                const auto tab = line.rfind('\t');
+                if (tab == std::string::npos)
+                    return false;
+                std::size_t nSize = 0;
+                try
+                {
+                    nSize = static_cast<std::size_t>(std::stoull(line.substr(tab + 1)));
+                }
+                catch (const std::exception&)
+                {
+                    return false;
+                }
+                std::string details(nSize, '\0');
+                if (nSize > 0 && !ifs.read(&details[0], static_cast<std::streamsize>(nSize)))
+                    return false;
+                ifs.ignore(1);  // the newline that ends the details
+                m_details[line.substr(0, tab)] = std::move(details);
+            }
+            return true;
+        }
+
+        bool source_details_cache::save()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_strFile.empty() || !m_bModified)
+                return true;
+            const std::string tempName = m_strFile + ".tmp";
+            {
+                std::ofstream ofs(tempName, std::ios::binary | std::ios::trunc);
+                if (!ofs)
+                    return false;
+                ofs << details_cache_header << "\n";
+                for (auto& d : m_details)
+                    ofs << capability_failure_store::make_field(d.first) << "\t" << d.second.size() << "\n" << d.second << "\n";
+                if (!ofs)
+                    return false;
+            }
+            #ifdef _WIN32
+            const bool bOk = MoveFileExA(tempName.c_str(), m_strFile.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+            #else
+            const bool bOk = std::rename(tempName.c_str(), m_strFile.c_str()) == 0;
+            #endif
+            if (bOk)
+                m_bModified = false;
+            return bOk;
+        }
+    }
+}
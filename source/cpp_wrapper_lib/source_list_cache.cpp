@@ -0,0 +1,178 @@
+/*
+This file is part of the Dynarithmic TWAIN Library (DTWAIN).
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <dynarithmic/twain/session/source_list_cache.hpp>
+#include <dynarithmic/twain/capability_interface/capability_failure_store.hpp>
+
+namespace dynarithmic
+{
+    namespace twain
+    {
+        // The file has the fingerprint line, followed by one line per device:
+        // fingerprint <tab> value
+        // source <tab> manufacturer <tab> product family <tab> product name <tab> version info
+        static constexpr const char* source_list_header = "# TWAIN devices";
+
+        std::string source_list_cache::get_directory_fingerprint()
+        {
+            #ifdef _WIN32
+            char szWinDir[MAX_PATH] = {};
+            if (!GetWindowsDirectoryA(szWinDir, MAX_PATH))
+                return {};
+            #ifdef _WIN64
+            const std::filesystem::path dsDir = std::filesystem::path(szWinDir) / "twain_64";
+            #else
+            const std::filesystem::path dsDir = std::filesystem::path(szWinDir) / "twain_32";
+            #endif
+
+            std::error_code ec;
+            if (!std::filesystem::is_directory(dsDir, ec))
+                return {};
+            std::vector<std::string> vEntries;
+            const auto addEntry = [&](const std::filesystem::path& path, uintmax_t size)
+            {
+                std::error_code ecTime;
+                const auto writeTime = std::filesystem::last_write_time(path, ecTime);
+                vEntries.push_back(path.u8string() + "\t" + std::to_string(size) + "\t" +
+                                   std::to_string(writeTime.time_since_epoch().count()));
+            };
+            addEntry(dsDir, 0);
+            for (std::filesystem::recursive_directory_iterator iter(dsDir, std::filesystem::directory_options::skip_permission_denied, ec), end;
+                 !ec && iter != end; iter.increment(ec))
+            {
+                std::error_code ecEntry;
+                if (iter->is_directory(ecEntry))
+                    addEntry(iter->path(), 0);
+                else
+                {
+                    std::string ext = iter->path().extension().u8string();
+                    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+                    if (ext == ".ds")
+                        addEntry(iter->path(), iter->file_size(ecEntry));
+                }
+            }
+            if (ec)
+                return {};
+            std::sort(vEntries.begin(), vEntries.end());
+
+            // 64-bit FNV-1a, so that the fingerprint does not depend on the standard library
+            uint64_t hash = 14695981039346656037ULL;
+            for (auto& entry : vEntries)
+            {
+                for (unsigned char ch : entry)
+                {
+                    hash ^= ch;
+                    hash *= 1099511628211ULL;
+                }
+                hash ^= '\n';
+                hash *= 1099511628211ULL;
+            }
+            std::ostringstream strm;
+            strm << vEntries.size() << "-" << std::hex << hash;
+            return strm.str();
+            #else
+            return {};
+            #endif
+        }
+
+        bool source_list_cache::load()
+        {
+            m_sources.clear();
+            m_fingerprint.clear();
+            if (m_strFile.empty())
+                return false;
+            std::ifstream ifs(m_strFile, std::ios::binary);
+            if (!ifs)
+                return false;
+            std::string fingerprint;
+            std::vector<twain_identity> vSources;
+            std::string line;
+            while (std::getline(ifs, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (line.empty() || line.front() == '#')
+                    continue;
+                std::istringstream strm(line);
+                std::string type;
+                std::getline(strm, type, '\t');
+                if (type == "fingerprint")
+                    std::getline(strm, fingerprint);
+                else
+                if (type == "source")
+                {
+                    std::string manufacturer, family, productName, versionInfo;
+                    if (!std::getline(strm, manufacturer, '\t') || !std::getline(strm, family, '\t') ||
+                        !std::getline(strm, productName, '\t'))
+                        return false;
+                    std::getline(strm, versionInfo);
+                    twain_identity id;
+                    id.set_manufacturer(manufacturer).set_product_family(family).set_product_name(productName).set_version_info(versionInfo);
+                    vSources.push_back(id);
+                }
+                else
+                    return false;
+            }
+            if (fingerprint.empty())
+                return false;
+            m_fingerprint = std::move(fingerprint);
+            m_sources = std::move(vSources);
+            return true;
+        }
+
+        bool source_list_cache::save() const
+        {
+            if (m_strFile.empty() || m_fingerprint.empty())
+                return false;
+            const std::string tempName = m_strFile + ".tmp";
+            {
+                std::ofstream ofs(tempName, std::ios::binary | std::ios::trunc);
+                if (!ofs)
+                    return false;
+                ofs << source_list_header << "\n" << "fingerprint\t" << m_fingerprint << "\n";
+                for (auto& source : m_sources)
+                {
+                    ofs << "source\t" << capability_failure_store::make_field(source.get_manufacturer()) << "\t"
+                        << capability_failure_store::make_field(source.get_product_family()) << "\t"
+                        << capability_failure_store::make_field(source.get_product_name()) << "\t"
+                        << capability_failure_store::make_field(source.get_version_info()) << "\n";
+                }
+                if (!ofs)
+                    return false;
+            }
+            #ifdef _WIN32
+            return MoveFileExA(tempName.c_str(), m_strFile.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+            #else
+            return std::rename(tempName.c_str(), m_strFile.c_str()) == 0;
+            #endif
+        }
+    }
+}
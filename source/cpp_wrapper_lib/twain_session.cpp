@@ -21,9 +21,14 @@ OF THIRD PARTY RIGHTS.
 
 #include <dynarithmic/twain/session/twain_session.hpp>
 #include <dynarithmic/twain/logging/logger_callback.hpp>
+#include <dynarithmic/twain/logging/trace_recorder.hpp>
+#include <dynarithmic/twain/session/twain_metrics.hpp>
+#include <dynarithmic/twain/types/twain_constant_names.hpp>
 #include <dynarithmic/twain/twain_source.hpp>
+#include <dynarithmic/twain/utilities/memory_tracker.hpp>
 #include <dynarithmic/twain/utilities/string_utilities.hpp>
 #include <chrono>
+#include <cstdio>
 #include <thread>
 
 #if __cplusplus >= 201703L
@@ -50,6 +55,252 @@ namespace dynarithmic
             return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
         }                
 
+        struct trace_name_entry
+        {
+            LONG value;
+            const char* name;
+        };
+
+        #define TRACE_NAME(x) {x, #x}
+        static constexpr trace_name_entry s_trace_notification_names[] = {
+                TRACE_NAME(DTWAIN_TN_ACQUIREDONE), TRACE_NAME(DTWAIN_TN_ACQUIREFAILED), TRACE_NAME(DTWAIN_TN_ACQUIRECANCELLED),
+                TRACE_NAME(DTWAIN_TN_ACQUIRESTARTED), TRACE_NAME(DTWAIN_TN_PAGECONTINUE), TRACE_NAME(DTWAIN_TN_PAGEFAILED),
+                TRACE_NAME(DTWAIN_TN_PAGECANCELLED), TRACE_NAME(DTWAIN_TN_TRANSFERREADY), TRACE_NAME(DTWAIN_TN_TRANSFERDONE),
+                TRACE_NAME(DTWAIN_TN_UICLOSING), TRACE_NAME(DTWAIN_TN_UICLOSED), TRACE_NAME(DTWAIN_TN_UIOPENED),
+                TRACE_NAME(DTWAIN_TN_UIOPENING), TRACE_NAME(DTWAIN_TN_UIOPENFAILURE), TRACE_NAME(DTWAIN_TN_CLIPTRANSFERDONE),
+                TRACE_NAME(DTWAIN_TN_INVALIDIMAGEFORMAT), TRACE_NAME(DTWAIN_TN_ACQUIRETERMINATED), TRACE_NAME(DTWAIN_TN_TRANSFERSTRIPREADY),
+                TRACE_NAME(DTWAIN_TN_TRANSFERSTRIPDONE), TRACE_NAME(DTWAIN_TN_TRANSFERSTRIPFAILED), TRACE_NAME(DTWAIN_TN_IMAGEINFOERROR),
+                TRACE_NAME(DTWAIN_TN_TRANSFERCANCELLED), TRACE_NAME(DTWAIN_TN_FILESAVECANCELLED), TRACE_NAME(DTWAIN_TN_FILESAVEOK),
+                TRACE_NAME(DTWAIN_TN_FILESAVEERROR), TRACE_NAME(DTWAIN_TN_FILEPAGESAVEOK), TRACE_NAME(DTWAIN_TN_FILEPAGESAVEERROR),
+                TRACE_NAME(DTWAIN_TN_PROCESSEDDIB), TRACE_NAME(DTWAIN_TN_FEEDERLOADED), TRACE_NAME(DTWAIN_TN_GENERALERROR),
+                TRACE_NAME(DTWAIN_TN_MANDUPFLIPPAGES), TRACE_NAME(DTWAIN_TN_MANDUPSIDE1DONE), TRACE_NAME(DTWAIN_TN_MANDUPSIDE2DONE),
+                TRACE_NAME(DTWAIN_TN_MANDUPPAGECOUNTERROR), TRACE_NAME(DTWAIN_TN_MANDUPACQUIREDONE), TRACE_NAME(DTWAIN_TN_MANDUPSIDE1START),
+                TRACE_NAME(DTWAIN_TN_MANDUPSIDE2START), TRACE_NAME(DTWAIN_TN_MANDUPMERGEERROR), TRACE_NAME(DTWAIN_TN_MANDUPMEMORYERROR),
+                TRACE_NAME(DTWAIN_TN_MANDUPFILEERROR), TRACE_NAME(DTWAIN_TN_MANDUPFILESAVEERROR), TRACE_NAME(DTWAIN_TN_ENDOFJOBDETECTED),
+                TRACE_NAME(DTWAIN_TN_EOJDETECTED_XFERDONE), TRACE_NAME(DTWAIN_TN_QUERYPAGEDISCARD), TRACE_NAME(DTWAIN_TN_PAGEDISCARDED),
+                TRACE_NAME(DTWAIN_TN_PROCESSDIBACCEPTED), TRACE_NAME(DTWAIN_TN_PROCESSDIBFINALACCEPTED), TRACE_NAME(DTWAIN_TN_CLOSEDIBFAILED),
+                TRACE_NAME(DTWAIN_TN_INVALID_TWAINDSM2_BITMAP), TRACE_NAME(DTWAIN_TN_IMAGE_RESAMPLE_FAILURE), TRACE_NAME(DTWAIN_TN_DEVICEEVENT),
+                TRACE_NAME(DTWAIN_TN_TWAINPAGECANCELLED), TRACE_NAME(DTWAIN_TN_TWAINPAGEFAILED), TRACE_NAME(DTWAIN_TN_APPUPDATEDDIB),
+                TRACE_NAME(DTWAIN_TN_FILEPAGESAVING), TRACE_NAME(DTWAIN_TN_EOJBEGINFILESAVE), TRACE_NAME(DTWAIN_TN_EOJENDFILESAVE),
+                TRACE_NAME(DTWAIN_TN_CROPFAILED), TRACE_NAME(DTWAIN_TN_PROCESSEDDIBFINAL), TRACE_NAME(DTWAIN_TN_BLANKPAGEDETECTED1),
+                TRACE_NAME(DTWAIN_TN_BLANKPAGEDETECTED2), TRACE_NAME(DTWAIN_TN_BLANKPAGEDETECTED3), TRACE_NAME(DTWAIN_TN_BLANKPAGEDISCARDED1),
+                TRACE_NAME(DTWAIN_TN_BLANKPAGEDISCARDED2), TRACE_NAME(DTWAIN_TN_OCRTEXTRETRIEVED), TRACE_NAME(DTWAIN_TN_QUERYOCRTEXT),
+                TRACE_NAME(DTWAIN_TN_PDFOCRREADY), TRACE_NAME(DTWAIN_TN_PDFOCRDONE), TRACE_NAME(DTWAIN_TN_PDFOCRERROR),
+                TRACE_NAME(DTWAIN_TN_SETCALLBACKINIT), TRACE_NAME(DTWAIN_TN_SETCALLBACK64INIT), TRACE_NAME(DTWAIN_TN_FILENAMECHANGING),
+                TRACE_NAME(DTWAIN_TN_FILENAMECHANGED), TRACE_NAME(DTWAIN_TN_PROCESSEDAUDIOFINAL), TRACE_NAME(DTWAIN_TN_PROCESSAUDIOFINALACCEPTED),
+                TRACE_NAME(DTWAIN_TN_PROCESSEDAUDIOFILE), TRACE_NAME(DTWAIN_TN_TWAINTRIPLETBEGIN), TRACE_NAME(DTWAIN_TN_TWAINTRIPLETEND),
+                TRACE_NAME(DTWAIN_TN_FEEDERNOTLOADED), TRACE_NAME(DTWAIN_TN_FEEDERTIMEOUT), TRACE_NAME(DTWAIN_TN_FEEDERNOTENABLED),
+                TRACE_NAME(DTWAIN_TN_FEEDERNOTSUPPORTED), TRACE_NAME(DTWAIN_TN_FEEDERTOFLATBED), TRACE_NAME(DTWAIN_TN_PREACQUIRESTART),
+                TRACE_NAME(DTWAIN_TN_TRANSFERTILEREADY), TRACE_NAME(DTWAIN_TN_TRANSFERTILEDONE), TRACE_NAME(DTWAIN_TN_FILECOMPRESSTYPEMISMATCH)
+        };
+
+        static constexpr trace_name_entry s_trace_dat_names[] = {
+                TRACE_NAME(DAT_CAPABILITY), TRACE_NAME(DAT_EVENT), TRACE_NAME(DAT_IDENTITY),
+                TRACE_NAME(DAT_PARENT), TRACE_NAME(DAT_PENDINGXFERS), TRACE_NAME(DAT_SETUPMEMXFER),
+                TRACE_NAME(DAT_SETUPFILEXFER), TRACE_NAME(DAT_STATUS), TRACE_NAME(DAT_USERINTERFACE),
+                TRACE_NAME(DAT_XFERGROUP), TRACE_NAME(DAT_CUSTOMDSDATA), TRACE_NAME(DAT_DEVICEEVENT),
+                TRACE_NAME(DAT_FILESYSTEM), TRACE_NAME(DAT_PASSTHRU), TRACE_NAME(DAT_CALLBACK),
+                TRACE_NAME(DAT_STATUSUTF8), TRACE_NAME(DAT_CALLBACK2), TRACE_NAME(DAT_METRICS),
+                TRACE_NAME(DAT_TWAINDIRECT), TRACE_NAME(DAT_IMAGEINFO), TRACE_NAME(DAT_IMAGELAYOUT),
+                TRACE_NAME(DAT_IMAGEMEMXFER), TRACE_NAME(DAT_IMAGENATIVEXFER), TRACE_NAME(DAT_IMAGEFILEXFER),
+                TRACE_NAME(DAT_CIECOLOR), TRACE_NAME(DAT_GRAYRESPONSE), TRACE_NAME(DAT_RGBRESPONSE),
+                TRACE_NAME(DAT_JPEGCOMPRESSION), TRACE_NAME(DAT_PALETTE8), TRACE_NAME(DAT_EXTIMAGEINFO),
+                TRACE_NAME(DAT_FILTER), TRACE_NAME(DAT_AUDIOFILEXFER), TRACE_NAME(DAT_AUDIOINFO),
+                TRACE_NAME(DAT_AUDIONATIVEXFER), TRACE_NAME(DAT_ICCPROFILE), TRACE_NAME(DAT_IMAGEMEMFILEXFER),
+                TRACE_NAME(DAT_ENTRYPOINT), TRACE_NAME(DAT_TWUNKIDENTITY), TRACE_NAME(DAT_SETUPFILEXFER2)
+        };
+
+        static constexpr trace_name_entry s_trace_msg_names[] = {
+                TRACE_NAME(MSG_GET), TRACE_NAME(MSG_GETCURRENT), TRACE_NAME(MSG_GETDEFAULT),
+                TRACE_NAME(MSG_GETFIRST), TRACE_NAME(MSG_GETNEXT), TRACE_NAME(MSG_SET),
+                TRACE_NAME(MSG_RESET), TRACE_NAME(MSG_QUERYSUPPORT), TRACE_NAME(MSG_GETHELP),
+                TRACE_NAME(MSG_GETLABEL), TRACE_NAME(MSG_GETLABELENUM), TRACE_NAME(MSG_SETCONSTRAINT),
+                TRACE_NAME(MSG_XFERREADY), TRACE_NAME(MSG_CLOSEDSREQ), TRACE_NAME(MSG_CLOSEDSOK),
+                TRACE_NAME(MSG_DEVICEEVENT), TRACE_NAME(MSG_OPENDSM), TRACE_NAME(MSG_CLOSEDSM),
+                TRACE_NAME(MSG_OPENDS), TRACE_NAME(MSG_CLOSEDS), TRACE_NAME(MSG_USERSELECT),
+                TRACE_NAME(MSG_DISABLEDS), TRACE_NAME(MSG_ENABLEDS), TRACE_NAME(MSG_ENABLEDSUIONLY),
+                TRACE_NAME(MSG_PROCESSEVENT), TRACE_NAME(MSG_ENDXFER), TRACE_NAME(MSG_STOPFEEDER),
+                TRACE_NAME(MSG_CHANGEDIRECTORY), TRACE_NAME(MSG_CREATEDIRECTORY), TRACE_NAME(MSG_DELETE),
+                TRACE_NAME(MSG_FORMATMEDIA), TRACE_NAME(MSG_GETCLOSE), TRACE_NAME(MSG_GETFIRSTFILE),
+                TRACE_NAME(MSG_GETINFO), TRACE_NAME(MSG_GETNEXTFILE), TRACE_NAME(MSG_RENAME),
+                TRACE_NAME(MSG_COPY), TRACE_NAME(MSG_AUTOMATICCAPTUREDIRECTORY), TRACE_NAME(MSG_PASSTHRU),
+                TRACE_NAME(MSG_REGISTER_CALLBACK), TRACE_NAME(MSG_RESETALL), TRACE_NAME(MSG_SETTASK),
+                TRACE_NAME(MSG_CHECKSTATUS)
+        };
+
+        static constexpr trace_name_entry s_trace_dg_names[] = {
+                TRACE_NAME(DG_CONTROL), TRACE_NAME(DG_IMAGE), TRACE_NAME(DG_AUDIO)
+        };
+        #undef TRACE_NAME
+
+        template <std::size_t N>
+        static const char* find_trace_name(const trace_name_entry (&names)[N], LONG value)
+        {
+            for (auto& entry : names)
+            {
+                if (entry.value == value)
+                    return entry.name;
+            }
+            return nullptr;
+        }
+
+        // Builds "DG_xxx/DAT_xxx/MSG_xxx" for the triplet currently being sent to the TWAIN DSM
+        static void get_current_triplet_name(char* buffer, std::size_t bufferSize)
+        {
+            TW_IDENTITY appID = {};
+            TW_IDENTITY sourceID = {};
+            LONG dg = 0, dat = 0, msg = 0;
+            LONG64 memRef = 0;
+            if (!API_INSTANCE DTWAIN_GetCurrentTwainTriplet(&appID, &sourceID, &dg, &dat, &msg, &memRef))
+            {
+                snprintf(buffer, bufferSize, "triplet");
+                return;
+            }
+            const char* dgName = find_trace_name(s_trace_dg_names, dg);
+            const char* datName = find_trace_name(s_trace_dat_names, dat);
+            const char* msgName = find_trace_name(s_trace_msg_names, msg);
+            char dgText[16], datText[16], msgText[16];
+            if (!dgName)
+            {
+                snprintf(dgText, sizeof dgText, "DG_%lX", static_cast<unsigned long>(dg));
+                dgName = dgText;
+            }
+            if (!datName)
+            {
+                snprintf(datText, sizeof datText, "DAT_%lX", static_cast<unsigned long>(dat));
+                datName = datText;
+            }
+            if (!msgName)
+            {
+                snprintf(msgText, sizeof msgText, "MSG_%lX", static_cast<unsigned long>(msg));
+                msgName = msgText;
+            }
+            snprintf(buffer, bufferSize, "%s/%s/%s", dgName, datName, msgName);
+        }
+
+        // Adds a DTWAIN notification to the trace.  Triplet begin / end notifications become duration events, and the
+        // acquisition, page transfer and page save notifications are paired up into complete events.
+        // Notifications are only sent on the thread running the TWAIN message loop, so the state here is not shared.
+        static void trace_notification(LONG notification, LPARAM lParam)
+        {
+            auto& recorder = trace_recorder::instance();
+            if (!recorder.is_enabled())
+                return;
+            static uint64_t s_acquire_start = 0;
+            static uint64_t s_transfer_start = 0;
+            static uint64_t s_save_start = 0;
+            static bool s_bInAcquire = false;
+            static bool s_bInTransfer = false;
+            static bool s_bInSave = false;
+
+            using category = trace_recorder::category;
+            if (notification == DTWAIN_TN_TWAINTRIPLETBEGIN || notification == DTWAIN_TN_TWAINTRIPLETEND)
+            {
+                char name[trace_recorder::max_name_size];
+                get_current_triplet_name(name, sizeof name);
+                if (notification == DTWAIN_TN_TWAINTRIPLETBEGIN)
+                    recorder.begin(category::triplet, name);
+                else
+                    recorder.end(category::triplet, name);
+                return;
+            }
+
+            const char* name = find_trace_name(s_trace_notification_names, notification);
+            char nameText[32];
+            if (!name)
+            {
+                snprintf(nameText, sizeof nameText, "notification %ld", static_cast<long>(notification));
+                name = nameText;
+            }
+            recorder.instant(category::notification, name, static_cast<int64_t>(lParam));
+
+            const uint64_t now = recorder.now();
+            switch (notification)
+            {
+                case DTWAIN_TN_ACQUIRESTARTED:
+                    s_acquire_start = now;
+                    s_bInAcquire = true;
+                break;
+
+                case DTWAIN_TN_ACQUIREDONE:
+                case DTWAIN_TN_ACQUIREFAILED:
+                case DTWAIN_TN_ACQUIRECANCELLED:
+                case DTWAIN_TN_ACQUIRETERMINATED:
+                    if (s_bInAcquire)
+                        recorder.complete(category::transfer, "acquisition", s_acquire_start, now - s_acquire_start);
+                    s_bInAcquire = false;
+                break;
+
+                case DTWAIN_TN_TRANSFERREADY:
+                    s_transfer_start = now;
+                    s_bInTransfer = true;
+                break;
+
+                case DTWAIN_TN_TRANSFERDONE:
+                case DTWAIN_TN_TRANSFERCANCELLED:
+                case DTWAIN_TN_TRANSFERSTRIPFAILED:
+                    if (s_bInTransfer)
+                        recorder.complete(category::transfer, "page transfer", s_transfer_start, now - s_transfer_start);
+                    s_bInTransfer = false;
+                break;
+
+                case DTWAIN_TN_FILEPAGESAVING:
+                    s_save_start = now;
+                    s_bInSave = true;
+                break;
+
+                case DTWAIN_TN_FILEPAGESAVEOK:
+                case DTWAIN_TN_FILEPAGESAVEERROR:
+                case DTWAIN_TN_FILESAVEOK:
+                case DTWAIN_TN_FILESAVEERROR:
+                case DTWAIN_TN_FILESAVECANCELLED:
+                    if (s_bInSave)
+                        recorder.complete(category::transfer, "page save", s_save_start, now - s_save_start);
+                    s_bInSave = false;
+                break;
+            }
+        }
+
+        // Tracks the size of the DIB of each page from the time it is transferred until it is saved.  DIBs that are not
+        // saved (acquisitions to memory) are held until they are handed to an image_handler, which moves them to the image
+        // store, or until the acquisition ends.  lParam is the DTWAIN_SOURCE.
+        static void track_page_memory(LONG notification, LPARAM lParam)
+        {
+            auto& memory = memory_tracker::instance();
+            if (!memory.is_enabled())
+                return;
+            static uint64_t s_last_page_size = 0;
+            switch (notification)
+            {
+                case DTWAIN_TN_TRANSFERDONE:
+                {
+                    const HANDLE hDib = API_INSTANCE DTWAIN_GetCurrentAcquiredImage(reinterpret_cast<DTWAIN_SOURCE>(lParam));
+                    s_last_page_size = hDib ? static_cast<uint64_t>(::GlobalSize(hDib)) : 0;
+                    memory.allocate(memory_tracker::pool::page_buffer, s_last_page_size);
+                    memory.sample();
+                }
+                break;
+
+                case DTWAIN_TN_FILEPAGESAVEOK:
+                case DTWAIN_TN_FILEPAGESAVEERROR:
+                case DTWAIN_TN_FILESAVEOK:
+                case DTWAIN_TN_FILESAVEERROR:
+                case DTWAIN_TN_FILESAVECANCELLED:
+                    memory.sample();
+                    memory.release(memory_tracker::pool::page_buffer, s_last_page_size);
+                    s_last_page_size = 0;
+                break;
+
+                case DTWAIN_TN_ACQUIREDONE:
+                case DTWAIN_TN_ACQUIREFAILED:
+                case DTWAIN_TN_ACQUIRECANCELLED:
+                case DTWAIN_TN_ACQUIRETERMINATED:
+                    memory.set(memory_tracker::pool::page_buffer, 0);
+                    s_last_page_size = 0;
+                break;
+            }
+        }
+
         bool twain_session::start(bool bCleanStart)
         {
 #ifdef DTWAIN_CPP_NOIMPORTLIB
@@ -84,15 +335,12 @@ namespace dynarithmic
             {
                 if (bCleanStart)
                 {
-                    m_bOCRStarted = false;
+                    // The OCR interface is started by start_ocr() when it is first needed
+                    m_bOCRStarted = m_bOCRInitialized = false;
+                    m_loaded_language.clear();
                     m_Handle = API_INSTANCE DTWAIN_SysInitialize();
                     if (m_Handle)
-                    {
-                        if (!API_INSTANCE DTWAIN_InitOCRInterface())
-                            m_error_logger.add_error(API_INSTANCE DTWAIN_GetLastError());
-                        else
-                            m_bOCRStarted = true;
-                    }
+                        m_loaded_language = "english";
                 }
                 if (!m_Handle)
                 {
@@ -102,25 +350,12 @@ namespace dynarithmic
             }
 
             API_INSTANCE DTWAIN_SetErrorCallback64(error_callback_proc, PtrToInt64(this)); 
-            API_INSTANCE DTWAIN_LoadCustomStringResourcesA(m_twain_characteristics.get_language().c_str());
 
-            auto sz = API_INSTANCE DTWAIN_GetShortVersionStringA(nullptr, 0);
-            std::vector<char> retBuf(sz + 1);
-            API_INSTANCE DTWAIN_GetShortVersionStringA(retBuf.data(), static_cast<int32_t>(retBuf.size()));
-            m_short_name = retBuf.data();
-
-            sz = API_INSTANCE DTWAIN_GetVersionStringA(nullptr, 0);
-            retBuf.resize(sz + 1);
-            API_INSTANCE DTWAIN_GetVersionStringA(retBuf.data(), static_cast<int32_t>(retBuf.size()));
-            m_long_name = retBuf.data();
-
-            retBuf.resize(1024);
-            API_INSTANCE DTWAIN_GetLibraryPathA(retBuf.data(), static_cast<int32_t>(retBuf.size()));
-            m_dtwain_path = retBuf.data();
-
-            retBuf.resize(1024);
-            API_INSTANCE DTWAIN_GetVersionCopyrightA(retBuf.data(), static_cast<int32_t>(retBuf.size()));
-            m_version_copyright = retBuf.data();
+            // DTWAIN_SysInitialize() loads the default (english) resources, so only load the resources if another language
+            // is used.  The version strings and paths are retrieved when they are first asked for.
+            if (m_twain_characteristics.get_language() != m_loaded_language)
+                load_language_resources(m_twain_characteristics.get_language());
+            clear_session_info();
 
             if (m_logger.second/* && m_logger.second->is_enabled()*/)
                 setup_logging();
@@ -159,16 +394,6 @@ namespace dynarithmic
                 auto& app_info = m_twain_characteristics.get_app_info();
                 app_info = *static_cast<TW_IDENTITY*>(API_INSTANCE DTWAIN_GetTwainAppID());
 
-                auto len = API_INSTANCE DTWAIN_GetDSMFullNameA(static_cast<int32_t>(m_twain_characteristics.get_dsm()), nullptr, 0,
-                    nullptr);
-                if (len > 0)
-                {
-                    std::vector<char> szBuffer(len);
-                    API_INSTANCE DTWAIN_GetDSMFullNameA(static_cast<int32_t>(m_twain_characteristics.get_dsm()), szBuffer.data(), len,
-                        nullptr);
-                    m_dsm_path = szBuffer.data();
-                }
-
                 API_INSTANCE DTWAIN_EnableMsgNotify(TRUE);
                 API_INSTANCE DTWAIN_EnableTripletsNotify(m_bTripletsNotify);
                 API_INSTANCE DTWAIN_SetCallback64(callback_proc, PtrToInt64(this));
@@ -215,6 +440,7 @@ namespace dynarithmic
             m_source_cache = std::move(rhs.m_source_cache);
             m_twain_characteristics = std::move(rhs.m_twain_characteristics);
             m_error_logger_func = std::move(rhs.m_error_logger_func);
+            m_loaded_language = std::move(rhs.m_loaded_language);
             API_INSTANCE DTWAIN_SetCallback64(callback_proc, PtrToInt64(this));
             API_INSTANCE DTWAIN_SetErrorCallback64(error_callback_proc, PtrToInt64(this));
             rhs.m_Handle = nullptr;
@@ -228,7 +454,10 @@ namespace dynarithmic
             };
             m_error_logger_func = fn;
             if (mode == startup_mode::autostart)
+            {
+                twain_statistics::scoped_timer startTimer(m_statistics, twain_statistics::stage::session_start);
                 start(true);
+            }
         }
 
         twain_session::~twain_session()
@@ -267,9 +496,29 @@ namespace dynarithmic
         {
             if (started())
                 return true;
+            twain_statistics::scoped_timer startTimer(m_statistics, twain_statistics::stage::session_start);
             return start(true); // a clean start
         }
 
+        /// Starts the OCR interface, if it has not been started already.
+        ///
+        /// The OCR interface is not started by start(), since most applications never use OCR.  Instead, it is started when
+        /// an OCR engine is first selected, or when is_ocr_available() is first called.
+        /// @returns **true** if the OCR interface is available, **false** otherwise.
+        bool twain_session::start_ocr()
+        {
+            if (!m_bOCRInitialized && m_Handle)
+            {
+                twain_statistics::scoped_timer ocrTimer(m_statistics, twain_statistics::stage::ocr_start);
+                m_bOCRInitialized = true;
+                if (API_INSTANCE DTWAIN_InitOCRInterface())
+                    m_bOCRStarted = true;
+                else
+                    m_error_logger.add_error(API_INSTANCE DTWAIN_GetLastError());
+            }
+            return m_bOCRStarted;
+        }
+
         /// Stops the TWAIN Data Source Manager (DSM).  
         /// 
         /// Once the DSM is stopped, a call to start() must be issued to restart the TWAIN DSM.  
@@ -300,6 +549,7 @@ namespace dynarithmic
 #endif  
             if (m_Handle)
             {
+                twain_statistics::scoped_timer stopTimer(m_statistics, twain_statistics::stage::session_stop);
                 while (API_INSTANCE DTWAIN_IsAcquiring())
                     std::this_thread::sleep_for(1ms);
                 API_INSTANCE DTWAIN_SetCallback64(nullptr, 0);
@@ -307,6 +557,9 @@ namespace dynarithmic
                 if (API_INSTANCE DTWAIN_SysDestroy())
                 {
                     m_Handle = nullptr;
+                    m_bOCRStarted = m_bOCRInitialized = false;
+                    m_loaded_language.clear();
+                    clear_session_info();
                     m_logger = { nullptr, nullptr };
                     m_source_cache.clear();
                     while (!m_selected_sources.empty())
@@ -416,32 +669,16 @@ namespace dynarithmic
         /// @see get_error_string()
         std::string twain_session::get_twain_name(twain_constant_category twain_category, int32_t twain_constant)
         {
-            static std::map<twain_constant_category, std::map<int32_t, std::string>> s_nameMap;
-            bool bSearch = false;
-            auto iter = s_nameMap.find(twain_category);
-            if (iter == s_nameMap.end())
-                bSearch = true;
-            else
-            {
-                auto iter2 = iter->second.find(twain_constant);
-                if (iter2 == iter->second.end())
-                    bSearch = true;
-                else
-                    return iter2->second;
-            }
-            if (bSearch)
+            if (const char* name = twain_constant_names::find(twain_category, twain_constant))
+                return name;
+
+            // Not in twain.h (for example, a constant added to a newer version of TWAIN), so ask the DTWAIN library
+            int32_t nChars = API_INSTANCE DTWAIN_GetTwainNameFromConstantA(static_cast<int32_t>(twain_category), twain_constant, nullptr, 0);
+            if (nChars > 0)
             {
-                int32_t nChars = API_INSTANCE DTWAIN_GetTwainNameFromConstantA(static_cast<int32_t>(twain_category), twain_constant, nullptr, 0);
-                if (nChars > 0)
-                {
-                    std::vector<char> vReturn(nChars + 1);
-                    API_INSTANCE DTWAIN_GetTwainNameFromConstantA(static_cast<int32_t>(twain_category), twain_constant, vReturn.data(), nChars);
-                    std::string sReturn(vReturn.data());
-                    auto iter = s_nameMap.insert({ twain_category, {} }).first;
-                    auto& iter2 = iter->second;
-                    iter2.insert({ twain_constant,sReturn });
-                    return sReturn;
-                }
+                std::vector<char> vReturn(nChars + 1);
+                API_INSTANCE DTWAIN_GetTwainNameFromConstantA(static_cast<int32_t>(twain_category), twain_constant, vReturn.data(), nChars);
+                return vReturn.data();
             }
             return {};
         }
@@ -483,19 +720,113 @@ namespace dynarithmic
             m_error_logger.add_error(msg);
         }
 
+        bool twain_session::load_language_resources(const std::string& language)
+        {
+            if (!API_INSTANCE DTWAIN_LoadCustomStringResourcesA(language.c_str()))
+                return false;
+            m_loaded_language = language;
+            return true;
+        }
+
         bool twain_session::set_language_resource(std::string language)
         {
             std::string sCurrentLanguage = m_twain_characteristics.get_language();
             m_twain_characteristics.set_language(language);
-            if (!API_INSTANCE DTWAIN_LoadCustomStringResourcesA(m_twain_characteristics.get_language().c_str()))
+            if (language == m_loaded_language)
+                return true;
+            if (!load_language_resources(language))
             {
                 m_twain_characteristics.set_language(sCurrentLanguage);
-                API_INSTANCE DTWAIN_LoadCustomStringResourcesA(m_twain_characteristics.get_language().c_str());
+                if (sCurrentLanguage != m_loaded_language)
+                    load_language_resources(sCurrentLanguage);
                 return false;
             }
             return true;
         }
 
+        void twain_session::clear_session_info()
+        {
+            m_short_name = optional_null_;
+            m_long_name = optional_null_;
+            m_dtwain_path = optional_null_;
+            m_version_copyright = optional_null_;
+            m_dsm_path = optional_null_;
+        }
+
+        // Calls the DTWAIN function the first time the value is needed.  Nothing is remembered if DTWAIN is not initialized,
+        // so that the value is retrieved once the session is started.
+        const std::string& twain_session::get_session_info(optional_type_<std::string>& value, bool bAvailable,
+                                                            const std::function<std::string()>& getFn) const
+        {
+            static const std::string emptyString;
+            if (!value)
+            {
+                if (!bAvailable)
+                    return emptyString;
+                value = getFn();
+            }
+            return *value;
+        }
+
+        std::string twain_session::get_short_version_name() const noexcept
+        {
+            return get_session_info(m_short_name, m_Handle != nullptr, []
+                {
+                    auto sz = API_INSTANCE DTWAIN_GetShortVersionStringA(nullptr, 0);
+                    std::vector<char> retBuf(sz + 1);
+                    API_INSTANCE DTWAIN_GetShortVersionStringA(retBuf.data(), static_cast<int32_t>(retBuf.size()));
+                    return std::string(retBuf.data());
+                });
+        }
+
+        std::string twain_session::get_long_version_name() const noexcept
+        {
+            return get_session_info(m_long_name, m_Handle != nullptr, []
+                {
+                    auto sz = API_INSTANCE DTWAIN_GetVersionStringA(nullptr, 0);
+                    std::vector<char> retBuf(sz + 1);
+                    API_INSTANCE DTWAIN_GetVersionStringA(retBuf.data(), static_cast<int32_t>(retBuf.size()));
+                    return std::string(retBuf.data());
+                });
+        }
+
+        std::string twain_session::get_version_copyright() const noexcept
+        {
+            return get_session_info(m_version_copyright, m_Handle != nullptr, []
+                {
+                    std::vector<char> retBuf(1024);
+                    API_INSTANCE DTWAIN_GetVersionCopyrightA(retBuf.data(), static_cast<int32_t>(retBuf.size()));
+                    return std::string(retBuf.data());
+                });
+        }
+
+        std::string twain_session::get_dtwain_path() const noexcept
+        {
+            return get_session_info(m_dtwain_path, m_Handle != nullptr, []
+                {
+                    std::vector<char> retBuf(1024);
+                    API_INSTANCE DTWAIN_GetLibraryPathA(retBuf.data(), static_cast<int32_t>(retBuf.size()));
+                    return std::string(retBuf.data());
+                });
+        }
+
+        std::string twain_session::get_dsm_path() const noexcept
+        {
+            const auto dsm = static_cast<int32_t>(m_twain_characteristics.get_dsm());
+            return get_session_info(m_dsm_path, m_bStarted, [dsm]
+                {
+                    std::string path;
+                    auto len = API_INSTANCE DTWAIN_GetDSMFullNameA(dsm, nullptr, 0, nullptr);
+                    if (len > 0)
+                    {
+                        std::vector<char> szBuffer(len);
+                        API_INSTANCE DTWAIN_GetDSMFullNameA(dsm, szBuffer.data(), len, nullptr);
+                        path = szBuffer.data();
+                    }
+                    return path;
+                });
+        }
+
         /// Sets the temporary directory that is used when acquiring images to a file
         /// @param[in] dir Temporary directory to use when acquiring to image files
         /// @returns The current twain_session object.
@@ -591,11 +922,13 @@ namespace dynarithmic
             return sAllDetails;
 #else
             std::sort(std::begin(container), std::end(container));
-            std::string sMapKey = std::accumulate(container.begin(), container.end(), std::string(),
-                [&](const std::string& total, const std::string& current)
-                {
-                    return total + "\x01" + current;
-                });
+            std::size_t keyLength = 0;
+            for (auto& name : container)
+                keyLength += name.size() + 1;
+            std::string sMapKey;
+            sMapKey.reserve(keyLength);
+            for (auto& name : container)
+                sMapKey.append(1, '\x01').append(name);
             auto iter = m_source_detail_map.find(sMapKey);
             if (!info.bRefresh && iter != m_source_detail_map.end())
                 return iter->second;
@@ -626,6 +959,23 @@ namespace dynarithmic
 #endif
         }
 
+        std::string twain_session::get_source_details(const std::string& productName, details_info info)
+        {
+            const std::string sName = trim_copy_string_(productName);
+            std::string sDetails;
+            LONG nChars = API_INSTANCE DTWAIN_GetSourceDetailsA(sName.c_str(), nullptr, 0, info.indentFactor, info.bRefresh ? TRUE : FALSE);
+            if (nChars > 0)
+            {
+                sDetails.resize(nChars);
+                API_INSTANCE DTWAIN_GetSourceDetailsA(sName.c_str(), &sDetails[0], nChars, info.indentFactor, FALSE);
+
+                // the returned length includes the null terminator
+                while (!sDetails.empty() && sDetails.back() == '\0')
+                    sDetails.pop_back();
+            }
+            return sDetails;
+        }
+
         struct HandleDestroyer
         {
             HANDLE h;
@@ -665,6 +1015,7 @@ namespace dynarithmic
         LRESULT CALLBACK twain_session::error_callback_proc(LONG error, LONG64 UserData)
         {
             const auto thisObject = reinterpret_cast<twain_session*>(UserData);
+            twain_metrics::instance().on_error(error);
             if (thisObject)
                 thisObject->log_error(error);
             return 1;
@@ -676,6 +1027,10 @@ namespace dynarithmic
             auto thisObject = reinterpret_cast<twain_session*>(UserData);
             if (thisObject)
             {
+                track_page_memory(static_cast<LONG>(wParam), lParam);
+                thisObject->m_statistics.on_notification(static_cast<LONG>(wParam));
+                twain_metrics::instance().on_notification(static_cast<LONG>(wParam));
+                trace_notification(static_cast<LONG>(wParam), lParam);
                 std::for_each(thisObject->get_callback_map().begin(),
                     thisObject->get_callback_map().end(),
                     [&](twain_session::callback_map_type::value_type& vt)
@@ -25,8 +25,10 @@ OF THIRD PARTY RIGHTS.
 #include <dynarithmic/twain/info/paperhandling_info.hpp>
 #include <dynarithmic/twain/types/twain_timer.hpp>
 #include <dynarithmic/twain/source/twain_source_pimpl.hpp>
+#include <dynarithmic/twain/session/twain_metrics.hpp>
 #include <chrono>
 #include <thread>
+#include <utility>
 
 namespace tb_namespace = dynarithmic::twain::tribool;
 namespace dynarithmic
@@ -87,6 +89,7 @@ namespace dynarithmic
                 m_sourceInfo = rhs.m_sourceInfo;
                 rhs.m_theSource = nullptr;
                 rhs.m_pSession = nullptr;
+                attach_cap_listener();
             }
             return *this;
         }
@@ -116,6 +119,8 @@ namespace dynarithmic
 			std::swap(left.m_bUIOnlySupported, right.m_bUIOnlySupported);
             std::swap(left.m_pTwainSourceImpl, right.m_pTwainSourceImpl);
             std::swap(left.m_extImageInfo, right.m_extImageInfo);
+            left.attach_cap_listener();
+            right.attach_cap_listener();
         }
 
         void twain_source::create_interfaces()
@@ -126,6 +131,51 @@ namespace dynarithmic
             m_pTwainSourceImpl->m_filetransfer_info = std::make_unique<file_transfer_info>();
             m_pTwainSourceImpl->m_capability_listener = std::make_unique<capability_listener>();
             m_pTwainSourceImpl->m_capability_info = std::make_unique<capability_interface>();
+            attach_cap_listener();
+        }
+
+        void twain_source::attach_cap_listener()
+        {
+            if (m_pTwainSourceImpl)
+            {
+                auto& ci = *m_pTwainSourceImpl->m_capability_info;
+                ci.set_listener(this, m_pTwainSourceImpl->m_capability_listener.get());
+                auto* store = m_pTwainSourceImpl->m_capability_failure_store;
+                ci.set_failure_store(store, store ? capability_failure_store::make_device_key(m_sourceInfo.get_identity()) : std::string());
+            }
+        }
+
+        twain_source& twain_source::set_cap_listener(std::unique_ptr<capability_listener> listener)
+        {
+            m_pTwainSourceImpl->m_capability_listener = listener ? std::move(listener) : std::make_unique<capability_listener>();
+            attach_cap_listener();
+            return *this;
+        }
+
+        capability_listener& twain_source::get_cap_listener()
+        {
+            return *m_pTwainSourceImpl->m_capability_listener;
+        }
+
+        twain_source& twain_source::set_cap_failure_store(capability_failure_store* store)
+        {
+            m_pTwainSourceImpl->m_capability_failure_store = store;
+            attach_cap_listener();
+            return *this;
+        }
+
+        twain_source& twain_source::set_device_profile(device_profile* profile)
+        {
+            m_pTwainSourceImpl->m_device_profile = profile;
+            return *this;
+        }
+
+        twain_source& twain_source::set_skip_unchanged_settings(bool bSkip)
+        {
+            m_pTwainSourceImpl->m_bSkipUnchangedSettings = bSkip;
+            if (!bSkip)
+                m_pTwainSourceImpl->m_capability_info->forget_applied_sets();
+            return *this;
         }
 
         void twain_source::get_source_info_internal()
@@ -153,7 +203,11 @@ namespace dynarithmic
             if (source)
             {
                 get_source_info_internal();
-                m_pTwainSourceImpl->m_capability_info->attach(source);
+                attach_cap_listener();
+                {
+                    twain_statistics::scoped_timer capTimer(m_pSession ? &m_pSession->get_statistics() : nullptr, twain_statistics::stage::fill_caps);
+                    m_pTwainSourceImpl->m_capability_info->attach(source);
+                }
                 m_pTwainSourceImpl->m_buffered_info->attach(*this);
                 m_bIsSelected = true;
                 m_source_details.clear();
@@ -198,6 +252,7 @@ namespace dynarithmic
         {
             if (m_theSource)
             {
+                twain_statistics::scoped_timer openTimer(m_pSession ? &m_pSession->get_statistics() : nullptr, twain_statistics::stage::source_open);
                 if (API_INSTANCE DTWAIN_OpenSource(m_theSource))
                 {
                     get_source_info_internal();
@@ -214,7 +269,10 @@ namespace dynarithmic
             if (m_theSource && m_pSession)
             {
                 if (API_INSTANCE DTWAIN_IsSourceValid( m_theSource ))
+                {
+                    twain_statistics::scoped_timer closeTimer(m_pSession->get_statistics(), twain_statistics::stage::source_close);
                     retVal = API_INSTANCE DTWAIN_CloseSource(m_theSource) ? true : false;
+                }
                 m_pSession->remove_source(this);
                 m_bIsSelected = false;
                 m_pSession->update_source_status(*this);
@@ -227,8 +285,30 @@ namespace dynarithmic
 
         void twain_source::start_apply()
         {
-            auto& ac = get_acquire_characteristics();
-            auto allAppliers = ac.get_appliers();
+            twain_statistics::scoped_timer applyTimer(m_pSession ? &m_pSession->get_statistics() : nullptr, twain_statistics::stage::start_apply);
+            const acquire_characteristics& ac = *(m_pTwainSourceImpl->m_acquire_characteristics);
+            const auto& allAppliers = ac.get_appliers();
+            auto& ci = *m_pTwainSourceImpl->m_capability_info;
+
+            // A profile recorded for this device is sent as is.  If any of its sets fail, the options are applied
+            // and the profile is recorded again.
+            auto* profile = m_pTwainSourceImpl->m_device_profile;
+
+            // On a source that has already acquired, the sets that did not change since the last acquisition are skipped.
+            // A profile holds all of the sets, so nothing is skipped when a profile is used.
+            ci.set_skip_unchanged_sets(m_pTwainSourceImpl->m_bSkipUnchangedSettings && !profile);
+            if (profile)
+            {
+                const std::string device = capability_failure_store::make_device_key(m_sourceInfo.get_identity());
+                if (profile->matches(device) && ci.replay_profile(*profile))
+                    return;
+                profile->set_device(device);
+                ci.begin_profile_recording(*profile);
+            }
+
+            // The option groups are applied in a fixed order, so collect the sets and send them in dependency order
+            // (for example, ICAP_UNITS before the resolution, and CAP_FEEDERENABLED before CAP_DUPLEXENABLED)
+            ci.begin_set_plan();
             if (allAppliers[acquire_characteristics::apply_languageoptions])
                 options_base::apply(*this, ac.get_language_options());
 
@@ -294,33 +374,70 @@ namespace dynarithmic
 
             if (allAppliers[acquire_characteristics::apply_imprinter])
                 options_base::apply(*this, ac.get_imprinter_options());
+            ci.end_set_plan();
+            if (profile)
+                ci.end_profile_recording();
         }
             
         void twain_source::prepare_acquisition()
         {
-            acquire_characteristics& ac = *(m_pTwainSourceImpl->m_acquire_characteristics);
+            const acquire_characteristics& ac = *(m_pTwainSourceImpl->m_acquire_characteristics);
+            auto& ci = *m_pTwainSourceImpl->m_capability_info;
             start_apply();
 
             // set the acquisition area
             auto twframe = ac.get_pages_options().get_frame();
 
-            // if user has overridden the default...
-            if (twframe != twain_frame<>())
+            // The area and job control are capability sets made by DTWAIN, so they are skipped in the same way as the
+            // sets made in start_apply().  Their keys are the keys of the same sets made with set_cap_values(), so that
+            // either set is skipped after the other.
+            const bool bSkipUnchanged = ci.is_skip_unchanged_sets();
+            std::string areaKey;
+            if (bSkipUnchanged)
             {
-                DTWAIN_ARRAY area = API_INSTANCE DTWAIN_ArrayCreate(DTWAIN_ARRAYFLOAT, 4);
-                twain_array arr(area);
-                double* buffer = arr.get_buffer<double>();
-                buffer[0] = twframe.left;
-                buffer[1] = twframe.top;
-                buffer[2] = twframe.right;
-                buffer[3] = twframe.bottom;
-                API_INSTANCE DTWAIN_SetAcquireArea(m_theSource, DTWAIN_AREASET, area, NULL);
+                std::vector<ICAP_FRAMES_::value_type> vFrames;
+                if (twframe != twain_frame<>())
+                    vFrames.push_back(twframe);
+                areaKey = capability_interface::get_set_value_key(vFrames);
+            }
+            if (!bSkipUnchanged || !ci.is_set_applied(ICAP_FRAMES, areaKey))
+            {
+                // if user has overridden the default...
+                BOOL bAreaSet = FALSE;
+                if (twframe != twain_frame<>())
+                {
+                    DTWAIN_ARRAY area = API_INSTANCE DTWAIN_ArrayCreate(DTWAIN_ARRAYFLOAT, 4);
+                    twain_array arr(area);
+                    double* buffer = arr.get_buffer<double>();
+                    buffer[0] = twframe.left;
+                    buffer[1] = twframe.top;
+                    buffer[2] = twframe.right;
+                    buffer[3] = twframe.bottom;
+                    bAreaSet = API_INSTANCE DTWAIN_SetAcquireArea(m_theSource, DTWAIN_AREASET, area, NULL);
+                }
+                else
+                    bAreaSet = API_INSTANCE DTWAIN_SetAcquireArea(m_theSource, DTWAIN_AREARESET, NULL, NULL);
+                if (bAreaSet)
+                    ci.set_applied(ICAP_FRAMES, areaKey);
+                else
+                    ci.forget_applied_set(ICAP_FRAMES);
             }
-            else
-                API_INSTANCE DTWAIN_SetAcquireArea(m_theSource, DTWAIN_AREARESET, NULL, NULL);
 
             // Set the job control option
-            API_INSTANCE DTWAIN_SetJobControl(m_theSource, static_cast<LONG>(ac.get_jobcontrol_options().get_option()), TRUE);
+            const auto jobControl = static_cast<LONG>(ac.get_jobcontrol_options().get_option());
+            std::string jobControlKey;
+            if (bSkipUnchanged)
+            {
+                const std::vector<CAP_JOBCONTROL_::value_type> vJobControl = { static_cast<CAP_JOBCONTROL_::value_type>(jobControl) };
+                jobControlKey = capability_interface::get_set_value_key(vJobControl);
+            }
+            if (!bSkipUnchanged || !ci.is_set_applied(CAP_JOBCONTROL, jobControlKey))
+            {
+                if (API_INSTANCE DTWAIN_SetJobControl(m_theSource, jobControl, TRUE))
+                    ci.set_applied(CAP_JOBCONTROL, jobControlKey);
+                else
+                    ci.forget_applied_set(CAP_JOBCONTROL);
+            }
 
             // Disable the manual duplex mode
             API_INSTANCE DTWAIN_SetManualDuplexMode(m_theSource, 0, FALSE);
@@ -359,11 +476,11 @@ namespace dynarithmic
                 (multisave_info.is_save_incomplete() ? static_cast<LONG>(multipage_save_mode::save_incomplete) : 0));
 
             // Get the general options
-            general_options& gOpts = ac.get_general_options();
+            const general_options& gOpts = ac.get_general_options();
             API_INSTANCE DTWAIN_SetMaxAcquisitions(m_theSource, gOpts.get_max_acquisitions());
 
             // Set the JPEG quality in case we acquire to JPEG files
-            imagetype_options& iOpts = ac.get_imagetype_options();
+            const imagetype_options& iOpts = ac.get_imagetype_options();
             API_INSTANCE DTWAIN_SetJpegValues(m_theSource, iOpts.get_jpegquality(), false);
             API_INSTANCE DTWAIN_SetJpegXRValues(m_theSource, iOpts.get_jpegquality(), false);
 
@@ -374,12 +491,30 @@ namespace dynarithmic
             set_pdf_options();
         }
 
+        void twain_source::forget_acquisition_sets()
+        {
+            auto& ci = *m_pTwainSourceImpl->m_capability_info;
+
+            // The user may have changed any of the settings in the device's user interface
+            if (std::as_const(*m_pTwainSourceImpl->m_acquire_characteristics).get_userinterface_options().is_shown())
+            {
+                ci.forget_applied_sets();
+                return;
+            }
+
+            // The capabilities that DTWAIN sets when acquiring (and the capabilities that depend on them) are sent again
+            static constexpr int acquisition_caps[] = { CAP_DUPLEXENABLED, CAP_FEEDERENABLED, CAP_INDICATORS, CAP_XFERCOUNT,
+                                                        ICAP_COMPRESSION, ICAP_IMAGEFILEFORMAT, ICAP_PIXELTYPE, ICAP_XFERMECH };
+            for (auto cap : acquisition_caps)
+                ci.forget_applied_set(cap);
+        }
+
         void twain_source::set_pdf_options()
         {
             auto source = get_source();
 
             // set the PDF file properties
-            pdf_options& po = m_pTwainSourceImpl->m_acquire_characteristics->get_pdf_options();
+            const pdf_options& po = std::as_const(*m_pTwainSourceImpl->m_acquire_characteristics).get_pdf_options();
             API_INSTANCE DTWAIN_SetPDFCreatorA(source, po.get_creator().c_str());
             API_INSTANCE DTWAIN_SetPDFTitleA(source, po.get_title().c_str());
             API_INSTANCE DTWAIN_SetPDFProducerA(source, po.get_creator().c_str());
@@ -455,20 +590,50 @@ namespace dynarithmic
                 API_INSTANCE DTWAIN_SetLastError(DTWAIN_ERR_BAD_SOURCE);
                 return { DTWAIN_ERR_BAD_SOURCE, {} };
             }
+            // gather the timings for this acquisition
+            using stat_clock = std::chrono::steady_clock;
+            struct acquire_stats_guard
+            {
+                twain_statistics& m_stats;
+                acquire_stats_guard(twain_statistics& stats) : m_stats(stats) { m_stats.acquire_begin(); }
+                ~acquire_stats_guard() { m_stats.acquire_end(); }
+            };
+            auto& stats = m_pSession->get_statistics();
+            acquire_stats_guard statsGuard(stats);
+
+            // however the acquisition ends, the settings that it may have changed are sent again next time
+            struct acquisition_sets_guard
+            {
+                twain_source& m_source;
+                acquisition_sets_guard(twain_source& source) : m_source(source) {}
+                ~acquisition_sets_guard() { m_source.forget_acquisition_sets(); }
+            };
+            acquisition_sets_guard setsGuard(*this);
+            auto stageStart = stat_clock::now();
+
             bool fstatus = true;
             prepare_acquisition();
-            if (!m_pTwainSourceImpl->m_acquire_characteristics->get_paperhandling_options().is_feeder_enabled())
+            const auto prepareTime = stat_clock::now() - stageStart;
+            stats.record(twain_statistics::stage::acquire_prepare, prepareTime);
+            auto feederTime = stat_clock::duration::zero();
+
+            const acquire_characteristics& ac = *(m_pTwainSourceImpl->m_acquire_characteristics);
+            if (!ac.get_paperhandling_options().is_feeder_enabled())
                 API_INSTANCE DTWAIN_EnableFeeder(m_theSource, FALSE);
             else
             {
-                auto& feedOptions = m_pTwainSourceImpl->m_acquire_characteristics->get_paperhandling_options();
+                auto& feedOptions = ac.get_paperhandling_options();
                 auto fmode = feedOptions.get_feedermode();
                 bool use_feeder_or_flatbed = (fmode == feedermode_value::feeder_flatbed);
                 bool use_wait = (feedOptions.get_feederwait() != 0);
                 if (use_wait || use_feeder_or_flatbed)
                 {
                     fstatus = false;
+                    stageStart = stat_clock::now();
                     wait_for_feeder(fstatus);
+                    feederTime = stat_clock::now() - stageStart;
+                    stats.record(twain_statistics::stage::feeder_wait, feederTime);
+                    twain_metrics::instance().on_feeder_wait(feederTime);
 
                     // timed out waiting for the feeder to be loaded, or device doesn't support feeder
                     if (!fstatus && !use_feeder_or_flatbed)
@@ -485,9 +650,11 @@ namespace dynarithmic
 
             if (fstatus)
             {
+                stats.acquire_transfer_begin(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(prepareTime).count()),
+                                             static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(feederTime).count()));
                 if (twain_session::callback_proc(twain_callback_values::DTWAIN_PREACQUIRE_START, 0, reinterpret_cast<UINT_PTR>(m_pSession)))
                 {
-                    const auto transtype = m_pTwainSourceImpl->m_acquire_characteristics->get_general_options().get_transfer_type();
+                    const auto transtype = ac.get_general_options().get_transfer_type();
                     if (transtype == transfer_type::file_using_native ||
                         transtype == transfer_type::file_using_buffered ||
                         transtype == transfer_type::file_using_source)
@@ -503,8 +670,8 @@ namespace dynarithmic
 
         twain_source::acquire_return_type twain_source::acquire_to_file(transfer_type transtype)
         {
-            acquire_characteristics& ac = *(m_pTwainSourceImpl->m_acquire_characteristics);
-            file_transfer_options& ftOptions = ac.get_file_transfer_options();
+            const acquire_characteristics& ac = *(m_pTwainSourceImpl->m_acquire_characteristics);
+            const file_transfer_options& ftOptions = ac.get_file_transfer_options();
 
             LONG dtwain_transfer_type = DTWAIN_USENATIVE;
             if (transtype == transfer_type::file_using_buffered)
@@ -535,7 +702,7 @@ namespace dynarithmic
                 dtwain_transfer_type |= DTWAIN_CREATE_DIRECTORY;
 
             // check for auto increment
-            filename_increment_options& inc = ftOptions.get_filename_increment_options();
+            const filename_increment_options& inc = ftOptions.get_filename_increment_options();
             file_transfer_info fTransfer = get_file_transfer_info();
             API_INSTANCE DTWAIN_SetFileAutoIncrement(m_theSource, inc.get_increment(), inc.is_reset_count_used() ? TRUE : FALSE,
                 inc.is_enabled() ? TRUE : FALSE);
@@ -562,7 +729,7 @@ namespace dynarithmic
                         API_INSTANCE DTWAIN_EnableFeeder(m_theSource, TRUE);
                 }
             }
-            general_options& gOpts = ac.get_general_options();
+            const general_options& gOpts = ac.get_general_options();
             bool isModeless = m_pSession->is_custom_twain_loop();
             API_INSTANCE DTWAIN_SetTwainMode(isModeless ? DTWAIN_MODELESS : DTWAIN_MODAL);
             LONG status;
@@ -596,8 +763,8 @@ namespace dynarithmic
 
         twain_source::acquire_return_type twain_source::acquire_to_image_handles(transfer_type transtype)
         {
-            acquire_characteristics& ac = *(m_pTwainSourceImpl->m_acquire_characteristics);
-            general_options& gOpts = ac.get_general_options();
+            const acquire_characteristics& ac = *(m_pTwainSourceImpl->m_acquire_characteristics);
+            const general_options& gOpts = ac.get_general_options();
             color_value::value_type ct = m_pTwainSourceImpl->m_capability_info->get_cap_values(ICAP_PIXELTYPE, capability_interface::get_current()).front();
 
             bool isModeless = m_pSession->is_custom_twain_loop();
@@ -671,7 +838,7 @@ namespace dynarithmic
                 return;
             }
 
-            auto timeoutval = get_acquire_characteristics().get_paperhandling_options().get_feederwait();
+            auto timeoutval = std::as_const(*m_pTwainSourceImpl->m_acquire_characteristics).get_paperhandling_options().get_feederwait();
 
             twain_timer theTimer;
 
@@ -1199,7 +1199,65 @@ int LoadFunction(Fn& apifn, HMODULE hModule, const char *fnName)
     DTWAINAPI_ASSERT(apifn = reinterpret_cast<Fn>(::GetProcAddress(hModule, fnName)));
     return 1;
 }
+#ifdef DTWAIN_API_PROFILE
+/* Profiling thunks.  Each DYNDTWAIN_API function pointer gets its own thunk (the template is keyed on the
+   address of the function pointer), which times the call, lets the call watchdog know the call is in flight,
+   and then calls the real DTWAIN function. */
+#include <type_traits>
+#include <dynarithmic/twain/utilities/api_profiler.hpp>
+#include <dynarithmic/twain/utilities/call_watchdog.hpp>
+
+template <auto* Slot, typename Fn = std::remove_pointer_t<decltype(Slot)>>
+struct ProfileThunk;
+
+template <auto* Slot, typename R, typename... Args>
+struct ProfileThunk<Slot, R (DLLENTRY_DEF *)(Args...)>
+{
+    typedef R (DLLENTRY_DEF * fn_type)(Args...);
+    static fn_type s_original;
+    static dynarithmic::twain::api_profiler::entry s_entry;
+    static dynarithmic::twain::call_watchdog::watched_function s_watched;
+
+    static R DLLENTRY_DEF Call(Args... args)
+    {
+        dynarithmic::twain::api_profiler::scope timer(s_entry);
+        dynarithmic::twain::call_watchdog::scope watch(s_watched);
+        return s_original(args...);
+    }
+};
+
+template <auto* Slot, typename R, typename... Args>
+typename ProfileThunk<Slot, R (DLLENTRY_DEF *)(Args...)>::fn_type ProfileThunk<Slot, R (DLLENTRY_DEF *)(Args...)>::s_original = nullptr;
+
+template <auto* Slot, typename R, typename... Args>
+dynarithmic::twain::api_profiler::entry ProfileThunk<Slot, R (DLLENTRY_DEF *)(Args...)>::s_entry;
+
+template <auto* Slot, typename R, typename... Args>
+dynarithmic::twain::call_watchdog::watched_function ProfileThunk<Slot, R (DLLENTRY_DEF *)(Args...)>::s_watched;
+
+template <auto* Slot>
+int LoadProfiledFunction(HMODULE hModule, const char *fnName)
+{
+    if (!LoadFunction(*Slot, hModule, fnName))
+        return 0;
+    auto& profiler = dynarithmic::twain::api_profiler::instance();
+    auto& watchdog = dynarithmic::twain::call_watchdog::instance();
+    if (*Slot && (profiler.is_enabled() || watchdog.is_enabled()))
+    {
+        typedef ProfileThunk<Slot> thunk_type;
+        thunk_type::s_original = *Slot;
+        thunk_type::s_entry.name = fnName;
+        thunk_type::s_watched.name = fnName;
+        profiler.register_entry(&thunk_type::s_entry);
+        watchdog.register_function(&thunk_type::s_watched);
+        *Slot = &thunk_type::Call;
+    }
+    return 1;
+}
+#define LOADFUNCTIONIMPL(fn, module) do { if (!LoadProfiledFunction<&DTWAIN_INSTANCE fn>(module, #fn)) return 0;} while(false);
+#else
 #define LOADFUNCTIONIMPL(fn, module) do { if (!LoadFunction(fn, module, #fn)) return 0;} while(false);
+#endif
 #else
 #define LOADFUNCTIONIMPL(fn, module) do { \
         DTWAINAPI_ASSERT(DTWAIN_INSTANCE fn = GetProcAddress(module, #fn)); } while(0);
@@ -2,8 +2,18 @@
 #include <dynarithmic/twain/twain_source.hpp>
 #include <dynarithmic/twain/types/twain_callback.hpp>
 #include <dynarithmic/twain/info/paperhandling_info.hpp>
+#include <dynarithmic/twain/capability_interface/capability_failure_store.hpp>
+#include <dynarithmic/twain/session/source_details_cache.hpp>
+#include <dynarithmic/twain/session/source_list_cache.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <functional>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include <boost/algorithm/string/join.hpp>
 using namespace dynarithmic::twain;
@@ -13,10 +23,188 @@ std::string generate_details()
     twain_session ts(startup_mode::autostart);
     return ts.get_details(details_info());
 }
-std::string generate_productnames()
+std::string generate_source_details(const std::string& productName)
 {
-	twain_session ts(startup_mode::autostart);
-    auto sourceInfo = ts.get_all_source_info();
+    twain_session ts(startup_mode::autostart);
+    return ts.get_source_details(productName, details_info());
+}
+
+static std::string to_json_string(const std::string& s)
+{
+    std::string ret = "\"";
+    for (char ch : s)
+    {
+        if (ch == '"' || ch == '\\')
+            ret += '\\';
+        if (static_cast<unsigned char>(ch) >= 0x20)
+            ret += ch;
+    }
+    return ret + "\"";
+}
+
+// Runs "twainsave --detailssource <productName>" and collects the details it writes.  Each device gets its own process,
+// since TWAIN allows one session per process, and a driver that hangs can only be stopped by ending its process.
+// Returns false if the process fails, or does not finish within timeoutMs milliseconds (0 = no limit).
+static bool run_details_process(const std::string& exePath, const std::string& productName, DWORD timeoutMs,
+                                std::string& details, bool& bTimedOut)
+{
+    bTimedOut = false;
+    SECURITY_ATTRIBUTES sa = { sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE };
+    HANDLE hRead = nullptr;
+    HANDLE hWrite = nullptr;
+    if (!CreatePipe(&hRead, &hWrite, &sa, 0))
+        return false;
+    SetHandleInformation(hRead, HANDLE_FLAG_INHERIT, 0);
+
+    std::string sName = productName;
+    std::string::size_type pos = 0;
+    while ((pos = sName.find('"', pos)) != std::string::npos)
+    {
+        sName.insert(pos, 1, '\\');
+        pos += 2;
+    }
+    std::string cmdLine = "\"" + exePath + "\" --detailssource \"" + sName + "\"";
+
+    STARTUPINFOA si = {};
+    si.cb = sizeof si;
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdOutput = hWrite;
+    PROCESS_INFORMATION pi = {};
+    const BOOL bCreated = CreateProcessA(nullptr, &cmdLine[0], nullptr, nullptr, TRUE, CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi);
+    CloseHandle(hWrite);
+    if (!bCreated)
+    {
+        CloseHandle(hRead);
+        return false;
+    }
+
+    // The pipe is read while waiting, so that the process does not block when the pipe is full
+    const auto startTime = std::chrono::steady_clock::now();
+    char buffer[4096];
+    bool bExited = false;
+    while (true)
+    {
+        DWORD nAvailable = 0;
+        while (PeekNamedPipe(hRead, nullptr, 0, nullptr, &nAvailable, nullptr) && nAvailable > 0)
+        {
+            DWORD nRead = 0;
+            if (!ReadFile(hRead, buffer, (std::min)(nAvailable, static_cast<DWORD>(sizeof buffer)), &nRead, nullptr) || nRead == 0)
+                break;
+            details.append(buffer, nRead);
+        }
+        if (bExited)
+            break;
+        bExited = WaitForSingleObject(pi.hProcess, 50) == WAIT_OBJECT_0;
+        if (!bExited && timeoutMs > 0 &&
+            std::chrono::steady_clock::now() - startTime > std::chrono::milliseconds(timeoutMs))
+        {
+            TerminateProcess(pi.hProcess, 1);
+            WaitForSingleObject(pi.hProcess, 5000);
+            bTimedOut = true;
+            break;
+        }
+    }
+    DWORD exitCode = 1;
+    GetExitCodeProcess(pi.hProcess, &exitCode);
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+    CloseHandle(hRead);
+    return !bTimedOut && exitCode == 0 && !details.empty();
+}
+
+// Writes the details of each device as a JSON array, through **writer**.  The details of each device are written as
+// soon as they are available:  devices in the cache first, then the devices queried by up to **jobs** processes at a
+// time, in the order they finish.  A device that does not finish within **timeoutSeconds** (0 = no limit) is written
+// with "error": "timeout".
+void generate_details_per_source(int jobs, int timeoutSeconds, const std::string& cacheFile, bool bRefresh,
+                                 const std::function<void(const std::string&)>& writer)
+{
+    std::vector<twain_identity> vSources;
+    {
+        twain_session ts(startup_mode::autostart);
+        vSources = ts.get_all_source_info();
+    }
+
+    source_details_cache cache;
+    cache.set_file(cacheFile);
+    cache.load();
+
+    std::mutex writeMutex;
+    bool bFirst = true;
+    const auto writeDetails = [&](std::string details)
+    {
+        while (!details.empty() && std::isspace(static_cast<unsigned char>(details.back())))
+            details.pop_back();
+        std::lock_guard<std::mutex> lock(writeMutex);
+        writer((bFirst ? "[\n" : ",\n") + details);
+        bFirst = false;
+    };
+
+    struct pending_source
+    {
+        std::string product_name;
+        std::string device;
+    };
+    std::vector<pending_source> vPending;
+    for (auto& source : vSources)
+    {
+        std::string device = capability_failure_store::make_device_key(source.get_identity());
+        std::string details;
+        if (!bRefresh && cache.find(device, details))
+            writeDetails(std::move(details));
+        else
+            vPending.push_back({ source.get_product_name(), std::move(device) });
+    }
+
+    char exePath[MAX_PATH] = {};
+    GetModuleFileNameA(nullptr, exePath, MAX_PATH);
+    const DWORD timeoutMs = timeoutSeconds > 0 ? static_cast<DWORD>(timeoutSeconds) * 1000 : 0;
+    std::atomic<std::size_t> nextSource{ 0 };
+    const auto worker = [&]
+    {
+        std::size_t i;
+        while ((i = nextSource.fetch_add(1)) < vPending.size())
+        {
+            std::string details;
+            bool bTimedOut = false;
+            if (run_details_process(exePath, vPending[i].product_name, timeoutMs, details, bTimedOut))
+            {
+                cache.add(vPending[i].device, details);
+                writeDetails(std::move(details));
+            }
+            else
+                writeDetails("{\"product-name\": " + to_json_string(vPending[i].product_name) +
+                             ", \"error\": \"" + (bTimedOut ? "timeout" : "failed") + "\"}");
+        }
+    };
+
+    const std::size_t nThreads = (std::min)(static_cast<std::size_t>((std::max)(jobs, 1)), vPending.size());
+    std::vector<std::thread> vThreads;
+    for (std::size_t i = 0; i < nThreads; ++i)
+        vThreads.emplace_back(worker);
+    for (auto& t : vThreads)
+        t.join();
+    cache.save();
+    writer(bFirst ? "[\n]\n" : "\n]\n");
+}
+
+// The device list is saved in **cacheFile**, and used until a TWAIN driver is added, removed or updated, since listing
+// the devices loads every TWAIN driver
+std::string generate_productnames(const std::string& cacheFile, bool bRefresh)
+{
+    source_list_cache cache;
+    cache.set_file(cacheFile);
+    std::vector<twain_identity> sourceInfo;
+    if (!bRefresh && cache.load() && cache.is_current())
+        sourceInfo = cache.get_sources();
+    else
+    {
+        std::string fingerprint = source_list_cache::get_directory_fingerprint();
+        twain_session ts(startup_mode::autostart);
+        sourceInfo = ts.get_all_source_info();
+        if (ts && !fingerprint.empty())
+            cache.set_sources(sourceInfo, std::move(fingerprint)).save();
+    }
     std::vector<std::string> vProductNames;
     auto iter = sourceInfo.begin();
     while (iter != sourceInfo.end())
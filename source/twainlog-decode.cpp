@@ -0,0 +1,91 @@
+/*
+This file is part of the Twainsave-opensource version
+Copyright (c) 2002-2026 Dynarithmic Software.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+FOR ANY PART OF THE COVERED WORK IN WHICH THE COPYRIGHT IS OWNED BY
+DYNARITHMIC SOFTWARE. DYNARITHMIC SOFTWARE DISCLAIMS THE WARRANTY OF NON INFRINGEMENT
+OF THIRD PARTY RIGHTS.
+*/
+// twainlog-decode.cpp : Converts a binary diagnostic log (twainsave --diagnosebinary) to text or JSON.
+//
+#include <dynarithmic/twain/logging/binary_log_format.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace dynarithmic::twain;
+
+static int usage()
+{
+    std::cerr << "Usage: twainlog-decode [--json] <binary log file> [output file]\n";
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    auto fmt = binary_log::decoder::output_format::text;
+    std::string inName, outName;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--json")
+            fmt = binary_log::decoder::output_format::json;
+        else
+        if (arg == "--text")
+            fmt = binary_log::decoder::output_format::text;
+        else
+        if (inName.empty())
+            inName = arg;
+        else
+        if (outName.empty())
+            outName = arg;
+        else
+            return usage();
+    }
+    if (inName.empty())
+        return usage();
+
+    std::ifstream inFile(inName, std::ios::binary);
+    if (!inFile)
+    {
+        std::cerr << "Could not open " << inName << "\n";
+        return 2;
+    }
+
+    std::ofstream outFile;
+    if (!outName.empty())
+    {
+        outFile.open(outName);
+        if (!outFile)
+        {
+            std::cerr << "Could not create " << outName << "\n";
+            return 2;
+        }
+    }
+    std::ostream& out = outName.empty() ? std::cout : outFile;
+
+    binary_log::decoder decoder;
+    if (!decoder.decode(inFile, out, fmt))
+    {
+        if (decoder.get_event_count() == 0 && decoder.get_template_count() == 0)
+        {
+            std::cerr << inName << " is not a binary diagnostic log\n";
+            return 3;
+        }
+        std::cerr << inName << " is truncated.  " << decoder.get_event_count() << " message(s) decoded\n";
+        return 4;
+    }
+    return 0;
+}
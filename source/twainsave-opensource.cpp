@@ -30,30 +30,48 @@ OF THIRD PARTY RIGHTS.
 #include <boost/uuid/uuid_io.hpp>         
 #include <boost/dll/runtime_symbol_info.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string.hpp>
 #include <dynarithmic/twain/twain_session.hpp>
 #include <dynarithmic/twain/twain_source.hpp>
+#include <dynarithmic/twain/capability_interface/capability_failure_store.hpp>
+#include <dynarithmic/twain/capability_interface/capability_statistics_listener.hpp>
+#include <dynarithmic/twain/capability_interface/device_profile.hpp>
 #include <dynarithmic/twain/options/pdf_options.hpp>
+#include <dynarithmic/twain/session/source_list_cache.hpp>
 #include <dynarithmic/twain/acquire_characteristics/acquire_characteristics.hpp>
+#include <dynarithmic/twain/logging/async_logger.hpp>
+#include <dynarithmic/twain/logging/binary_logger.hpp>
+#include <dynarithmic/twain/logging/trace_recorder.hpp>
+#include <dynarithmic/twain/utilities/api_profiler.hpp>
+#include <dynarithmic/twain/utilities/call_watchdog.hpp>
+#include <dynarithmic/twain/utilities/metrics_registry.hpp>
 #include <dynarithmic/twain/types/eternal_map/include/mapbox/eternal.hpp>
 #include <string>
 #include <iostream>
 #include <utility>
 #include <iomanip>
 #include <numeric>
+#include <set>
 #include <memory>
 #include <sstream>
 #include <type_traits>
 #include <unordered_map>
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <thread>
 #include <iostream>
 #include "..\simpleini\SimpleIni.h"
 #include "twainsave_verinfo.h"
 #include "twainsave.h"
 
 std::string generate_details();
-std::string generate_productnames();
-std::vector<std::string> vReturnStrings;
+std::string generate_source_details(const std::string& productName);
+void generate_details_per_source(int jobs, int timeoutSeconds, const std::string& cacheFile, bool bRefresh,
+                                 const std::function<void(const std::string&)>& writer);
+std::string generate_productnames(const std::string& cacheFile, bool bRefresh);
 
 template <typename E>
 constexpr auto to_underlying(E e) noexcept
@@ -92,12 +110,81 @@ constexpr auto to_underlying(E e) noexcept
 #define RETURN_INVALID_COLOR            20
 #define RETURN_INVALID_ORIENTATION      21
 #define RETURN_INVALID_JOBCONTROL       22
-#define RETURN_CODE_LAST (RETURN_INVALID_JOBCONTROL + 1)
+#define RETURN_WATCHDOG_TIMEOUT         23
+#define RETURN_CODE_LAST (RETURN_WATCHDOG_TIMEOUT + 1)
 
 #define TWAINSAVE_DEFAULT_TITLE "TwainSave - OpenSource"
 #define TWAINSAVE_INI_FILE "twainsave.ini"
-
+#define TWAINSAVE_CAPFAILURES_FILE "twainsave_capfailures.txt"
+#define TWAINSAVE_DETAILS_FILE "twainsave_details.txt"
+#define TWAINSAVE_SOURCELIST_FILE "twainsave_sources.txt"
+
+// declared before g_source, so that they outlive the source that uses them
+dynarithmic::twain::capability_failure_store g_capFailureStore;
+dynarithmic::twain::device_profile g_deviceProfile;
+bool g_bDeviceProfileReplay = false;
 std::unique_ptr<dynarithmic::twain::twain_source> g_source;
+dynarithmic::twain::async_logger* g_pLogger = nullptr;
+
+// Loads the DTWAIN library on a separate thread while main() reads the INI file and the command line, so that the library
+// is already in memory when twain_session::start() loads it.  Only the library is loaded here.  The DTWAIN function table
+// is still set up by twain_session::start(), after the profiler and watchdog are turned on.
+class dtwain_preloader
+{
+    std::thread m_thread;
+    HMODULE m_hModule = nullptr;
+    std::chrono::steady_clock::duration m_load_time{};
+    std::chrono::steady_clock::duration m_wait_time{};
+
+    public:
+        dtwain_preloader() = default;
+        dtwain_preloader(const dtwain_preloader&) = delete;
+        dtwain_preloader& operator=(const dtwain_preloader&) = delete;
+        ~dtwain_preloader() { release(); }
+
+        void start()
+        {
+            m_thread = std::thread([this]
+                {
+                    const auto startTime = std::chrono::steady_clock::now();
+                    m_hModule = ::LoadLibraryA(DTWAIN_DLLNAME);
+                    m_load_time = std::chrono::steady_clock::now() - startTime;
+                });
+        }
+
+        // Waits until the library is loaded
+        void wait()
+        {
+            if (!m_thread.joinable())
+                return;
+            const auto startTime = std::chrono::steady_clock::now();
+            m_thread.join();
+            m_wait_time += std::chrono::steady_clock::now() - startTime;
+        }
+
+        // Must not be called until the TWAIN session is stopped
+        void release()
+        {
+            wait();
+            if (m_hModule)
+                ::FreeLibrary(m_hModule);
+            m_hModule = nullptr;
+        }
+
+        std::chrono::steady_clock::duration get_load_time() const { return m_load_time; }
+        std::chrono::steady_clock::duration get_wait_time() const { return m_wait_time; }
+};
+
+// Time taken by each part of the startup, reported by --stats
+struct startup_timings
+{
+    std::chrono::steady_clock::duration ini_load{};
+    std::chrono::steady_clock::duration option_parse{};
+    std::chrono::steady_clock::duration total{};
+};
+
+dtwain_preloader g_dtwainPreloader;
+startup_timings g_startupTimings;
 
 
 MAPBOX_ETERNAL_CONSTEXPR const auto g_FileTypeMap = mapbox::eternal::map<stringview, dynarithmic::twain::filetype_value::value_type>(
@@ -281,6 +368,11 @@ struct scanner_options
     bool m_bUseDuplex;
     bool m_bDeskew;
     bool m_bShowDetails;
+    std::string m_strDetailsCache;
+    int m_nDetailsJobs;
+    bool m_bDetailsRefresh;
+    std::string m_strDetailsSource;
+    int m_nDetailsTimeout;
     bool m_bShowHelp;
     bool m_bAutoRotateMode;
     std::string m_strHalftone;
@@ -294,6 +386,15 @@ struct scanner_options
     double m_dShadow;
     bool m_bNoBlankPages;
     bool m_bNoConsole;
+    bool m_bShowStats;
+    bool m_bAPIProfile;
+    std::string m_strCapFailureFile;
+    bool m_bRelearn;
+    std::string m_strDeviceProfile;
+    std::string m_strTraceFile;
+    std::string m_strMetricsFile;
+    int m_nMetricsPort;
+    int m_nMetricsInterval;
     bool m_bNoPause;
     double m_dResolution;
     double m_dBlankThreshold;
@@ -302,6 +403,8 @@ struct scanner_options
     bool m_bSelectDefault;
     bool m_bUIPerm;
     std::string m_strSelectName;
+    std::string m_strSourceListCache;
+    bool m_bSourceListRefresh;
     std::string m_strImprinter;
     int m_nOverwriteMode;
     int m_nOverwriteMax;
@@ -326,6 +429,9 @@ struct scanner_options
     int m_nTransferMode;
     int m_nDiagnose;
     std::string m_DiagnoseLog;
+    std::string m_strWatchdog;
+    int m_nWatchdogLines;
+    bool m_bDiagnoseBinary;
     std::string m_scaling;
     bool m_bUseTransparencyUnit;
     std::string m_strUnitOfMeasure;
@@ -454,6 +560,68 @@ std::string GetTwainSaveExecutionPath()
 	return symlocation.parent_path().string();
 }
 
+std::string GetCapFailureFileName()
+{
+    if (!s_options.m_strCapFailureFile.empty())
+        return s_options.m_strCapFailureFile;
+
+    // The program directory may not be writable, so use the user's local application data directory if there is one
+    const char* appData = std::getenv("LOCALAPPDATA");
+    filesys::path dir = appData && *appData ? filesys::path(appData) : filesys::path(GetTwainSaveExecutionPath());
+    return (dir / TWAINSAVE_CAPFAILURES_FILE).string();
+}
+
+std::string GetDetailsCacheFileName()
+{
+    if (!s_options.m_strDetailsCache.empty())
+        return s_options.m_strDetailsCache;
+    const char* appData = std::getenv("LOCALAPPDATA");
+    filesys::path dir = appData && *appData ? filesys::path(appData) : filesys::path(GetTwainSaveExecutionPath());
+    return (dir / TWAINSAVE_DETAILS_FILE).string();
+}
+
+std::string GetSourceListCacheFileName()
+{
+    if (!s_options.m_strSourceListCache.empty())
+        return s_options.m_strSourceListCache;
+    const char* appData = std::getenv("LOCALAPPDATA");
+    filesys::path dir = appData && *appData ? filesys::path(appData) : filesys::path(GetTwainSaveExecutionPath());
+    return (dir / TWAINSAVE_SOURCELIST_FILE).string();
+}
+
+// Returns the options that a device profile is recorded for.  Options that only name the output file or control
+// diagnostics do not change the device settings, so they are left out.
+std::string GetDeviceProfileOptionsKey(const po::variables_map& varmap)
+{
+    static const std::set<std::string> setIgnored = { "apiprofile", "capfailurefile", "createdir", "deviceprofile", "diagnose",
+                                                      "diagnosebinary", "diagnoselog", "filename", "incvalue", "metrics",
+                                                      "metricsinterval", "metricsport", "noconsole", "nopause", "optioncheck",
+                                                      "overwritemax", "overwritemode", "relearn", "sourcelistcache", "sourcelistrefresh",
+                                                      "stats", "trace", "useinc", "verbose", "watchdog", "watchdoglines" };
+    std::ostringstream strm;
+    strm << std::setprecision(10);
+    for (auto& pr : varmap)
+    {
+        if (pr.second.defaulted() || setIgnored.count(pr.first))
+            continue;
+        strm << pr.first << "=";
+        const auto& value = pr.second.value();
+        if (auto* pBool = boost::any_cast<bool>(&value))
+            strm << *pBool;
+        else
+        if (auto* pInt = boost::any_cast<int>(&value))
+            strm << *pInt;
+        else
+        if (auto* pDouble = boost::any_cast<double>(&value))
+            strm << *pDouble;
+        else
+        if (auto* pString = boost::any_cast<std::string>(&value))
+            strm << *pString;
+        strm << ";";
+    }
+    return strm.str();
+}
+
 std::string GetNewFileName(const std::string& fullpath, int inc, int maxWidth)
 {
     auto vString = SplitPath(filesys::path(fullpath));
@@ -491,6 +659,7 @@ parse_return_type parse_options(int argc, char *argv[])
     try
     {
         desc2->add_options()
+            ("apiprofile", po::bool_switch(&s_options.m_bAPIProfile)->default_value(false), "Print the number of calls and time spent in each DTWAIN function when finished")
             ("area", po::value< std::string >(&s_options.m_area)->default_value(""), "set acquisition area of image to acquire")
             ("autobright", po::bool_switch(&s_options.m_bAutobrightMode)->default_value(false), "turn on autobright feature")
             ("autofeed", po::bool_switch(&s_options.m_bUseADF)->default_value(false), "turn on automatic document feeder")
@@ -499,13 +668,21 @@ parse_return_type parse_options(int argc, char *argv[])
             ("bitsperpixel", po::value< int >(&s_options.m_bitsPerPixel)->default_value(0), "Image bits-per-pixel.  Default is current device setting")
             ("blankthreshold", po::value< double >(&s_options.m_dBlankThreshold)->default_value(98), "Percentage threshold to determine if page is blank")
             ("brightness", po::value< double >(&s_options.m_brightness)->default_value(0), "Brightness level (device must support brightness)")
+            ("capfailurefile", po::value< std::string >(&s_options.m_strCapFailureFile)->default_value(""), "File that remembers the capability settings each device has rejected, so they are not sent again.  Default is " TWAINSAVE_CAPFAILURES_FILE " in the LOCALAPPDATA directory")
             ("color", po::value< int >(&s_options.m_color)->default_value(0), "Color. 0=B/W, 1=Grayscale, 2=RGB, 3=Palette, 4=CMY, 5=CMYK. Default is 0")
             ("contrast", po::value< double >(&s_options.m_dContrast)->default_value(0), "Contrast level (device must support contrast)")
             ("createdir", po::bool_switch(&s_options.m_bCreateDir)->default_value(false), "Create the directory specified by --filename if directory does not exist")
             ("deskew", po::bool_switch(&s_options.m_bDeskew)->default_value(false), "Deskew image if skewed.  Device must support deskew")
+            ("deviceprofile", po::value< std::string >(&s_options.m_strDeviceProfile)->default_value(""), "File that holds the capability settings negotiated for the device.  If the device and options match the file, the settings are sent without being checked again.  Otherwise the settings are negotiated and saved to the file")
             ("details", po::bool_switch(&s_options.m_bShowDetails)->default_value(false), "Detail information on all available TWAIN devices.")
+            ("detailscache", po::value< std::string >(&s_options.m_strDetailsCache)->default_value(""), "File that keeps the --details of each device when --detailsjobs or --detailstimeout is used.  Default is " TWAINSAVE_DETAILS_FILE " in the LOCALAPPDATA directory")
+            ("detailsjobs", po::value< int >(&s_options.m_nDetailsJobs)->default_value(0), "Get the --details of each device in a separate process, running up to the specified number of processes at a time")
+            ("detailsrefresh", po::bool_switch(&s_options.m_bDetailsRefresh)->default_value(false), "Get the --details of each device again instead of using the --detailscache file")
+            ("detailssource", po::value< std::string >(&s_options.m_strDetailsSource)->default_value(""), "Detail information on the TWAIN device with the specified product name")
+            ("detailstimeout", po::value< int >(&s_options.m_nDetailsTimeout)->default_value(0), "Number of seconds to wait for the --details of each device.  Devices that take longer are listed with an error.  Default is 0 (no limit)")
 			("devicelist", po::bool_switch(&s_options.m_bShowProductNames)->default_value(false), "List names of TWAIN devices.")
             ("diagnose", po::value< int >(&s_options.m_nDiagnose)->default_value(0), "Create diagnostic log.  Level values 1, 2, 3 or 4.")
+            ("diagnosebinary", po::bool_switch(&s_options.m_bDiagnoseBinary)->default_value(false), "Write -diagnose messages to the -diagnoselog file in compact binary format.  Use twainlog-decode to view the log")
             ("diagnoselog", po::value< std::string >(&s_options.m_DiagnoseLog)->default_value("stddiag.log"), "file name to store -diagnose messages")
             ("dsmsearchorder", po::value< int >(&s_options.m_DSMSearchOrder)->default_value(0), "Directories TwainSave will search when locating TWAIN_32.DLL or TWAINDSM.DLL")
             ("duplex", po::bool_switch(&s_options.m_bUseDuplex)->default_value(false), "turn on duplex unit")
@@ -521,6 +698,9 @@ parse_return_type parse_options(int argc, char *argv[])
             ("jobcontrol", po::value< int >(&s_options.m_nJobControl)->default_value(0), "0=none, 1=include job page, 2=exclude job page")
             ("jquality", po::value< int >(&s_options.m_nJpegQuality)->default_value(75), "Quality Factor when acquiring JPEG images.  Default is 75")
             ("language", po::value< std::string >(&s_options.m_strLanguage)->default_value("english"), "Set language in Twain dialog")
+            ("metrics", po::value< std::string >(&s_options.m_strMetricsFile)->default_value(""), "Write operational metrics (pages scanned, pages/min, pages in flight, capability failures, feeder wait time, errors) to the specified file in Prometheus text format, every --metricsinterval seconds")
+            ("metricsinterval", po::value< int >(&s_options.m_nMetricsInterval)->default_value(15), "Number of seconds between writes of the --metrics file.  Default is 15")
+            ("metricsport", po::value< int >(&s_options.m_nMetricsPort)->default_value(0), "Serve the metrics in Prometheus text format over HTTP at http://127.0.0.1:<port>/metrics, so that Prometheus can scrape them while TwainSave runs")
             ("multipage", po::bool_switch(&s_options.m_bMultiPage)->default_value(false), "Save to multipage file")
             ("multipage2", po::bool_switch(&s_options.m_bMultiPage2)->default_value(false), "Save to multipage file only after closing UI")
             ("negate", po::bool_switch(&s_options.m_bNegateImage)->default_value(false), "Negates (reverses polarity) of acquired images")
@@ -558,6 +738,7 @@ parse_return_type parse_options(int argc, char *argv[])
             ("pdfquality", po::value< int >(&pdf_commands.m_quality)->default_value(60), "set the JPEG quality factor for PDF files")
             ("pdforient", po::value< std::string >(&pdf_commands.m_strOrient)->default_value("portrait"), "Sets orientation to portrait or landscape")
             ("pdfscale", po::value< std::string >(&pdf_commands.m_strScale)->default_value("noscale"), "PDF page scaling")
+            ("relearn", po::bool_switch(&s_options.m_bRelearn)->default_value(false), "Forget the capability settings that devices have rejected (see --capfailurefile)")
             ("resolution", po::value< double >(&s_options.m_dResolution)->default_value(0), "Image resolution in dots per unit (see --unit)")
             ("rotation", po::value< double >(&s_options.m_dRotation)->default_value(0.0), "Rotate page by the specified number of degrees (device must support rotation)")
             ("saveoncancel", po::bool_switch(&s_options.m_bSaveOnCancel)->default_value(false), "Save image file even if acquisition canceled by user")
@@ -567,8 +748,12 @@ parse_return_type parse_options(int argc, char *argv[])
             ("selectdefault", po::bool_switch(&s_options.m_bSelectDefault)->default_value(false), "Select the default TWAIN device automatically")
             ("shadow", po::value< double >(&s_options.m_dShadow)->default_value(0), "Shadow level (device must support shadow levels)")
             ("showindicator", po::bool_switch(&s_options.m_bShowIndicator)->default_value(false), "Show progress indicator when no user-interface is chosen (-noui)")
+            ("sourcelistcache", po::value< std::string >(&s_options.m_strSourceListCache)->default_value(""), "File that keeps the list of TWAIN devices for --devicelist and --selectbyname.  The list is used until a TWAIN driver is added, removed or updated.  Default is " TWAINSAVE_SOURCELIST_FILE " in the LOCALAPPDATA directory")
+            ("sourcelistrefresh", po::bool_switch(&s_options.m_bSourceListRefresh)->default_value(false), "List the TWAIN devices again instead of using the --sourcelistcache file")
+            ("stats", po::bool_switch(&s_options.m_bShowStats)->default_value(false), "Print timing statistics (pages/sec, per-page latency, time to first page, slowest capabilities, memory high-water marks) when finished")
             ("tempdir", po::value< std::string >(&s_options.m_strTempDirectory)->default_value(""), "Temporary file directory")
             ("threshold", po::value< double >(&s_options.m_dThreshold)->default_value(0), "Threshold level (device must support threshold)")
+            ("trace", po::value< std::string >(&s_options.m_strTraceFile)->default_value(""), "Write a timeline of TWAIN triplets, notifications, capability calls and page saves to the specified file (Chrome trace-event JSON, viewable in chrome://tracing or ui.perfetto.dev)")
             ("transfermode", po::value< int >(&s_options.m_nTransferMode)->default_value(0), "Transfer mode. 0=Native, 1=Buffered")
             ("transparency", po::bool_switch(&s_options.m_bUseTransparencyUnit)->default_value(false), "Use transparency unit")
             ("uionly", po::bool_switch(&s_options.m_bShowUIOnly)->default_value(false), "Allow user interface to be shown without acquiring images")
@@ -578,6 +763,8 @@ parse_return_type parse_options(int argc, char *argv[])
             ("useinc", po::bool_switch(&s_options.m_bUseFileInc)->default_value(false), "Use file name increment")
             ("verbose", po::bool_switch(&s_options.m_bUseVerbose)->default_value(false), "Turn on verbose mode")
             ("version", po::bool_switch(&s_options.m_bShowVersion)->default_value(false), "Display program version")
+            ("watchdog", po::value< std::string >(&s_options.m_strWatchdog)->default_value(""), "Exit with a diagnostic dump if a DTWAIN call does not return in time.  Comma separated list of seconds, as name=seconds for a single DTWAIN function, or seconds for all other functions (example: DTWAIN_AcquireFileEx=900,DTWAIN_OpenSource=60,120)")
+            ("watchdoglines", po::value< int >(&s_options.m_nWatchdogLines)->default_value(50), "Number of recent -diagnose log messages written when the -watchdog deadline is reached")
             ("@", po::value< std::string >(&s_options.m_strConfigFile)->default_value(""), "Configuration file");
         po::variables_map vm2;
         po::store(po::parse_command_line(argc, argv, *desc2, style), vm2);
@@ -635,6 +822,7 @@ static void options_writer(twain_source& theSource, std::string entry, const std
             std::cout << "Minimum Value: " << testRangeX.get_min() << "\n";
             std::cout << "Maximum Value: " << testRangeX.get_max() << "\n";
             std::cout << "Step Value: " << testRangeX.get_step() << "\n";
+            std::cout << "Nearest Allowable Value: " << testRangeX.nearest_valid(static_cast<double>(value)) << "\n";
         }
         else
         {
@@ -653,7 +841,7 @@ static void options_writer(twain_source& theSource, std::string entry, const std
 template <typename T>
 struct RangeCharacteristicTester
 {
-    static void test(twain_source& theSource, std::string entry, T value, int capvalue = 0)
+    static void test(twain_source& theSource, const capability_snapshot& snap, std::string entry, T value, int capvalue = 0)
     {
         // now test if the device can actually use the value set
         std::vector<T> testArray;
@@ -663,13 +851,13 @@ struct RangeCharacteristicTester
             std::cout << "Testing if " << value << " can be used...\n";
 
         // Get all the values supported
-        testArray = theSource.get_capability_interface().get_cap_values<decltype(testArray)>(capvalue, capability_interface::get());
+        testArray = snap.get_values<T>(capvalue);
 
         // Test if the returned array suggests that the values are in a range
         dynarithmic::twain::twain_range<T> testRangeX(testArray);
         if (testRangeX.is_valid())
             // Handle this as a range and test if value is in the range's domain
-            options_writer<T, true>(theSource, entry, testArray, value, testRangeX.value_exists(value));
+            options_writer<T, true>(theSource, entry, testArray, value, testRangeX.contains(value));
         else
             // Not a range, so the values in the array are discrete values that can be tested with value
             options_writer(theSource, entry, testArray, value, std::find(testArray.begin(), testArray.end(), value) != testArray.end());
@@ -679,18 +867,18 @@ struct RangeCharacteristicTester
 template <typename T>
 struct GenericCharacteristicTester
 {
-    static void test(twain_source& theSource, std::string entry, T value, int capvalue = 0)
+    static void test(twain_source& theSource, const capability_snapshot& snap, std::string entry, T value, int capvalue = 0)
     {
         // now test if the device can actually use the value set
         std::vector<T> testArray;
         std::cout << "Testing if " << value << " can be used...\n";
-        testArray = theSource.get_capability_interface().get_cap_values<decltype(testArray)>(capvalue, capability_interface::get());
+        testArray = snap.get_values<T>(capvalue);
         options_writer(theSource, entry, testArray, value, std::find(testArray.begin(), testArray.end(), value) != testArray.end());
     }
 };
 
 template <typename K, typename V, typename mapType = std::map<K,V>>
-bool MapCharacteristicTester(twain_source& theSource, std::string entry, mapType& testMap, const K& value, int capvalue)
+bool MapCharacteristicTester(twain_source& theSource, const capability_snapshot& snap, std::string entry, mapType& testMap, const K& value, int capvalue)
 {
     std::vector<V> testArray;
     if constexpr (is_stringtype<K>())
@@ -698,7 +886,7 @@ bool MapCharacteristicTester(twain_source& theSource, std::string entry, mapType
     else
         std::cout << "Testing if " << value << " can be used...\n";
     auto iterForMapKey = testMap.find(value);
-    testArray = theSource.get_capability_interface().get_cap_values<decltype(testArray)>(capvalue, capability_interface::get());
+    testArray = snap.get_values<V>(capvalue);
 
     // Test to make sure user entry is good
     if (iterForMapKey != testMap.end())
@@ -733,11 +921,11 @@ bool MapCharacteristicTester(twain_source& theSource, std::string entry, mapType
 
 struct BoolCharacteristicTester
 {
-    static bool test(twain_source& theSource, int capvalue)
+    static bool test(const capability_snapshot& snap, int capvalue)
     {
         // now test if the device can actually use the value set
         std::vector<TW_BOOL> testArray;
-        testArray = theSource.get_capability_interface().get_cap_values<decltype(testArray)>(capvalue, capability_interface::get());
+        testArray = snap.get_values<TW_BOOL>(capvalue);
         return find(testArray.begin(), testArray.end(), 1) != testArray.end();
     }
 };
@@ -745,7 +933,7 @@ struct BoolCharacteristicTester
 template <typename T>
 struct DummyCharacteristicTester
 {
-    static void test(twain_source&, std::string, T value, int) {}
+    static void test(twain_source&, const capability_snapshot&, std::string, T value, int) {}
 };
 
 
@@ -758,6 +946,7 @@ struct sAdditionalTest
 
 template <typename T, typename ValueTester = DummyCharacteristicTester<T>>
 std::pair<std::string, bool> test_twainsave_option(twain_source& theSource, // TWAIN source
+    const capability_snapshot& snap, // capability values read from the source
     const T& value, // value to test
     const po::variables_map& varmap,
     const std::string& entry,
@@ -775,14 +964,15 @@ std::pair<std::string, bool> test_twainsave_option(twain_source& theSource, // T
             {
                 if (!bSkipEntryCheck)
                     std::cout << "Checking if device supports --" << entry << " ...\n";
-                // test if the source supports what we're supposed to be setting later
+                // test if the source supports what we're supposed to be setting later.  The snapshot only holds the
+                // capabilities whose values are tested, so support is taken from the source's list of capabilities.
                 issupported = theSource.get_capability_interface().is_cap_supported(capvalue);
 
                 // do further testing 
                 if (additionalTest.testCapOnly || additionalTest.testOnlyTrueFalse)
                 {
                     if (!additionalTest.testCapOnly)
-                        issupported = BoolCharacteristicTester::test(theSource, capvalue);
+                        issupported = BoolCharacteristicTester::test(snap, capvalue);
                     if (!bSkipEntryCheck)
                         std::cout << (issupported ? "Success!  " : "Sorry: ") << "The TWAIN device \"" << theSource.get_source_info().get_product_name() << "\" does" << (issupported ? " " : " not ")
                         << "support the \"--" << entry << "\" option\n";
@@ -794,7 +984,7 @@ std::pair<std::string, bool> test_twainsave_option(twain_source& theSource, // T
                     std::cout << (issupported ? "Success!  " : "Sorry: ") << "The TWAIN device \"" << theSource.get_source_info().get_product_name() << "\" does" << (issupported ? " " : " not ")
                         << "support the \"--" << entry << "\" option\n";
                     if (issupported)
-                        ValueTester::test(theSource, entry, value, capvalue);
+                        ValueTester::test(theSource, snap, entry, value, capvalue);
                 }
             }
             if (!bSkipEntryCheck && !additionalTest.testMapValue)
@@ -992,7 +1182,7 @@ void set_pdf_options(twain_source& mysource, const po::variables_map& varmap)
 
 
 template <typename K, typename V, typename mapType = std::map<K,V>>
-void test_mapped_values(twain_source& mysource, const po::variables_map& varmap, bool doOptionCheck,
+void test_mapped_values(twain_source& mysource, const capability_snapshot& snap, const po::variables_map& varmap, bool doOptionCheck,
                         std::map<std::string, bool>& mapOptions, mapType& mapUserOptions,
                         std::string entry, const K& value, int cap)
 {
@@ -1000,12 +1190,12 @@ void test_mapped_values(twain_source& mysource, const po::variables_map& varmap,
     // a TWAIN value.
     if (varmap[entry].defaulted())
         return;
-    auto result = test_twainsave_option<TW_UINT16, GenericCharacteristicTester<TW_UINT16>>(mysource, {}, varmap, entry, doOptionCheck, cap, { true, true, true });
+    auto result = test_twainsave_option<TW_UINT16, GenericCharacteristicTester<TW_UINT16>>(mysource, snap, {}, varmap, entry, doOptionCheck, cap, { true, true, true });
     if (result.second)
     {
         if (!doOptionCheck)
         {
-            auto result2 = MapCharacteristicTester<K, V, mapType>(mysource, entry, mapUserOptions, value, cap);
+            auto result2 = MapCharacteristicTester<K, V, mapType>(mysource, snap, entry, mapUserOptions, value, cap);
             mapOptions.insert({ entry, result2 });
         }
         else
@@ -1025,44 +1215,66 @@ bool check_device_options(twain_source& mysource, const po::variables_map& varma
     {
         std::map<std::string, bool> mapOptions;
         doOptionCheck = doOptionCheck && !varmap["optioncheck"].defaulted();
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bUseADF, varmap, "autofeed", doOptionCheck, CAP_AUTOFEED));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bAutobrightMode, varmap, "autobright", doOptionCheck, ICAP_AUTOBRIGHT));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bDeskew, varmap, "deskew", doOptionCheck, ICAP_AUTOMATICDESKEW));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bAutoRotateMode, varmap, "autorotate", doOptionCheck, ICAP_AUTOMATICROTATE));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bUseTransparencyUnit ? 1 : 0, varmap, "transparency", doOptionCheck, ICAP_LIGHTPATH));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bOverscanMode, varmap, "overscan", doOptionCheck, ICAP_OVERSCAN));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bOverscanMode, varmap, "overscanmode", doOptionCheck, ICAP_OVERSCAN));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bShowIndicator, varmap, "showindicator", doOptionCheck, CAP_INDICATORS));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bUseDuplex, varmap, "duplex", doOptionCheck, CAP_DUPLEX));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bNoUI, varmap, "noui", doOptionCheck, CAP_UICONTROLLABLE, { true,false }));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bNoUIWait, varmap, "nouiwait", doOptionCheck, CAP_PAPERDETECTABLE, { true, false }));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_NoUIWaitTime, varmap, "nouiwaittime", doOptionCheck, CAP_PAPERDETECTABLE, { true, false }));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_bUseADF, varmap, "autofeedorflatbed", doOptionCheck, CAP_PAPERDETECTABLE, { true, false }));
-        mapOptions.insert(test_twainsave_option<std::string, GenericCharacteristicTester<std::string>>(mysource, s_options.m_strHalftone, varmap, "halftone", doOptionCheck, ICAP_HALFTONES));
-        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, s_options.m_dRotation, varmap, "rotation", doOptionCheck, ICAP_ROTATION));
-        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, s_options.m_dHighlight, varmap, "highlight", doOptionCheck, ICAP_HIGHLIGHT));
-        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, s_options.m_dThreshold, varmap, "threshold", doOptionCheck, ICAP_THRESHOLD));
-        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, s_options.m_dResolution, varmap, "resolution", doOptionCheck, ICAP_XRESOLUTION));
-        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, s_options.m_dGamma, varmap, "gamma", doOptionCheck, ICAP_GAMMA));
-        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, s_options.m_brightness, varmap, "brightness", doOptionCheck, ICAP_BRIGHTNESS));
-        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, s_options.m_dContrast, varmap, "contrast", doOptionCheck, ICAP_CONTRAST));
-        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, s_options.m_dShadow, varmap, "shadow", doOptionCheck, ICAP_SHADOW));
-        mapOptions.insert(test_twainsave_option(mysource, s_options.m_strImprinter.empty() ? false : true, varmap, "imprinterstring", doOptionCheck, CAP_PRINTER));
-        mapOptions.insert(test_twainsave_option<TW_UINT16, GenericCharacteristicTester<TW_UINT16>>(mysource, s_options.m_nPrinter, varmap, "imprinter", doOptionCheck, CAP_PRINTER));
-        mapOptions.insert(test_twainsave_option<TW_UINT16, GenericCharacteristicTester<TW_UINT16>>(mysource, s_options.m_color, varmap, "color", doOptionCheck, ICAP_PIXELTYPE));
+
+        // Read the capability values that are tested below from the device in one pass.  The values of
+        // CAP_UICONTROLLABLE and CAP_PAPERDETECTABLE are always tested, the others only when the option is given
+        // (and --optioncheck is not used).
+        std::vector<int> vSnapshotCaps = { CAP_UICONTROLLABLE, CAP_PAPERDETECTABLE };
+        if (!doOptionCheck)
+        {
+            const std::pair<const char*, int> valueTestedOptions[] = {
+                { "halftone", ICAP_HALFTONES }, { "rotation", ICAP_ROTATION }, { "highlight", ICAP_HIGHLIGHT },
+                { "threshold", ICAP_THRESHOLD }, { "resolution", ICAP_XRESOLUTION }, { "gamma", ICAP_GAMMA },
+                { "brightness", ICAP_BRIGHTNESS }, { "contrast", ICAP_CONTRAST }, { "shadow", ICAP_SHADOW },
+                { "imprinter", CAP_PRINTER }, { "color", ICAP_PIXELTYPE }, { "unitofmeasure", ICAP_UNITS },
+                { "papersize", ICAP_SUPPORTEDSIZES }, { "orientation", ICAP_ORIENTATION }, { "jobcontrol", CAP_JOBCONTROL } };
+            for (auto& pr : valueTestedOptions)
+            {
+                auto iter = varmap.find(pr.first);
+                if (iter != varmap.end() && !iter->second.defaulted())
+                    vSnapshotCaps.push_back(pr.second);
+            }
+        }
+        const capability_snapshot snap = mysource.get_capability_interface().snapshot(vSnapshotCaps, false);
+
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bUseADF, varmap, "autofeed", doOptionCheck, CAP_AUTOFEED));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bAutobrightMode, varmap, "autobright", doOptionCheck, ICAP_AUTOBRIGHT));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bDeskew, varmap, "deskew", doOptionCheck, ICAP_AUTOMATICDESKEW));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bAutoRotateMode, varmap, "autorotate", doOptionCheck, ICAP_AUTOMATICROTATE));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bUseTransparencyUnit ? 1 : 0, varmap, "transparency", doOptionCheck, ICAP_LIGHTPATH));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bOverscanMode, varmap, "overscan", doOptionCheck, ICAP_OVERSCAN));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bOverscanMode, varmap, "overscanmode", doOptionCheck, ICAP_OVERSCAN));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bShowIndicator, varmap, "showindicator", doOptionCheck, CAP_INDICATORS));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bUseDuplex, varmap, "duplex", doOptionCheck, CAP_DUPLEX));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bNoUI, varmap, "noui", doOptionCheck, CAP_UICONTROLLABLE, { true,false }));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bNoUIWait, varmap, "nouiwait", doOptionCheck, CAP_PAPERDETECTABLE, { true, false }));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_NoUIWaitTime, varmap, "nouiwaittime", doOptionCheck, CAP_PAPERDETECTABLE, { true, false }));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_bUseADF, varmap, "autofeedorflatbed", doOptionCheck, CAP_PAPERDETECTABLE, { true, false }));
+        mapOptions.insert(test_twainsave_option<std::string, GenericCharacteristicTester<std::string>>(mysource, snap, s_options.m_strHalftone, varmap, "halftone", doOptionCheck, ICAP_HALFTONES));
+        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, snap, s_options.m_dRotation, varmap, "rotation", doOptionCheck, ICAP_ROTATION));
+        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, snap, s_options.m_dHighlight, varmap, "highlight", doOptionCheck, ICAP_HIGHLIGHT));
+        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, snap, s_options.m_dThreshold, varmap, "threshold", doOptionCheck, ICAP_THRESHOLD));
+        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, snap, s_options.m_dResolution, varmap, "resolution", doOptionCheck, ICAP_XRESOLUTION));
+        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, snap, s_options.m_dGamma, varmap, "gamma", doOptionCheck, ICAP_GAMMA));
+        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, snap, s_options.m_brightness, varmap, "brightness", doOptionCheck, ICAP_BRIGHTNESS));
+        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, snap, s_options.m_dContrast, varmap, "contrast", doOptionCheck, ICAP_CONTRAST));
+        mapOptions.insert(test_twainsave_option<double, RangeCharacteristicTester<double>>(mysource, snap, s_options.m_dShadow, varmap, "shadow", doOptionCheck, ICAP_SHADOW));
+        mapOptions.insert(test_twainsave_option(mysource, snap, s_options.m_strImprinter.empty() ? false : true, varmap, "imprinterstring", doOptionCheck, CAP_PRINTER));
+        mapOptions.insert(test_twainsave_option<TW_UINT16, GenericCharacteristicTester<TW_UINT16>>(mysource, snap, s_options.m_nPrinter, varmap, "imprinter", doOptionCheck, CAP_PRINTER));
+        mapOptions.insert(test_twainsave_option<TW_UINT16, GenericCharacteristicTester<TW_UINT16>>(mysource, snap, s_options.m_color, varmap, "color", doOptionCheck, ICAP_PIXELTYPE));
 
         // These need to be tested using a map, since the values entered by the user will be strings that are associated with
         // a TWAIN value.
-        test_mapped_values<stringview, dynarithmic::twain::units_value::value_type, decltype(g_MeasureUnitMap)>(mysource, varmap, doOptionCheck, mapOptions,
+        test_mapped_values<stringview, dynarithmic::twain::units_value::value_type, decltype(g_MeasureUnitMap)>(mysource, snap, varmap, doOptionCheck, mapOptions,
                         g_MeasureUnitMap, "unitofmeasure", s_options.m_strUnitOfMeasure, ICAP_UNITS);
 
         test_mapped_values<stringview, dynarithmic::twain::papersize_value::value_type, decltype(g_PaperSizeMap)>
-            (mysource, varmap, doOptionCheck, mapOptions, g_PaperSizeMap, "papersize", s_options.m_strPaperSize, ICAP_SUPPORTEDSIZES);
+            (mysource, snap, varmap, doOptionCheck, mapOptions, g_PaperSizeMap, "papersize", s_options.m_strPaperSize, ICAP_SUPPORTEDSIZES);
 
-        test_mapped_values<int, dynarithmic::twain::orientation_value::value_type, decltype(g_OrientationTypeMap)>(mysource, varmap, doOptionCheck, mapOptions,
+        test_mapped_values<int, dynarithmic::twain::orientation_value::value_type, decltype(g_OrientationTypeMap)>(mysource, snap, varmap, doOptionCheck, mapOptions,
                         g_OrientationTypeMap, "orientation", s_options.m_Orientation, ICAP_ORIENTATION);
 
-        test_mapped_values<int, dynarithmic::twain::jobcontrol_value::value_type, decltype(g_JobControlMap)>(mysource, varmap, doOptionCheck, mapOptions,
+        test_mapped_values<int, dynarithmic::twain::jobcontrol_value::value_type, decltype(g_JobControlMap)>(mysource, snap, varmap, doOptionCheck, mapOptions,
                         g_JobControlMap, "jobcontrol", s_options.m_nJobControl, CAP_JOBCONTROL);
 
         if (doOptionCheck)
@@ -1103,7 +1315,8 @@ bool check_option_value(mapType& m, ValueType& v, int retValue)
 
 bool set_device_options(twain_source& mysource, const po::variables_map& varmap)
 {
-    // Give a rundown of what is supported if --verbose or --optioncheck is specified
+    // Give a rundown of what is supported if --verbose or --optioncheck is specified.  This is also done when a
+    // device profile is replayed, since the rundown only reads from the device and is only given when asked for.
     bool checkReturn = check_device_options(mysource, varmap, true);
     if (!checkReturn)
         return false; // get out if --optioncheck was done
@@ -1340,7 +1553,7 @@ public:
 
 using namespace dynarithmic::twain;
 
-struct twain_derived_logger : public twain_logger
+struct twain_derived_logger : public async_logger
 {
     public:
         enum logger_destination
@@ -1355,8 +1568,38 @@ struct twain_derived_logger : public twain_logger
         std::string m_filename;
         std::unique_ptr<std::ofstream> m_file;
 
+    protected:
+        // Called from the logger's writer thread, not the TWAIN thread
+        void write_batch(const std::string& batch) override
+        {
+            switch (m_destination)
+            {
+                case logger_destination::todebug:
+                    OutputDebugStringA(batch.c_str());
+                break;
+                case logger_destination::tofile:
+                    if (m_file)
+                        m_file->write(batch.data(), batch.size());
+                break;
+                case logger_destination::toconsole:
+                    std::cout.write(batch.data(), batch.size());
+                break;
+            }
+        }
+
+        void flush_sink() override
+        {
+            if (m_destination == logger_destination::tofile && m_file)
+                m_file->flush();
+            else
+            if (m_destination == logger_destination::toconsole)
+                std::cout.flush();
+        }
+
     public:
         twain_derived_logger() = default;
+        ~twain_derived_logger() override { stop(); }
+
         twain_derived_logger& set_destination(logger_destination destination)
         {
             m_destination = destination;
@@ -1374,32 +1617,92 @@ struct twain_derived_logger : public twain_logger
             if (m_destination == logger_destination::tofile)
                 m_file = std::make_unique<std::ofstream>(m_filename);
             twain_logger::enable();
+            start();
             return true;
         }
+};
+
 
-        virtual void log(const char* msg) override
+// Parses the --watchdog deadlines.  Example:  DTWAIN_AcquireFileEx=900,DTWAIN_OpenSource=60,120
+bool set_watchdog_deadlines(const std::string& spec)
+{
+    auto& watchdog = call_watchdog::instance();
+    std::vector<std::string> vEntries;
+    boost::split(vEntries, spec, boost::is_any_of(","));
+    for (auto& entry : vEntries)
+    {
+        boost::trim(entry);
+        if (entry.empty())
+            continue;
+        std::string name;
+        std::string seconds = entry;
+        auto pos = entry.find('=');
+        if (pos != std::string::npos)
         {
-            switch (m_destination)
-            {
-                case logger_destination::todebug:
-                {
-                    std::string msgTotal = msg;
-                    msgTotal.push_back('\n');
-                    OutputDebugStringA(msgTotal.c_str());
-                }
-                break;
-                case logger_destination::tofile:
-                    *m_file << msg << "\n";
-                break;
-                case logger_destination::toconsole:
-                    std::cout << msg << "\n";
-                break;
-            }
+            name = boost::trim_copy(entry.substr(0, pos));
+            seconds = boost::trim_copy(entry.substr(pos + 1));
         }
-};
+        double dSeconds = 0;
+        try
+        {
+            std::size_t numChars = 0;
+            dSeconds = std::stod(seconds, &numChars);
+            if (numChars != seconds.size() || dSeconds < 0)
+                return false;
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+        const auto deadline = std::chrono::milliseconds(static_cast<int64_t>(dSeconds * 1000.0));
+        if (name.empty())
+            watchdog.set_default_deadline(deadline);
+        else
+            watchdog.set_deadline(name, deadline);
+    }
+    return true;
+}
+
+// Called on the watchdog thread when a DTWAIN call has not returned within its deadline.  The TWAIN thread is stuck
+// in the driver, so write what we know and end the process without running any destructors.  **returnCodeText** is copied
+// before the watchdog is started, so that s_options is not read from this thread.
+void watchdog_expired(twain_session& ts, const call_watchdog::expired_call& expired, const std::string& returnCodeText)
+{
+    std::ostringstream strm;
+    strm << "\n*** TwainSave watchdog: " << expired.call.name << " has not returned after " << expired.call.elapsed.count()
+         << " ms (deadline " << expired.call.deadline.count() << " ms) ***\n";
+    strm << "\nDTWAIN calls in progress (outermost first):\n";
+    for (auto& call : expired.calls)
+        strm << "    " << call.name << "  " << call.elapsed.count() << " ms\n";
+    if (g_pLogger)
+    {
+        auto vMessages = g_pLogger->get_recent_messages();
+        strm << "\nLast " << vMessages.size() << " log message(s):\n";
+        for (auto& msg : vMessages)
+            strm << "    " << msg << "\n";
+    }
+    strm << "\nStage timings:\n" << ts.get_statistics().get_report();
+    strm << "\nTwainSave returned code: " << RETURN_WATCHDOG_TIMEOUT << " (" << returnCodeText << ")\n";
 
+    const std::string dump = strm.str();
+    std::cerr << dump;
+    std::cerr.flush();
+    if (g_pLogger)
+    {
+        // One message per line, so that each line is a separate entry in the diagnostic log
+        std::istringstream lines(dump);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            if (!line.empty())
+                g_pLogger->log(line.c_str());
+        }
+        g_pLogger->stop();
+    }
+    std::_Exit(RETURN_WATCHDOG_TIMEOUT);
+}
 
-int start_acquisitions(const po::variables_map& varmap) 
+int start_acquisitions(const po::variables_map& varmap, std::chrono::steady_clock::time_point startTime)
 {
     if (s_options.m_bNoConsole)
         ShowWindow(GetConsoleWindow(), SW_HIDE);
@@ -1419,17 +1722,38 @@ int start_acquisitions(const po::variables_map& varmap)
         return RETURN_OK;
     }
     
+    defaultIter = varmap.find("detailssource");
+    if (!defaultIter->second.defaulted())
+    {
+        // Run by --detailsjobs for one device.  The details are read from standard output.
+        auto s = generate_source_details(s_options.m_strDetailsSource);
+        std::cout << s << std::flush;
+        s_options.set_return_code(s.empty() ? RETURN_TWAIN_SOURCE_ERROR : RETURN_OK);
+        return s_options.get_return_code();
+    }
+
     defaultIter = varmap.find("details");
     if (!defaultIter->second.defaulted())
     {
-        auto s = generate_details();
-        if (s_options.m_bNoConsole)
+        const auto writeDetails = [](const std::string& s)
+        {
+            if (s_options.m_bNoConsole)
+            {
+                DWORD d;
+                WriteConsoleA(GetStdHandle(STD_OUTPUT_HANDLE), s.c_str(), static_cast<DWORD>(s.size()), &d, nullptr);
+            }
+            else
+                std::cout << s << std::flush;
+        };
+        if (s_options.m_nDetailsJobs > 0 || s_options.m_nDetailsTimeout > 0)
         {
-            DWORD d;
-            WriteConsoleA(GetStdHandle(STD_OUTPUT_HANDLE), s.c_str(), static_cast<DWORD>(s.size()), &d, nullptr);
+            const int nJobs = s_options.m_nDetailsJobs > 0 ? s_options.m_nDetailsJobs :
+                              static_cast<int>((std::max)(1U, (std::min)(4U, std::thread::hardware_concurrency())));
+            generate_details_per_source(nJobs, s_options.m_nDetailsTimeout, GetDetailsCacheFileName(),
+                                        s_options.m_bDetailsRefresh, writeDetails);
         }
         else
-            std::cout << generate_details();
+            writeDetails(generate_details());
         s_options.set_return_code(RETURN_OK);
         return RETURN_OK;
     }
@@ -1437,7 +1761,7 @@ int start_acquisitions(const po::variables_map& varmap)
 	defaultIter = varmap.find("devicelist");
 	if (!defaultIter->second.defaulted())
 	{
-		auto s = generate_productnames();
+		auto s = generate_productnames(GetSourceListCacheFileName(), s_options.m_bSourceListRefresh);
 		if (s_options.m_bNoConsole)
 		{
 			DWORD d;
@@ -1450,6 +1774,68 @@ int start_acquisitions(const po::variables_map& varmap)
 	}
     // first start the TWAIN session
     twain_session ts(startup_mode::none);
+    if (s_options.m_bShowStats || call_watchdog::instance().is_enabled())
+        ts.get_statistics().enable();
+    if (!s_options.m_strTraceFile.empty())
+        ts.enable_triplets_notification(true);
+
+    // Print the timing statistics when done
+    struct stats_reporter
+    {
+        twain_session& m_ts;
+        ~stats_reporter()
+        {
+            if (s_options.m_bShowStats)
+            {
+                std::string capReport;
+                std::string planReport;
+                if (g_source)
+                {
+                    if (auto* capStats = dynamic_cast<capability_statistics_listener*>(&g_source->get_cap_listener()))
+                        capReport = capStats->get_report(20);
+                    auto& setPlanReport = g_source->get_capability_interface().get_set_plan_report();
+                    if (!setPlanReport.empty())
+                        planReport = setPlanReport.to_string();
+                }
+                m_ts.stop();
+                const auto ms = [](std::chrono::steady_clock::duration d)
+                    { return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / 1000.0; };
+                std::cout << "\nTwainSave statistics:\n" << m_ts.get_statistics().get_report();
+                g_dtwainPreloader.wait();
+                std::cout << "\nStartup (ms): INI file " << ms(g_startupTimings.ini_load)
+                          << ", command line " << ms(g_startupTimings.option_parse)
+                          << ", DTWAIN library load " << ms(g_dtwainPreloader.get_load_time()) << " (in parallel)"
+                          << ", waiting for the library " << ms(g_dtwainPreloader.get_wait_time());
+                if (g_startupTimings.total.count() > 0)
+                    std::cout << ", ready to start TWAIN after " << ms(g_startupTimings.total);
+                std::cout << "\n";
+                if (!capReport.empty())
+                    std::cout << "\nCapability negotiation (slowest first):\n" << capReport;
+                if (!planReport.empty())
+                    std::cout << "\nCapability set plan:\n" << planReport;
+                if (const auto skipped = g_capFailureStore.get_skipped_count())
+                    std::cout << "\nCapability sets skipped (rejected by the device in an earlier run): " << skipped << "\n";
+                if (!s_options.m_strDeviceProfile.empty())
+                    std::cout << "\nDevice profile: " << g_deviceProfile.size() << " capability sets "
+                              << (g_bDeviceProfileReplay && !g_deviceProfile.is_modified() ? "replayed" : "recorded") << "\n";
+            }
+        }
+    } statsReporter{ ts };
+
+    // The watchdog must not outlive the session it reports on
+    struct watchdog_stopper
+    {
+        ~watchdog_stopper() { call_watchdog::instance().stop(); }
+    } watchdogStopper;
+    if (call_watchdog::instance().is_enabled())
+    {
+        const auto codeIter = s_options.m_ReturnCodesMap.find(RETURN_WATCHDOG_TIMEOUT);
+        const std::string returnCodeText = codeIter != s_options.m_ReturnCodesMap.end() ? codeIter->second : std::string();
+        call_watchdog::instance().set_handler([&ts, returnCodeText](const call_watchdog::expired_call& expired)
+            { watchdog_expired(ts, expired, returnCodeText); });
+        call_watchdog::instance().start();
+    }
+
     auto iter = varmap.find("tempdir");
     if (iter != varmap.end())
         ts.set_temporary_directory(boost::any_cast<std::string>(iter->second.value()));
@@ -1463,11 +1849,25 @@ int start_acquisitions(const po::variables_map& varmap)
     if (!iter->second.defaulted())
     {
         bool logging_enabled = (iter != varmap.end());
+        if (iter != varmap.end() && s_options.m_bDiagnoseBinary)
+        {
+            // binary logs always go to a file
+            auto& logdetails = ts.register_logger<binary_file_logger>();
+            logdetails.set_verbosity(static_cast<logger_verbosity>(s_options.m_nDiagnose));
+            g_pLogger = &logdetails;
+            if (s_options.m_DiagnoseLog == "*")
+                logdetails.set_filename("stddiag.log");
+            else
+                logdetails.set_filename(s_options.m_DiagnoseLog);
+            logdetails.enable();
+        }
+        else
         if (iter != varmap.end())
         {
             // create a logger and set the twain session to use the logger
             auto& logdetails = ts.register_logger<twain_derived_logger>();
             logdetails.set_verbosity(static_cast<logger_verbosity>(s_options.m_nDiagnose));
+            g_pLogger = &logdetails;
             logdetails.set_filename("stddiag.log");
             logdetails.set_destination(twain_derived_logger::logger_destination::tofile);
             if (varmap.find("diagnoselog") != varmap.end())
@@ -1485,6 +1885,8 @@ int start_acquisitions(const po::variables_map& varmap)
             logdetails.enable();
         }
     }
+    if (g_pLogger && call_watchdog::instance().is_enabled())
+        g_pLogger->set_history_size(static_cast<std::size_t>((std::max)(s_options.m_nWatchdogLines, 0)));
 
     // See if the user wants to use TWAIN DSM2 (32-bit version)
     if (s_options.m_bUseDSM2)
@@ -1496,15 +1898,30 @@ int start_acquisitions(const po::variables_map& varmap)
     ts.set_app_info(appInfo);
     ts.set_resource_directory(GetTwainSaveExecutionPath());
 
-    // Start the TWAIN session
+    // A device that is not in the saved device list cannot be selected by name, so there is no need to start TWAIN
+    // (see --devicelist).  The list is only trusted if no TWAIN driver changed since it was saved.
+    if (!s_options.m_strSelectName.empty() && !s_options.m_bSourceListRefresh)
+    {
+        source_list_cache sourceList;
+        sourceList.set_file(GetSourceListCacheFileName());
+        if (sourceList.load() && sourceList.is_current() && !sourceList.contains(s_options.m_strSelectName))
+        {
+            if (s_options.m_bUseVerbose)
+                std::cout << "The TWAIN device \"" << s_options.m_strSelectName << "\" is not installed\n";
+
+            // Same return code as when the device cannot be selected after starting TWAIN
+            s_options.set_return_code(RETURN_TWAIN_SOURCE_CANCEL);
+            return RETURN_TWAIN_SOURCE_CANCEL;
+        }
+    }
+
+    // Start the TWAIN session, once the library has been loaded by the preloader
+    g_dtwainPreloader.wait();
+    g_startupTimings.total = std::chrono::steady_clock::now() - startTime;
     ts.start();
 
     if (ts)
     {
-        // get the return code resources.
-        for (int i = RETURN_OK; i < RETURN_CODE_LAST; ++i)
-            vReturnStrings.push_back(ts.get_resource_string(DTWAIN_USERRES_START + i));
-
         // Load the language for the TWAIN dialog, diagnose logs, etc.
         if (!varmap["language"].defaulted())
         {
@@ -1564,6 +1981,28 @@ int start_acquisitions(const po::variables_map& varmap)
             ts.stop();
             return RETURN_TWAIN_SOURCE_ERROR;
         }
+        if (s_options.m_bShowStats)
+            g_source->set_cap_listener(std::make_unique<capability_statistics_listener>());
+
+        // Skip the capability settings this device rejected in earlier runs
+        g_capFailureStore.set_file(GetCapFailureFileName());
+        if (s_options.m_bRelearn)
+            g_capFailureStore.clear();
+        else
+            g_capFailureStore.load();
+        g_source->set_cap_failure_store(&g_capFailureStore);
+
+        // Send the settings saved for this device and these options, or record them if they do not match
+        if (!s_options.m_strDeviceProfile.empty())
+        {
+            const std::string optionsKey = GetDeviceProfileOptionsKey(varmap);
+            const std::string deviceKey = capability_failure_store::make_device_key(*g_source->get_twain_id(false));
+            g_deviceProfile.load(s_options.m_strDeviceProfile);
+            g_bDeviceProfileReplay = g_deviceProfile.matches(deviceKey, optionsKey);
+            if (!g_bDeviceProfileReplay)
+                g_deviceProfile.set_device(deviceKey).set_options(optionsKey).clear_sets();
+            g_source->set_device_profile(&g_deviceProfile);
+        }
     }
     else
     {
@@ -1605,7 +2044,14 @@ int start_acquisitions(const po::variables_map& varmap)
                 s_options.set_return_code(RETURN_TIMEOUT_REACHED);
             else
             if (acq_return.first == dynarithmic::twain::twain_source::acquire_canceled || acq_return.first == dynarithmic::twain::twain_source::acquire_ok)
+            {
                 s_options.set_return_code(RETURN_OK);
+
+                // Save the settings that were negotiated, so the next job with these options can send them directly
+                g_bDeviceProfileReplay = g_bDeviceProfileReplay && !g_deviceProfile.is_modified();
+                if (!s_options.m_strDeviceProfile.empty() && g_deviceProfile.is_modified() && !g_deviceProfile.empty())
+                    g_deviceProfile.save(s_options.m_strDeviceProfile);
+            }
             else
                 s_options.set_return_code(RETURN_FILESAVE_ERROR);
             g_source.reset();
@@ -1714,16 +2160,68 @@ parse_return_type parse_config_options(const std::string& filename)
 
 int main(int argc, char *argv[])
 {
-    LoadCustomResourcesFromIni();
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // Load the DTWAIN library and read the INI file while the command line is parsed.  The INI file and the command line
+    // set different members of s_options.
+    g_dtwainPreloader.start();
+    auto iniLoad = std::async(std::launch::async, []
+        {
+            const auto iniStart = std::chrono::steady_clock::now();
+            LoadCustomResourcesFromIni();
+            return std::chrono::steady_clock::now() - iniStart;
+        });
+    const auto parseStart = std::chrono::steady_clock::now();
     auto retval = parse_options(argc, argv);
+    g_startupTimings.option_parse = std::chrono::steady_clock::now() - parseStart;
+    g_startupTimings.ini_load = iniLoad.get();
 
     if (retval.first)
     {
         if (!s_options.m_strConfigFile.empty())
             retval = parse_config_options(s_options.m_strConfigFile);
         if ( retval.first )
-            start_acquisitions(retval.second);
+        {
+            // The profiler and watchdog must be turned on before the DTWAIN library is loaded
+            if (s_options.m_bAPIProfile)
+                api_profiler::instance().enable();
+            if (!s_options.m_strWatchdog.empty())
+            {
+                if (set_watchdog_deadlines(s_options.m_strWatchdog))
+                    call_watchdog::instance().enable();
+                else
+                {
+                    s_options.set_return_code(RETURN_BAD_COMMAND_LINE);
+                    retval.first = false;
+                }
+            }
+        }
+        if ( retval.first )
+        {
+            if (!s_options.m_strTraceFile.empty())
+                trace_recorder::instance().enable();
+            metrics_exporter metricsExporter;
+            metricsExporter.set_file(s_options.m_strMetricsFile).set_port(s_options.m_nMetricsPort).
+                            set_interval(std::chrono::seconds((std::max)(s_options.m_nMetricsInterval, 1)));
+            metricsExporter.start();
+            if (s_options.m_nMetricsPort > 0 && !metricsExporter.is_listening())
+                std::cout << "\nCould not listen for metrics requests on port " << s_options.m_nMetricsPort << "\n";
+            start_acquisitions(retval.second, startTime);
+            metricsExporter.stop();
+            if (s_options.m_bAPIProfile)
+                std::cout << "\nDTWAIN function profile:\n" << api_profiler::instance().get_report() << "\n";
+            if (!s_options.m_strTraceFile.empty())
+            {
+                trace_recorder::instance().disable();
+                std::ofstream traceFile(s_options.m_strTraceFile);
+                if (traceFile)
+                    trace_recorder::instance().write_json(traceFile);
+                else
+                    std::cout << "\nCould not create trace file " << s_options.m_strTraceFile << "\n";
+            }
+        }
     }
+    g_dtwainPreloader.release();
     auto retcode = s_options.get_return_code();
     if (s_options.m_bNoConsole && !s_options.m_bNoPause)
     {